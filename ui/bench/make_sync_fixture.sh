@@ -0,0 +1,97 @@
+#!/usr/bin/env bash
+# Records the chain segment for hds-sync-bench and writes the benchmark config.
+#
+# A wallet is restored from a fixed seed and a private node mines the given number
+# of blocks to its keys, so the wallet has outputs to rescan. The chain follows test
+# rules (FakePoW, 1 s blocks) and does not touch the network. The node DB of the
+# miner is the fixture, sync_peer.sh serves a copy of it as the peer stand-in.
+#
+# Usage: make_sync_fixture.sh <fixture dir> [blocks]
+#   HDS_NODE    path of hds-node, "hds-node" by default
+#   HDS_WALLET  path of the hds-wallet CLI, "hds-wallet" by default
+#   PEER_PORT   port of the stand-in, 10100 by default
+#
+# Then: hds-sync-bench <fixture dir>/config.json $(cat <fixture dir>/rules.txt)
+
+set -e
+
+SCRIPT_DIR=$(cd "$(dirname "$0")" && pwd)
+FIXTURE_DIR=$1
+BLOCKS=${2:-1000}
+HDS_NODE=${HDS_NODE:-hds-node}
+HDS_WALLET=${HDS_WALLET:-hds-wallet}
+PEER_PORT=${PEER_PORT:-10100}
+MINER_PORT=$((PEER_PORT + 1))
+PASS=sync-bench
+# BIP39 test vector, the benchmark restores the same wallet
+SEED="abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon about"
+RULES="--FakePoW=1 --DA.Target_s=1"
+
+if [ -z "$FIXTURE_DIR" ]; then
+  echo "usage: $0 <fixture dir> [blocks]"
+  exit 1
+fi
+for tool in "$HDS_NODE" "$HDS_WALLET"; do
+  if ! command -v "$tool" > /dev/null; then
+    echo "$tool is not found, set HDS_NODE and HDS_WALLET"
+    exit 1
+  fi
+done
+# the stand-in is started from the config in another folder
+HDS_NODE=$(command -v "$HDS_NODE")
+
+mkdir -p "$FIXTURE_DIR"
+FIXTURE_DIR=$(cd "$FIXTURE_DIR" && pwd)
+WORK_DIR="$FIXTURE_DIR/work"
+rm -rf "$WORK_DIR" "$FIXTURE_DIR/node.db"
+mkdir -p "$WORK_DIR"
+cd "$WORK_DIR"
+
+echo "Restoring the wallet"
+$HDS_WALLET restore --wallet_path wallet.db --pass "$PASS" --seed_phrase "${SEED// /;}" $RULES > wallet.log
+OWNER_KEY=$($HDS_WALLET export_owner_key --wallet_path wallet.db --pass "$PASS" $RULES | sed -n 's/^Owner Viewer key: *//p')
+MINER_KEY=$($HDS_WALLET export_miner_key --subkey=1 --wallet_path wallet.db --pass "$PASS" $RULES | sed -n 's/^Secret Subkey 1: *//p')
+if [ -z "$OWNER_KEY" ] || [ -z "$MINER_KEY" ]; then
+  echo "Failed to export the wallet keys, see $WORK_DIR"
+  exit 1
+fi
+
+echo "Mining $BLOCKS blocks"
+$HDS_NODE --storage node.db --port "$MINER_PORT" --mining_threads 1 \
+  --owner_key "$OWNER_KEY" --miner_key "$MINER_KEY" --pass "$PASS" $RULES > node.log 2>&1 &
+NODE_PID=$!
+trap 'kill $NODE_PID 2> /dev/null || true' EXIT
+
+height=0
+while [ "$height" -lt "$BLOCKS" ]; do
+  sleep 5
+  if ! kill -0 $NODE_PID 2> /dev/null; then
+    echo "The node exited, see $WORK_DIR/node.log"
+    exit 1
+  fi
+  height=$(grep -o 'My Tip: [0-9]*' node.log | tail -n 1 | grep -o '[0-9]*$' || echo 0)
+  echo "Height $height"
+done
+
+kill $NODE_PID
+wait $NODE_PID || true
+trap - EXIT
+
+mv node.db "$FIXTURE_DIR/node.db"
+echo "$RULES" > "$FIXTURE_DIR/rules.txt"
+cp "$SCRIPT_DIR/sync_peer.sh" "$FIXTURE_DIR/sync_peer.sh"
+
+cat > "$FIXTURE_DIR/config.json" << EOF
+{
+  "peer": {
+    "program": "$FIXTURE_DIR/sync_peer.sh",
+    "arguments": [ "$FIXTURE_DIR", "$PEER_PORT", "$HDS_NODE" ],
+    "port": $PEER_PORT
+  },
+  "seed": "$SEED",
+  "output": "$FIXTURE_DIR/result.json"
+}
+EOF
+
+rm -rf "$WORK_DIR"
+echo "The fixture of $height blocks is in $FIXTURE_DIR"
@@ -0,0 +1,527 @@
+// Copyright 2019 The Hds Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "mock_swap_node.h"
+
+#include <algorithm>
+#include <QCryptographicHash>
+#include <QJsonDocument>
+#include <QPointer>
+#include <QTcpSocket>
+
+namespace
+{
+    const int kErrorMethodNotFound = -32601;
+    const int kErrorInvalidParameter = -8;
+    const char* kHttpHeaderEnd = "\r\n\r\n";
+    // valid testnet address, the bridges only check the format
+    const char* kAddress = "mipcBbFg9gMiCh81Kj8tqqdgoZub1ZJRfn";
+    const char* kServerVersion = "MockSwapNode 1.0";
+    const double kFee = 0.0001;
+    const double kRelayFee = 0.00001;
+
+    qint64 toSatoshi(double value)
+    {
+        return qRound64(value * 100000000.);
+    }
+}
+
+MockSwapNode::MockSwapNode(const Config& config, QObject* parent)
+    : QObject(parent)
+    , m_config(config)
+    , m_height(config.startHeight)
+{
+    connect(&m_server, SIGNAL(newConnection()), this, SLOT(onNewConnection()));
+    connect(&m_blockTimer, SIGNAL(timeout()), this, SLOT(mineBlock()));
+}
+
+bool MockSwapNode::listen()
+{
+    if (!m_server.listen(QHostAddress::LocalHost, m_config.port))
+    {
+        return false;
+    }
+
+    if (m_config.blockInterval > 0)
+    {
+        m_blockTimer.start(m_config.blockInterval);
+    }
+    return true;
+}
+
+quint16 MockSwapNode::getPort() const
+{
+    return m_server.serverPort();
+}
+
+quint64 MockSwapNode::getHeight() const
+{
+    return m_height;
+}
+
+QMap<QString, int> MockSwapNode::getRequestCounts() const
+{
+    return m_requestCounts;
+}
+
+int MockSwapNode::getRequestCount() const
+{
+    return m_requestCount;
+}
+
+void MockSwapNode::onNewConnection()
+{
+    while (auto* socket = m_server.nextPendingConnection())
+    {
+        connect(socket, SIGNAL(readyRead()), this, SLOT(onReadyRead()));
+        connect(socket, SIGNAL(disconnected()), this, SLOT(onDisconnected()));
+    }
+}
+
+void MockSwapNode::onReadyRead()
+{
+    auto* socket = qobject_cast<QTcpSocket*>(sender());
+    if (!socket)
+    {
+        return;
+    }
+
+    m_buffers[socket].append(socket->readAll());
+    if (m_config.protocol == Protocol::JsonRpc)
+    {
+        readHttp(socket);
+    }
+    else
+    {
+        readElectrum(socket);
+    }
+}
+
+void MockSwapNode::onDisconnected()
+{
+    auto* socket = qobject_cast<QTcpSocket*>(sender());
+    m_buffers.remove(socket);
+    m_headerSubscribers.remove(socket);
+    if (socket)
+    {
+        socket->deleteLater();
+    }
+}
+
+void MockSwapNode::mineBlock()
+{
+    ++m_height;
+    for (auto it = m_txHeights.begin(); it != m_txHeights.end(); ++it)
+    {
+        if (it.value() == 0)
+        {
+            it.value() = m_height;
+        }
+    }
+
+    if (!m_headerSubscribers.isEmpty())
+    {
+        QJsonObject notification;
+        notification["jsonrpc"] = "2.0";
+        notification["method"] = "blockchain.headers.subscribe";
+        notification["params"] = QJsonArray{ getHeader(m_height) };
+        const auto data = QJsonDocument(notification).toJson(QJsonDocument::Compact) + '\n';
+        for (auto* socket : m_headerSubscribers)
+        {
+            respond(socket, data);
+        }
+    }
+    emit blockMined(m_height);
+}
+
+void MockSwapNode::readHttp(QTcpSocket* socket)
+{
+    auto& buffer = m_buffers[socket];
+    while (true)
+    {
+        const int headerEnd = buffer.indexOf(kHttpHeaderEnd);
+        if (headerEnd < 0)
+        {
+            return;
+        }
+
+        int contentLength = 0;
+        bool close = false;
+        const auto headers = buffer.left(headerEnd).split('\n');
+        for (const auto& header : headers)
+        {
+            const auto line = header.trimmed().toLower();
+            if (line.startsWith("content-length:"))
+            {
+                contentLength = line.mid(15).trimmed().toInt();
+            }
+            else if (line.startsWith("connection:"))
+            {
+                close = line.contains("close");
+            }
+        }
+
+        const int bodyStart = headerEnd + static_cast<int>(strlen(kHttpHeaderEnd));
+        if (buffer.size() < bodyStart + contentLength)
+        {
+            return;
+        }
+
+        const auto body = buffer.mid(bodyStart, contentLength);
+        buffer.remove(0, bodyStart + contentLength);
+
+        const auto request = QJsonDocument::fromJson(body).object();
+        Call call{ request["method"].toString(), request["params"].toArray(), request["id"] };
+        QJsonValue result;
+        QString error;
+        const bool isKnown = handleJsonRpc(call, result, error);
+        const auto response = makeResponse(call, isKnown, result, error);
+
+        // bitcoind answers the failed calls with 500 and the unknown methods with 404
+        const char* status = !isKnown ? "404 Not Found" : error.isEmpty() ? "200 OK" : "500 Internal Server Error";
+        QByteArray http = QByteArray("HTTP/1.1 ") + status + "\r\n"
+            + "Content-Type: application/json\r\n"
+            + "Content-Length: " + QByteArray::number(response.size()) + "\r\n"
+            + (close ? "Connection: close\r\n" : "")
+            + "\r\n" + response;
+        respond(socket, http, close);
+    }
+}
+
+void MockSwapNode::readElectrum(QTcpSocket* socket)
+{
+    auto& buffer = m_buffers[socket];
+    int lineEnd = -1;
+    while ((lineEnd = buffer.indexOf('\n')) >= 0)
+    {
+        const auto line = buffer.left(lineEnd);
+        buffer.remove(0, lineEnd + 1);
+        if (line.trimmed().isEmpty())
+        {
+            continue;
+        }
+
+        const auto request = QJsonDocument::fromJson(line).object();
+        Call call{ request["method"].toString(), request["params"].toArray(), request["id"] };
+        QJsonValue result;
+        QString error;
+        const bool isKnown = handleElectrum(call, socket, result, error);
+        respond(socket, makeResponse(call, isKnown, result, error) + '\n');
+    }
+}
+
+QByteArray MockSwapNode::makeResponse(const Call& call, bool isKnown, const QJsonValue& result, const QString& error) const
+{
+    QJsonObject response;
+    if (m_config.protocol == Protocol::Electrum)
+    {
+        response["jsonrpc"] = "2.0";
+    }
+    response["id"] = call.id;
+
+    if (!isKnown || !error.isEmpty())
+    {
+        QJsonObject errorObject;
+        errorObject["code"] = !isKnown ? kErrorMethodNotFound : m_config.protocol == Protocol::Electrum ? 2 : kErrorInvalidParameter;
+        errorObject["message"] = !isKnown ? "Method not found: " + call.method : error;
+        response["error"] = errorObject;
+        if (m_config.protocol == Protocol::JsonRpc)
+        {
+            response["result"] = QJsonValue::Null;
+        }
+    }
+    else
+    {
+        response["result"] = result;
+        if (m_config.protocol == Protocol::JsonRpc)
+        {
+            response["error"] = QJsonValue::Null;
+        }
+    }
+    return QJsonDocument(response).toJson(QJsonDocument::Compact);
+}
+
+bool MockSwapNode::handleJsonRpc(const Call& call, QJsonValue& result, QString& error)
+{
+    ++m_requestCount;
+    ++m_requestCounts[call.method];
+
+    const auto& method = call.method;
+    const auto& params = call.params;
+    if (method == "getblockcount")
+    {
+        result = static_cast<qint64>(m_height);
+    }
+    else if (method == "getblockhash")
+    {
+        const auto height = params.at(0).toVariant().toULongLong();
+        if (height > m_height)
+        {
+            error = "Block height out of range";
+        }
+        else
+        {
+            result = getHeader(height)["hash"];
+        }
+    }
+    else if (method == "getbalance")
+    {
+        result = m_config.balance;
+    }
+    else if (method == "getwalletinfo")
+    {
+        QJsonObject info;
+        info["balance"] = m_config.balance;
+        info["unconfirmed_balance"] = 0.;
+        info["immature_balance"] = 0.;
+        result = info;
+    }
+    else if (method == "getbalances")
+    {
+        QJsonObject mine;
+        mine["trusted"] = m_config.balance;
+        mine["untrusted_pending"] = 0.;
+        mine["immature"] = 0.;
+        result = QJsonObject{ { "mine", mine } };
+    }
+    else if (method == "estimatesmartfee")
+    {
+        QJsonObject estimate;
+        estimate["feerate"] = m_config.feeRate;
+        estimate["blocks"] = params.at(0).toInt(1);
+        result = estimate;
+    }
+    else if (method == "getrawchangeaddress" || method == "getnewaddress")
+    {
+        result = kAddress;
+    }
+    else if (method == "createrawtransaction")
+    {
+        // not a real transaction, but unique for the inputs and outputs
+        result = QString::fromLatin1(QCryptographicHash::hash(QJsonDocument(params).toJson(QJsonDocument::Compact), QCryptographicHash::Sha256).toHex());
+    }
+    else if (method == "fundrawtransaction")
+    {
+        QJsonObject funded;
+        funded["hex"] = params.at(0).toString();
+        funded["fee"] = kFee;
+        funded["changepos"] = -1;
+        result = funded;
+    }
+    else if (method == "signrawtransactionwithwallet" || method == "signrawtransaction")
+    {
+        QJsonObject signedTx;
+        signedTx["hex"] = params.at(0).toString();
+        signedTx["complete"] = true;
+        result = signedTx;
+    }
+    else if (method == "sendrawtransaction")
+    {
+        result = addTransaction(params.at(0).toString());
+    }
+    else if (method == "gettxout")
+    {
+        const auto txid = params.at(0).toString();
+        if (!m_txHeights.contains(txid))
+        {
+            result = QJsonValue::Null;
+        }
+        else
+        {
+            QJsonObject txOut;
+            txOut["bestblock"] = getHeader(m_height)["hash"];
+            txOut["confirmations"] = getConfirmations(txid);
+            txOut["value"] = 0.;
+            txOut["scriptPubKey"] = QJsonObject{ { "hex", "" } };
+            result = txOut;
+        }
+    }
+    else if (method == "getnetworkinfo")
+    {
+        result = QJsonObject{ { "version", 170000 }, { "subversion", kServerVersion } };
+    }
+    else if (method == "getblockchaininfo")
+    {
+        result = QJsonObject{ { "chain", "regtest" }, { "blocks", static_cast<qint64>(m_height) } };
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
+bool MockSwapNode::handleElectrum(const Call& call, QTcpSocket* socket, QJsonValue& result, QString& error)
+{
+    ++m_requestCount;
+    ++m_requestCounts[call.method];
+
+    const auto& method = call.method;
+    const auto& params = call.params;
+    if (method == "server.version")
+    {
+        result = QJsonArray{ kServerVersion, "1.4" };
+    }
+    else if (method == "server.ping" || method == "blockchain.scripthash.subscribe")
+    {
+        result = QJsonValue::Null;
+    }
+    else if (method == "blockchain.headers.subscribe")
+    {
+        m_headerSubscribers.insert(socket);
+        result = getHeader(m_height);
+    }
+    else if (method == "blockchain.block.header")
+    {
+        const auto height = params.at(0).toVariant().toULongLong();
+        if (height > m_height)
+        {
+            error = "Block height out of range";
+        }
+        else
+        {
+            result = getHeader(height)["hex"];
+        }
+    }
+    else if (method == "blockchain.estimatefee")
+    {
+        result = m_config.feeRate;
+    }
+    else if (method == "blockchain.relayfee")
+    {
+        result = kRelayFee;
+    }
+    else if (method == "blockchain.scripthash.get_balance")
+    {
+        // all the coins are on one deterministic script hash
+        const bool isFunded = params.at(0).toString() == makeHash(kAddress);
+        result = QJsonObject{ { "confirmed", isFunded ? toSatoshi(m_config.balance) : 0 }, { "unconfirmed", 0 } };
+    }
+    else if (method == "blockchain.scripthash.listunspent")
+    {
+        QJsonArray unspent;
+        if (params.at(0).toString() == makeHash(kAddress))
+        {
+            QJsonObject utxo;
+            utxo["tx_hash"] = makeHash(kServerVersion);
+            utxo["tx_pos"] = 0;
+            utxo["height"] = static_cast<qint64>(m_config.startHeight);
+            utxo["value"] = toSatoshi(m_config.balance);
+            unspent.append(utxo);
+        }
+        result = unspent;
+    }
+    else if (method == "blockchain.scripthash.get_history")
+    {
+        result = QJsonArray();
+    }
+    else if (method == "blockchain.transaction.broadcast")
+    {
+        result = addTransaction(params.at(0).toString());
+    }
+    else if (method == "blockchain.transaction.get")
+    {
+        const auto txid = params.at(0).toString();
+        if (!m_rawTxs.contains(txid))
+        {
+            error = "No such mempool or blockchain transaction";
+        }
+        else if (params.at(1).toBool())
+        {
+            QJsonObject tx;
+            tx["txid"] = txid;
+            tx["hex"] = m_rawTxs[txid];
+            tx["confirmations"] = getConfirmations(txid);
+            result = tx;
+        }
+        else
+        {
+            result = m_rawTxs[txid];
+        }
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
+void MockSwapNode::respond(QTcpSocket* socket, const QByteArray& data, bool close)
+{
+    auto write = [socket = QPointer<QTcpSocket>(socket), data, close]()
+    {
+        if (!socket || socket->state() != QAbstractSocket::ConnectedState)
+        {
+            return;
+        }
+        socket->write(data);
+        if (close)
+        {
+            socket->disconnectFromHost();
+        }
+    };
+
+    if (m_config.latency > 0)
+    {
+        QTimer::singleShot(m_config.latency, this, write);
+    }
+    else
+    {
+        write();
+    }
+}
+
+QString MockSwapNode::addTransaction(const QString& rawTx)
+{
+    const auto txid = makeHash(rawTx.toLatin1());
+    if (!m_txHeights.contains(txid))
+    {
+        m_txHeights[txid] = 0;
+        m_rawTxs[txid] = rawTx;
+    }
+
+    if (m_config.blockInterval == 0)
+    {
+        mineBlock();
+    }
+    return txid;
+}
+
+int MockSwapNode::getConfirmations(const QString& txid) const
+{
+    const auto height = m_txHeights.value(txid);
+    return height ? static_cast<int>(m_height - height + 1) : 0;
+}
+
+QJsonObject MockSwapNode::getHeader(quint64 height) const
+{
+    // deterministic for the height, 80 bytes like a real header
+    const auto seed = QByteArray::number(height);
+    const auto hex = QCryptographicHash::hash(seed, QCryptographicHash::Sha512).toHex()
+        + QCryptographicHash::hash(seed, QCryptographicHash::Sha1).toHex().left(32);
+    QJsonObject header;
+    header["height"] = static_cast<qint64>(height);
+    header["hex"] = QString::fromLatin1(hex);
+    header["hash"] = makeHash(QByteArray::fromHex(hex));
+    return header;
+}
+
+QString MockSwapNode::makeHash(const QByteArray& data)
+{
+    // double SHA-256 shown in the reversed byte order, as bitcoind does
+    auto hash = QCryptographicHash::hash(QCryptographicHash::hash(data, QCryptographicHash::Sha256), QCryptographicHash::Sha256);
+    std::reverse(hash.begin(), hash.end());
+    return QString::fromLatin1(hash.toHex());
+}
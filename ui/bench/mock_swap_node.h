@@ -0,0 +1,105 @@
+// Copyright 2019 The Hds Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include <QObject>
+#include <QTcpServer>
+#include <QTimer>
+#include <QJsonValue>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QMap>
+#include <QSet>
+
+class QTcpSocket;
+
+// Local stand-in for bitcoind/litecoind/qtumd and an Electrum server, enough for the
+// bridges of the swap coin clients: the JSON-RPC subset used by BitcoinCore017 and its
+// litecoin/qtum variants over HTTP, or the Electrum protocol as newline-delimited JSON-RPC
+// over plain TCP. Blocks are produced on a fixed interval, every response is delayed by
+// the configured latency. Sent transactions are mined into the next block.
+class MockSwapNode : public QObject
+{
+    Q_OBJECT
+public:
+    enum class Protocol
+    {
+        JsonRpc,
+        Electrum
+    };
+
+    struct Config
+    {
+        Protocol protocol = Protocol::JsonRpc;
+        quint16 port = 0;           // any free port
+        int latency = 0;            // ms
+        int blockInterval = 1000;   // ms, 0 mines a block for every sent transaction
+        quint64 startHeight = 100;
+        double balance = 10.;       // coins
+        double feeRate = 0.0002;    // coins per kB
+    };
+
+    explicit MockSwapNode(const Config& config, QObject* parent = nullptr);
+
+    bool listen();
+    quint16 getPort() const;
+    quint64 getHeight() const;
+
+    // served requests by method
+    QMap<QString, int> getRequestCounts() const;
+    int getRequestCount() const;
+
+signals:
+    void blockMined(quint64 height);
+
+private slots:
+    void onNewConnection();
+    void onReadyRead();
+    void onDisconnected();
+    void mineBlock();
+
+private:
+    struct Call
+    {
+        QString method;
+        QJsonArray params;
+        QJsonValue id;
+    };
+
+    void readHttp(QTcpSocket* socket);
+    void readElectrum(QTcpSocket* socket);
+    // false if the method is not known, error is set if the call failed
+    bool handleJsonRpc(const Call& call, QJsonValue& result, QString& error);
+    bool handleElectrum(const Call& call, QTcpSocket* socket, QJsonValue& result, QString& error);
+    QByteArray makeResponse(const Call& call, bool isKnown, const QJsonValue& result, const QString& error) const;
+    void respond(QTcpSocket* socket, const QByteArray& data, bool close = false);
+
+    QString addTransaction(const QString& rawTx);
+    int getConfirmations(const QString& txid) const;
+    QJsonObject getHeader(quint64 height) const;
+    static QString makeHash(const QByteArray& data);
+
+    Config m_config;
+    QTcpServer m_server;
+    QTimer m_blockTimer;
+    quint64 m_height;
+    QMap<QString, quint64> m_txHeights;    // 0 until mined
+    QMap<QString, QString> m_rawTxs;
+    QSet<QTcpSocket*> m_headerSubscribers;
+    QMap<QTcpSocket*, QByteArray> m_buffers;
+    QMap<QString, int> m_requestCounts;
+    int m_requestCount = 0;
+};
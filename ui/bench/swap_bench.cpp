@@ -0,0 +1,565 @@
+// Copyright 2019 The Hds Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// hds-swap-bench: drives a SwapCoinClientModel and swap-like bridge call sequences
+// through CachingBridge against MockSwapNode and writes the results as JSON.
+// A swap here is the bitcoin side of it as BitcoinSide runs it: the lock transaction is
+// created, funded, signed and sent, then polled with getTxOut until it is confirmed.
+// As in AppModel, the swaps run on a wallet reactor and reach the client bridge on the
+// coin reactor through ThreadBridge, or share one reactor with --shared_reactor.
+// AtomicSwapTransaction itself and SwapOffersViewModel are not driven: a real swap
+// needs a hds node and a peer wallet, and the mock does not check the contract scripts.
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+#include <QTextStream>
+#include <QTimer>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <boost/program_options.hpp>
+#include "mock_swap_node.h"
+#include "model/reactor_thread.h"
+#include "model/swap_bridge_cache.h"
+#include "model/swap_coin_client_model.h"
+#include "model/thread_bridge.h"
+#include "mnemonic/mnemonic.h"
+#include "utility/logger.h"
+#include "wallet/core/wallet_db.h"
+#include "wallet/transactions/swaps/bridges/bitcoin/bitcoin.h"
+
+namespace po = boost::program_options;
+using namespace hds;
+using namespace std::chrono;
+
+namespace
+{
+    const char* kProtocol = "protocol";
+    const char* kSwaps = "swaps";
+    const char* kLatency = "latency";
+    const char* kBlockInterval = "block_interval";
+    const char* kConfirmations = "confirmations";
+    const char* kPollInterval = "poll_interval";
+    const char* kTimeout = "timeout";
+    const char* kOutput = "output";
+    const char* kSharedReactor = "shared_reactor";
+    const char* kHelp = "help";
+
+    const int kFeeBlocks = 2;
+    const Amount kSwapAmount = 100000;     // satoshi
+    const unsigned kSwapStagger = 10;      // ms between the swap starts
+    const int kUiProbeInterval = 100;      // ms
+
+    struct Params
+    {
+        int swaps = 0;
+        int confirmations = 0;
+        unsigned pollInterval = 0;
+    };
+
+    // filled from the reactor thread, read by the main thread
+    struct Results
+    {
+        std::atomic<int> completed{ 0 };
+        std::atomic<int> failed{ 0 };
+        std::mutex mutex;
+        std::vector<double> latenciesMs;
+        std::vector<std::string> errors;
+    };
+
+    using BridgeCreator = std::function<bitcoin::IBridge::Ptr()>;
+
+    // runs on the wallet reactor as the swap transactions do
+    class SwapRun
+    {
+    public:
+        SwapRun(int index, io::Reactor& reactor, BridgeCreator bridgeCreator, const Params& params, Results& results)
+            : m_index(index)
+            , m_bridgeCreator(std::move(bridgeCreator))
+            , m_params(params)
+            , m_results(results)
+            , m_timer(io::Timer::create(reactor))
+        {
+        }
+
+        // before the reactor is started
+        void start(unsigned delay)
+        {
+            m_timer->start(delay, false, [this]() { onStart(); });
+        }
+
+    private:
+        void onStart()
+        {
+            m_startedAt = steady_clock::now();
+            m_bridge = m_bridgeCreator();
+            if (!m_bridge)
+            {
+                fail("no bridge");
+                return;
+            }
+
+            m_bridge->getBlockCount([this](const bitcoin::IBridge::Error& error, uint64_t)
+            {
+                if (check(error))
+                {
+                    estimateFee();
+                }
+            });
+        }
+
+        void estimateFee()
+        {
+            m_bridge->estimateFee(kFeeBlocks, [this](const bitcoin::IBridge::Error& error, Amount feeRate)
+            {
+                if (check(error))
+                {
+                    m_feeRate = feeRate;
+                    getChangeAddress();
+                }
+            });
+        }
+
+        void getChangeAddress()
+        {
+            m_bridge->getRawChangeAddress([this](const bitcoin::IBridge::Error& error, const std::string& address)
+            {
+                if (check(error))
+                {
+                    createTransaction(address);
+                }
+            });
+        }
+
+        void createTransaction(const std::string& address)
+        {
+            // unique per swap, the mock does not check it
+            std::string contractTxId(64, '0');
+            const auto index = std::to_string(m_index);
+            std::copy(index.begin(), index.end(), contractTxId.end() - index.size());
+
+            m_bridge->createRawTransaction(address, contractTxId, kSwapAmount, 0, 0,
+                [this](const bitcoin::IBridge::Error& error, const std::string& rawTx)
+            {
+                if (check(error))
+                {
+                    fundTransaction(rawTx);
+                }
+            });
+        }
+
+        void fundTransaction(const std::string& rawTx)
+        {
+            m_bridge->fundRawTransaction(rawTx, m_feeRate, [this](const bitcoin::IBridge::Error& error, const std::string& hexTx, int)
+            {
+                if (check(error))
+                {
+                    signTransaction(hexTx);
+                }
+            });
+        }
+
+        void signTransaction(const std::string& hexTx)
+        {
+            m_bridge->signRawTransaction(hexTx, [this](const bitcoin::IBridge::Error& error, const std::string& signedTx, bool complete)
+            {
+                if (check(error))
+                {
+                    if (!complete)
+                    {
+                        fail("the transaction is not signed");
+                        return;
+                    }
+                    sendTransaction(signedTx);
+                }
+            });
+        }
+
+        void sendTransaction(const std::string& signedTx)
+        {
+            m_bridge->sendRawTransaction(signedTx, [this](const bitcoin::IBridge::Error& error, const std::string& txid)
+            {
+                if (check(error))
+                {
+                    m_txid = txid;
+                    m_timer->start(m_params.pollInterval, true, [this]() { poll(); });
+                    poll();
+                }
+            });
+        }
+
+        void poll()
+        {
+            if (m_isPolling)
+            {
+                return;
+            }
+            m_isPolling = true;
+
+            // BitcoinSide asks for the height along with the confirmations
+            m_bridge->getBlockCount([this](const bitcoin::IBridge::Error& error, uint64_t)
+            {
+                if (!check(error))
+                {
+                    return;
+                }
+
+                m_bridge->getTxOut(m_txid, 0, [this](const bitcoin::IBridge::Error& error, const std::string&, double, uint32_t confirmations)
+                {
+                    m_isPolling = false;
+                    if (check(error) && static_cast<int>(confirmations) >= m_params.confirmations)
+                    {
+                        complete();
+                    }
+                });
+            });
+        }
+
+        bool check(const bitcoin::IBridge::Error& error)
+        {
+            if (m_isFinished)
+            {
+                return false;
+            }
+
+            if (error.m_type != bitcoin::IBridge::ErrorType::None)
+            {
+                fail(error.m_message);
+                return false;
+            }
+            return true;
+        }
+
+        void complete()
+        {
+            m_isFinished = true;
+            m_timer->cancel();
+            const auto latency = duration_cast<microseconds>(steady_clock::now() - m_startedAt).count() / 1000.;
+            {
+                std::unique_lock<std::mutex> lock(m_results.mutex);
+                m_results.latenciesMs.push_back(latency);
+            }
+            ++m_results.completed;
+        }
+
+        void fail(const std::string& message)
+        {
+            m_isFinished = true;
+            m_timer->cancel();
+            {
+                std::unique_lock<std::mutex> lock(m_results.mutex);
+                m_results.errors.push_back("swap " + std::to_string(m_index) + ": " + message);
+            }
+            ++m_results.failed;
+        }
+
+        int m_index;
+        BridgeCreator m_bridgeCreator;
+        const Params& m_params;
+        Results& m_results;
+        io::Timer::Ptr m_timer;
+        bitcoin::IBridge::Ptr m_bridge;
+        steady_clock::time_point m_startedAt;
+        Amount m_feeRate = 0;
+        std::string m_txid;
+        bool m_isPolling = false;
+        bool m_isFinished = false;
+    };
+
+    QJsonObject makeLatencyObject(std::vector<double> values)
+    {
+        QJsonObject object;
+        if (values.empty())
+        {
+            return object;
+        }
+
+        std::sort(values.begin(), values.end());
+        auto quantile = [&values](double q)
+        {
+            return values[static_cast<size_t>(q * (values.size() - 1) + 0.5)];
+        };
+        object["p50"] = quantile(0.5);
+        object["p95"] = quantile(0.95);
+        object["max"] = values.back();
+        return object;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    po::options_description options("hds-swap-bench options");
+    options.add_options()
+        (kHelp, "print this help")
+        (kProtocol, po::value<std::string>()->default_value("rpc"), "protocol of the mock node: rpc (bitcoind JSON-RPC) or electrum, "
+            "the Electrum bridge must be able to connect without TLS")
+        (kSwaps, po::value<int>()->default_value(20), "number of concurrent swaps")
+        (kLatency, po::value<int>()->default_value(0), "response latency of the mock node, ms")
+        (kBlockInterval, po::value<int>()->default_value(1000), "block interval of the mock node, ms")
+        (kConfirmations, po::value<int>()->default_value(2), "confirmations to complete a swap")
+        (kPollInterval, po::value<unsigned>()->default_value(500), "confirmations polling interval of a swap, ms")
+        (kTimeout, po::value<int>()->default_value(300), "seconds")
+        (kOutput, po::value<std::string>(), "result file, stdout if omitted")
+        (kSharedReactor, po::bool_switch(), "run the swaps on the client reactor as with swap/clients_own_threads off");
+
+    po::variables_map vm;
+    try
+    {
+        po::store(po::parse_command_line(argc, argv, options), vm);
+        po::notify(vm);
+    }
+    catch (const po::error& e)
+    {
+        std::cerr << e.what() << std::endl << options << std::endl;
+        return 1;
+    }
+
+    if (vm.count(kHelp))
+    {
+        std::cout << options << std::endl;
+        return 0;
+    }
+
+    const auto protocol = vm[kProtocol].as<std::string>();
+    if (protocol != "rpc" && protocol != "electrum")
+    {
+        std::cerr << "unknown protocol " << protocol << std::endl;
+        return 1;
+    }
+
+    Params params;
+    params.swaps = std::max(vm[kSwaps].as<int>(), 1);
+    params.confirmations = std::max(vm[kConfirmations].as<int>(), 1);
+    params.pollInterval = std::max(vm[kPollInterval].as<unsigned>(), 10u);
+
+    auto logger = Logger::create(LOG_LEVEL_WARNING, LOG_LEVEL_WARNING, LOG_LEVEL_WARNING);
+    Rules::get().UpdateChecksum();
+
+    MockSwapNode::Config nodeConfig;
+    nodeConfig.protocol = protocol == "rpc" ? MockSwapNode::Protocol::JsonRpc : MockSwapNode::Protocol::Electrum;
+    nodeConfig.latency = std::max(vm[kLatency].as<int>(), 0);
+    nodeConfig.blockInterval = std::max(vm[kBlockInterval].as<int>(), 0);
+    MockSwapNode node(nodeConfig);
+    if (!node.listen())
+    {
+        std::cerr << "mock node failed to listen" << std::endl;
+        return 1;
+    }
+
+    QTemporaryDir walletDir;
+    if (!walletDir.isValid())
+    {
+        std::cerr << "cannot create a temporary folder" << std::endl;
+        return 1;
+    }
+
+    wallet::IWalletDB::Ptr walletDB;
+    {
+        // WalletDB::init needs a reactor in scope
+        auto reactor = io::Reactor::create();
+        io::Reactor::Scope scope(*reactor);
+        ECC::NoLeak<ECC::uintBig> seed;
+        ECC::Hash::Processor() << "hds-swap-bench" >> seed.V;
+        SecString pass = std::string("hds-swap-bench");
+        walletDB = wallet::WalletDB::init(walletDir.filePath("wallet.db").toStdString(), pass, seed);
+    }
+    if (!walletDB)
+    {
+        std::cerr << "cannot create the wallet DB" << std::endl;
+        return 1;
+    }
+
+    // the swaps and the client read the settings written here
+    auto swapSettingsProvider = std::make_unique<bitcoin::SettingsProvider>(walletDB);
+    swapSettingsProvider->Initialize();
+    auto settings = swapSettingsProvider->GetSettings();
+    if (nodeConfig.protocol == MockSwapNode::Protocol::JsonRpc)
+    {
+        bitcoin::BitcoinCoreSettings connectionSettings;
+        connectionSettings.m_userName = "hds";
+        connectionSettings.m_pass = "hds";
+        connectionSettings.m_address = io::Address::LOCALHOST;
+        connectionSettings.m_address.port(node.getPort());
+        settings.SetConnectionOptions(connectionSettings);
+        settings.ChangeConnectionType(bitcoin::ISettings::ConnectionType::Core);
+    }
+    else
+    {
+        bitcoin::ElectrumSettings electrumSettings;
+        electrumSettings.m_address = "127.0.0.1:" + std::to_string(node.getPort());
+        electrumSettings.m_automaticChooseAddress = false;
+        electrumSettings.m_secretWords = bitcoin::createElectrumMnemonic(getEntropy());
+        settings.SetElectrumConnectionOptions(electrumSettings);
+        settings.ChangeConnectionType(bitcoin::ISettings::ConnectionType::Electrum);
+    }
+    swapSettingsProvider->SetSettings(settings);
+
+    auto clientSettingsProvider = std::make_unique<bitcoin::SettingsProvider>(walletDB);
+    clientSettingsProvider->Initialize();
+
+    // the client and the swaps share the bridge as in AppModel
+    const bool isSharedReactor = vm[kSharedReactor].as<bool>();
+    auto coinThread = std::make_shared<ReactorThread>("btc");
+    auto walletThread = isSharedReactor ? coinThread : std::make_shared<ReactorThread>("wallet");
+    auto& coinReactor = coinThread->getReactor();
+    auto bridgeHolder = std::make_shared<CachingBridgeHolder>("btc", std::make_shared<bitcoin::BridgeHolder<bitcoin::Electrum, bitcoin::BitcoinCore017>>());
+    auto client = std::make_shared<SwapCoinClientModel>(bridgeHolder, std::move(clientSettingsProvider), coinReactor, wallet::AtomicSwapCoin::Bitcoin);
+
+    BridgeCreator getBridge = [bridgeHolder, &coinReactor, client]()
+    {
+        return bridgeHolder->Get(coinReactor, *client);
+    };
+    BridgeCreator bridgeCreator = getBridge;
+    if (!isSharedReactor)
+    {
+        auto walletQueue = std::make_shared<ReactorQueue>(walletThread->getReactor());
+        bridgeCreator = [coinThread, walletQueue, getBridge]()
+        {
+            return std::make_shared<ThreadBridge>(coinThread, walletQueue, getBridge);
+        };
+    }
+
+    int clientUpdates = 0;
+    QObject::connect(client.get(), &SwapCoinClientModel::balanceChanged, [&clientUpdates]() { ++clientUpdates; });
+    QObject::connect(client.get(), &SwapCoinClientModel::statusChanged, [&clientUpdates]() { ++clientUpdates; });
+    client->addActiveView();
+
+    Results results;
+    std::vector<std::unique_ptr<SwapRun>> swaps;
+    for (int i = 0; i < params.swaps; ++i)
+    {
+        swaps.push_back(std::make_unique<SwapRun>(i, walletThread->getReactor(), bridgeCreator, params, results));
+        swaps.back()->start(i * kSwapStagger);
+    }
+
+    // the GUI thread handles the client updates, its loop latency is their cost
+    QElapsedTimer clock;
+    clock.start();
+    qint64 lastProbe = 0;
+    qint64 uiLatencyTotal = 0;
+    qint64 uiLatencyMax = 0;
+    int uiProbes = 0;
+    QTimer probeTimer;
+    QObject::connect(&probeTimer, &QTimer::timeout, [&]()
+    {
+        const auto now = clock.elapsed();
+        const auto latency = std::max<qint64>(now - lastProbe - kUiProbeInterval, 0);
+        lastProbe = now;
+        uiLatencyTotal += latency;
+        uiLatencyMax = std::max(uiLatencyMax, latency);
+        ++uiProbes;
+
+        if (results.completed + results.failed >= params.swaps)
+        {
+            app.exit(0);
+        }
+    });
+    probeTimer.start(kUiProbeInterval);
+
+    QTimer::singleShot(vm[kTimeout].as<int>() * 1000, &app, [&app]() { app.exit(2); });
+
+    coinThread->start();
+    walletThread->start();
+    const int exitCode = app.exec();
+    const auto duration = clock.elapsed();
+    probeTimer.stop();
+    walletThread->stop();
+    coinThread->stop();
+
+    QJsonObject result;
+    result["protocol"] = QString::fromStdString(protocol);
+    result["sharedReactor"] = isSharedReactor;
+    result["swaps"] = params.swaps;
+    result["completed"] = results.completed.load();
+    result["failed"] = results.failed.load();
+    result["timedOut"] = exitCode == 2;
+    result["durationMs"] = duration;
+    result["latencyMs"] = makeLatencyObject(results.latenciesMs);
+    if (!results.errors.empty())
+    {
+        QJsonArray errors;
+        for (const auto& error : results.errors)
+        {
+            errors.append(QString::fromStdString(error));
+        }
+        result["errors"] = errors;
+    }
+
+    QJsonObject requests;
+    const auto requestCounts = node.getRequestCounts();
+    for (auto it = requestCounts.begin(); it != requestCounts.end(); ++it)
+    {
+        requests[it.key()] = it.value();
+    }
+    result["nodeRequests"] = node.getRequestCount();
+    result["nodeRequestsByMethod"] = requests;
+
+    // the reactors are stopped, the holder returns the bridge the swaps used
+    if (auto cachingBridge = std::dynamic_pointer_cast<CachingBridge>(getBridge()))
+    {
+        QJsonArray cacheStats;
+        for (const auto& stats : cachingBridge->getStats())
+        {
+            QJsonObject methodStats;
+            methodStats["method"] = QString::fromStdString(stats.method);
+            methodStats["hits"] = static_cast<qint64>(stats.hits);
+            methodStats["joined"] = static_cast<qint64>(stats.joined);
+            methodStats["requests"] = static_cast<qint64>(stats.requests);
+            cacheStats.append(methodStats);
+        }
+        result["bridgeCache"] = cacheStats;
+    }
+
+    const auto reactorStats = coinThread->getLatencyStats();
+    result["reactorLatencyMs"] = QJsonObject{ { "avg", static_cast<qint64>(reactorStats.averageMs) }, { "max", static_cast<qint64>(reactorStats.maxMs) } };
+    const auto walletReactorStats = walletThread->getLatencyStats();
+    result["walletReactorLatencyMs"] = QJsonObject{ { "avg", static_cast<qint64>(walletReactorStats.averageMs) }, { "max", static_cast<qint64>(walletReactorStats.maxMs) } };
+    result["uiLatencyMs"] = QJsonObject{ { "avg", uiProbes ? static_cast<double>(uiLatencyTotal) / uiProbes : 0. }, { "max", uiLatencyMax } };
+    result["clientUpdates"] = clientUpdates;
+
+    // the bridges are bound to the stopped reactors
+    swaps.clear();
+    bridgeCreator = {};
+    getBridge = {};
+    client.reset();
+    bridgeHolder.reset();
+
+    const auto json = QJsonDocument(result).toJson();
+    if (vm.count(kOutput))
+    {
+        QFile file(QString::fromStdString(vm[kOutput].as<std::string>()));
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate) || file.write(json) != json.size())
+        {
+            std::cerr << "cannot write " << vm[kOutput].as<std::string>() << std::endl;
+            return 1;
+        }
+    }
+    else
+    {
+        QTextStream(stdout) << json;
+    }
+
+    return exitCode == 0 && results.failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,106 @@
+// Copyright 2019 The Hds Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// hds-sync-bench: runs SyncBenchmark without the UI binary. The node, the wallet and
+// the benchmark are the same objects the UI uses, see SyncBenchmark for the config.
+
+#include <QApplication>
+#include <QTemporaryDir>
+#include <iostream>
+#include <boost/program_options.hpp>
+#include "model/app_model.h"
+#include "model/sync_benchmark.h"
+#include "utility/cli/options.h"
+#include "utility/helpers.h"
+#include "utility/logger.h"
+
+namespace po = boost::program_options;
+using namespace hds;
+
+namespace
+{
+    const char* kConfig = "config";
+    const char* kAppData = "appdata";
+    const char* kVerbose = "verbose";
+    const char* kHelp = "help";
+}
+
+int main(int argc, char* argv[])
+{
+    block_sigpipe();
+
+    // the models do not need a display
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+    {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QApplication app(argc, argv);
+
+    po::options_description options("hds-sync-bench options");
+    options.add_options()
+        (kHelp, "print this help")
+        (kConfig, po::value<std::string>(), "JSON config of the benchmark, see SyncBenchmark")
+        (kAppData, po::value<std::string>(), "app data folder without a wallet, a temporary one if omitted")
+        (kVerbose, "log at the debug level");
+    // the recorded chain may follow test rules, e.g. FakePoW, see make_sync_fixture.sh
+    options.add(createRulesOptionsDescription());
+
+    po::positional_options_description positional;
+    positional.add(kConfig, 1);
+
+    po::variables_map vm;
+    try
+    {
+        po::store(po::command_line_parser(argc, argv).options(options).positional(positional).run(), vm);
+        po::notify(vm);
+    }
+    catch (const po::error& e)
+    {
+        std::cerr << e.what() << std::endl << options << std::endl;
+        return 1;
+    }
+
+    if (vm.count(kHelp) || !vm.count(kConfig))
+    {
+        std::cout << options << std::endl;
+        return vm.count(kHelp) ? 0 : 1;
+    }
+
+    QTemporaryDir tempDir;
+    QDir appDataDir(tempDir.path());
+    if (vm.count(kAppData))
+    {
+        appDataDir.setPath(QString::fromStdString(vm[kAppData].as<std::string>()));
+    }
+    else if (!tempDir.isValid())
+    {
+        std::cerr << "cannot create a temporary folder" << std::endl;
+        return 1;
+    }
+
+    const int logLevel = vm.count(kVerbose) ? LOG_LEVEL_DEBUG : LOG_LEVEL_INFO;
+    auto logger = Logger::create(logLevel, logLevel, logLevel);
+    getRulesOptions(vm);
+    Rules::get().UpdateChecksum();
+
+    WalletSettings settings(appDataDir);
+    AppModel appModel(settings);
+    SyncBenchmark benchmark(appModel, QString::fromStdString(vm[kConfig].as<std::string>()));
+    if (!benchmark.start())
+    {
+        return 1;
+    }
+    return app.exec();
+}
@@ -0,0 +1,26 @@
+#!/usr/bin/env bash
+# Peer stand-in of hds-sync-bench: serves the chain recorded by make_sync_fixture.sh.
+# The node works on a copy of the recorded DB, so every run starts from the same state,
+# and does not mine or connect to other peers.
+#
+# Usage: sync_peer.sh <fixture dir> <port> [hds-node]
+
+set -e
+
+FIXTURE_DIR=$1
+PORT=$2
+HDS_NODE=${3:-hds-node}
+
+if [ -z "$FIXTURE_DIR" ] || [ -z "$PORT" ]; then
+  echo "usage: $0 <fixture dir> <port> [hds-node]"
+  exit 1
+fi
+
+RUN_DIR="$FIXTURE_DIR/peer"
+rm -rf "$RUN_DIR"
+mkdir -p "$RUN_DIR"
+cp "$FIXTURE_DIR/node.db" "$RUN_DIR/node.db"
+cd "$RUN_DIR"
+
+# exec keeps the pid, so the benchmark stops the node itself
+exec "$HDS_NODE" --storage node.db --port "$PORT" --mining_threads 0 $(cat "$FIXTURE_DIR/rules.txt")
@@ -19,13 +19,20 @@
 #include "utility/fsutils.h"
 #include <boost/filesystem.hpp>
 #include <QApplication>
+#include <QElapsedTimer>
 #include <QTranslator>
+#include <set>
 
 #include "wallet/transactions/swaps/bridges/bitcoin/bitcoin.h"
 #include "wallet/transactions/swaps/bridges/litecoin/litecoin.h"
 #include "wallet/transactions/swaps/bridges/qtum/qtum.h"
 
 #include "keykeeper/local_private_key_keeper.h"
+#include "swap_bridge_cache.h"
+#include "thread_bridge.h"
+#include "startup_tracer.h"
+#include "wallet_db_loader.h"
+#include "node_failover.h"
 
 #if defined(HDS_HW_WALLET)
 #include "core/block_rw.h"
@@ -40,13 +47,77 @@ using namespace std;
 
 namespace
 {
-    void generateDefaultAddress(IWalletDB::Ptr db)
+    const qint64 kPeerReRankInterval = 5 * 60 * 1000;  // ms
+
+    // Swap transactions use the bridge on the wallet reactor. If the client runs
+    // on its own reactor with a separate bridge holder (Qtum), the transactions one
+    // is reset here when the client settings are changed
+    std::function<bitcoin::IBridge::Ptr()> makeBridgeCreator(bitcoin::IBridgeHolder::Ptr bridgeHolder,
+        io::Reactor::Ptr reactor, SwapCoinClientModel::Ptr client, bool isSharedWithClient)
+    {
+        auto settingsVersion = std::make_shared<uint32_t>(client->getSettingsVersion());
+        return [bridgeHolder, reactor, client, isSharedWithClient, settingsVersion]() -> bitcoin::IBridge::Ptr
+        {
+            auto currentVersion = client->getSettingsVersion();
+            if (!isSharedWithClient && *settingsVersion != currentVersion)
+            {
+                *settingsVersion = currentVersion;
+                bridgeHolder->Reset();
+            }
+            return bridgeHolder->Get(*reactor, *client);
+        };
+    }
+
+    // Swap transactions use the bridge of the client running on its own reactor,
+    // ThreadBridge hands the calls off to the client thread and the callbacks back to the wallet
+    std::function<bitcoin::IBridge::Ptr()> makeThreadBridgeCreator(bitcoin::IBridgeHolder::Ptr bridgeHolder,
+        ReactorThread::Ptr bridgeThread, ReactorQueue::Ptr walletQueue, SwapCoinClientModel::Ptr client)
     {
-        // generate default address
-        WalletAddress address;
-        db->createAddress(address);
-        address.m_label = "default";
-        db->saveAddress(address);
+        // called on the client thread only
+        auto getBridge = [bridgeHolder, reactor = &bridgeThread->getReactor(), client]()
+        {
+            return bridgeHolder->Get(*reactor, *client);
+        };
+
+        return [bridgeThread, walletQueue, client, getBridge]() -> bitcoin::IBridge::Ptr
+        {
+            if (!client->GetSettings().IsActivated())
+            {
+                // the holder has no bridge for the coin either
+                return nullptr;
+            }
+            return std::make_shared<ThreadBridge>(bridgeThread, walletQueue, getBridge);
+        };
+    }
+
+    // coins of the swaps the wallet resumes on start
+    std::set<AtomicSwapCoin> getUnfinishedSwapCoins(const IWalletDB& db)
+    {
+        std::set<AtomicSwapCoin> coins;
+        for (const auto& tx : db.getTxHistory(TxType::AtomicSwap))
+        {
+            auto coin = tx.GetParameter<AtomicSwapCoin>(TxParameterID::AtomicSwapCoin);
+            if (coin && !tx.canDelete())
+            {
+                coins.insert(*coin);
+            }
+        }
+        return coins;
+    }
+
+    // The client thread is started on the first request of the client
+    void startOnRequest(SwapCoinClientModel& client, ReactorThread::Ptr reactorThread)
+    {
+        QObject::connect(&client, &SwapCoinClientModel::reactorRequested, &client, [reactorThread]()
+        {
+            reactorThread->start();
+        });
+
+        if (client.GetSettings().IsActivated())
+        {
+            // the client is activated by its constructor
+            reactorThread->start();
+        }
     }
 }
 
@@ -65,16 +136,25 @@ std::string AppModel::getMyName()
 }
 
 AppModel::AppModel(WalletSettings& settings)
-    : m_settings{settings}
+    : m_walletReactorProbe("wallet")
+    , m_settings{settings}
+    , m_peerRanker{settings}
     , m_walletReactor(hds::io::Reactor::create())
 {
     assert(s_instance == nullptr);
     s_instance = this;
+    m_walletQueue = std::make_shared<ReactorQueue>(*m_walletReactor);
     m_nodeModel.start();
 }
 
 AppModel::~AppModel()
 {
+    if (m_walletDBLoader)
+    {
+        m_walletDBLoader->cancel();
+        m_walletDBLoader->wait();
+    }
+    stopSwapClientThreads();
     s_instance = nullptr;
 }
 
@@ -114,21 +194,11 @@ void AppModel::restoreDBFromBackup(const std::string& dbFilePath)
     }
 }
 
-bool AppModel::createWallet(const SecString& seed, const SecString& pass)
+void AppModel::createWallet(const SecString& seed, const SecString& pass, WalletDBCallback callback)
 {
     const auto dbFilePath = m_settings.getWalletStorage();
     backupDB(dbFilePath);
-    {
-        auto reactor = io::Reactor::create();
-        io::Reactor::Scope s(*reactor); // do it in main thread
-        auto db = WalletDB::init(dbFilePath, pass, seed.hash());
-        if (!db) 
-            return false;
-
-        generateDefaultAddress(db);
-    }
-
-    return openWallet(pass);
+    loadWalletDB(new WalletDBLoader(dbFilePath, seed, pass, this), pass, callback);
 }
 
 #if defined(HDS_HW_WALLET)
@@ -143,7 +213,7 @@ bool AppModel::createTrezorWallet(const hds::SecString& pass, hds::wallet::IPriv
         if (!db)
             return false;
 
-        generateDefaultAddress(db);
+        WalletDBLoader::generateDefaultAddress(db);
     }
 
     return openWallet(pass, keyKeeper);
@@ -163,6 +233,7 @@ std::shared_ptr<hds::wallet::HWWallet> AppModel::getHardwareWalletClient() const
 bool AppModel::openWallet(const hds::SecString& pass, hds::wallet::IPrivateKeyKeeper2::Ptr keyKeeper)
 {
     assert(m_db == nullptr);
+    STARTUP_TRACE_SPAN("AppModel::openWallet");
 
     try
     {
@@ -191,6 +262,80 @@ bool AppModel::openWallet(const hds::SecString& pass, hds::wallet::IPrivateKeyKe
     return false;
 }
 
+void AppModel::openWalletAsync(const SecString& pass, WalletDBCallback callback)
+{
+    const auto dbFilePath = m_settings.getWalletStorage();
+    if (!WalletDB::isInitialized(dbFilePath))
+    {
+        // hardware wallet DB
+        callback(openWallet(pass));
+        return;
+    }
+    loadWalletDB(new WalletDBLoader(dbFilePath, pass, this), pass, callback);
+}
+
+void AppModel::cancelWalletDBLoading()
+{
+    if (m_walletDBLoader)
+    {
+        m_walletDBLoader->cancel();
+    }
+}
+
+bool AppModel::isWalletDBLoading() const
+{
+    return m_walletDBLoader != nullptr;
+}
+
+void AppModel::loadWalletDB(WalletDBLoader* loader, const SecString& pass, WalletDBCallback callback)
+{
+    assert(m_db == nullptr);
+    assert(m_walletDBLoader == nullptr);
+    m_walletDBLoader = loader;
+
+    // both are emitted in the loader thread and delivered to the GUI thread
+    connect(loader, &WalletDBLoader::stageChanged, this, &AppModel::walletDBLoadingStageChanged);
+    const auto traceStart = StartupTracer::now();
+    connect(loader, &QThread::finished, this, [this, loader, pass, callback, traceStart]()
+    {
+        m_walletDBLoader = nullptr;
+        loader->deleteLater();
+
+        auto& tracer = StartupTracer::getInstance();
+        if (tracer.isEnabled())
+        {
+            tracer.addSpan("wallet DB loading", traceStart, StartupTracer::now() - traceStart);
+        }
+
+        auto db = loader->takeWalletDB();
+        if (loader->isCancelled())
+        {
+            // the DB has to be closed before its file is removed
+            db.reset();
+            if (loader->isCreating())
+            {
+                // remove the half-created wallet and put back the previous one
+                const auto dbFilePath = m_settings.getWalletStorage();
+                fsutils::remove(dbFilePath);
+                restoreDBFromBackup(dbFilePath);
+            }
+            emit walletDBLoadingFinished();
+            return;
+        }
+
+        if (db)
+        {
+            m_db = db;
+            onWalledOpened(pass);
+        }
+        emit walletDBLoadingFinished();
+        callback(m_db != nullptr);
+    });
+
+    emit walletDBLoadingStarted();
+    loader->start();
+}
+
 void AppModel::onWalledOpened(const hds::SecString& pass)
 {
     m_passwordHash = pass.hash();
@@ -216,6 +361,47 @@ void AppModel::resetWallet()
     onResetWallet();
 }
 
+void AppModel::importNodeSnapshot(const QString& snapshotPath, const QString& checkpointPath)
+{
+    if (m_nodeModel.isImportingSnapshot())
+    {
+        return;
+    }
+
+    auto dconn = MakeConnectionPtr();
+    *dconn = connect(&m_nodeModel, &NodeModel::snapshotImported, this, [this, dconn](bool isSucceeded, const QString& error)
+    {
+        QObject::disconnect(*dconn);
+        if (!isSucceeded)
+        {
+            //% "Failed to import the node snapshot: %1"
+            getMessages().addMessage(qtTrId("appmodel-failed-import-node-snapshot").arg(error));
+        }
+
+        if (m_settings.getRunLocalNode() && !m_nodeModel.isNodeRunning())
+        {
+            startNode();
+        }
+    });
+
+    if (m_nodeModel.isNodeRunning())
+    {
+        m_nsc.disconnect();
+
+        auto sconn = MakeConnectionPtr();
+        *sconn = connect(&m_nodeModel, &NodeModel::destroyedNode, this, [this, sconn, snapshotPath, checkpointPath]()
+        {
+            QObject::disconnect(*sconn);
+            m_nodeModel.importSnapshot(snapshotPath, checkpointPath);
+        });
+
+        m_nodeModel.stopNode();
+        return;
+    }
+
+    m_nodeModel.importSnapshot(snapshotPath, checkpointPath);
+}
+
 void AppModel::onResetWallet()
 {
     m_walletConnections.disconnect();
@@ -224,10 +410,20 @@ void AppModel::onResetWallet()
     assert(m_wallet.use_count() == 1);
     assert(m_db);
 
+    m_nodeFailover.reset();
     m_wallet.reset();
+    m_swapTransactionCreator.reset();
+    // the wallet reactor is stopped, the next wallet must not get the callbacks for this one
+    m_walletReactorProbe.stop();
+    m_walletQueue->close();
+    m_walletQueue = std::make_shared<ReactorQueue>(*m_walletReactor);
+    stopSwapClientThreads();
     m_bitcoinClient.reset();
     m_litecoinClient.reset();
     m_qtumClient.reset();
+    m_btcReactorThread.reset();
+    m_ltcReactorThread.reset();
+    m_qtumReactorThread.reset();
 
     m_db.reset();
 
@@ -246,45 +442,37 @@ void AppModel::onResetWallet()
 
 void AppModel::startWallet()
 {
+    STARTUP_TRACE_SPAN("AppModel::startWallet");
     assert(!m_wallet->isRunning());
 
     auto additionalTxCreators = std::make_shared<std::unordered_map<TxType, BaseTransaction::Creator::Ptr>>();
-    auto swapTransactionCreator = std::make_shared<hds::wallet::AtomicSwapTransaction::Creator>(m_db);
+    m_swapTransactionCreator = std::make_shared<hds::wallet::AtomicSwapTransaction::Creator>(m_db);
 
-    if (auto btcClient = getBitcoinClient(); btcClient)
+    // the clients used before the wallet start, the others register on creation
+    if (m_bitcoinClient)
     {
-        auto bitcoinBridgeCreator = [bridgeHolder = m_btcBridgeHolder, reactor = m_walletReactor, settingsProvider = btcClient]() -> bitcoin::IBridge::Ptr
-        {
-            return bridgeHolder->Get(*reactor, *settingsProvider);
-        };
-
-        auto btcSecondSideFactory = hds::wallet::MakeSecondSideFactory<BitcoinSide, bitcoin::IBridge, bitcoin::ISettingsProvider>(bitcoinBridgeCreator, *btcClient);
-        swapTransactionCreator->RegisterFactory(AtomicSwapCoin::Bitcoin, btcSecondSideFactory);
+        registerSecondSideFactory(AtomicSwapCoin::Bitcoin);
     }
-
-    if (auto ltcClient = getLitecoinClient(); ltcClient)
+    if (m_litecoinClient)
     {
-        auto litecoinBridgeCreator = [bridgeHolder = m_ltcBridgeHolder, reactor = m_walletReactor, settingsProvider = ltcClient]() -> bitcoin::IBridge::Ptr
-        {
-            return bridgeHolder->Get(*reactor, *settingsProvider);
-        };
-
-        auto ltcSecondSideFactory = hds::wallet::MakeSecondSideFactory<LitecoinSide, bitcoin::IBridge, litecoin::ISettingsProvider>(litecoinBridgeCreator, *ltcClient);
-        swapTransactionCreator->RegisterFactory(AtomicSwapCoin::Litecoin, ltcSecondSideFactory);
+        registerSecondSideFactory(AtomicSwapCoin::Litecoin);
+    }
+    if (m_qtumClient)
+    {
+        registerSecondSideFactory(AtomicSwapCoin::Qtum);
     }
 
-    if (auto qtumClient = getQtumClient(); qtumClient)
     {
-        auto qtumBridgeCreator = [bridgeHolder = m_qtumBridgeHolder, reactor = m_walletReactor, settingsProvider = qtumClient]() -> bitcoin::IBridge::Ptr
+        // the clients are created on first use, but the wallet resumes
+        // the unfinished swaps on start and they need the second side factory
+        STARTUP_TRACE_SPAN("init swap coin clients");
+        for (auto coin : getUnfinishedSwapCoins(*m_db))
         {
-            return bridgeHolder->Get(*reactor, *settingsProvider);
-        };
-
-        auto qtumSecondSideFactory = wallet::MakeSecondSideFactory<QtumSide, qtum::Electrum, qtum::ISettingsProvider>(qtumBridgeCreator, *qtumClient);
-        swapTransactionCreator->RegisterFactory(AtomicSwapCoin::Qtum, qtumSecondSideFactory);
+            getSwapClient(coin);
+        }
     }
 
-    additionalTxCreators->emplace(TxType::AtomicSwap, swapTransactionCreator);
+    additionalTxCreators->emplace(TxType::AtomicSwap, m_swapTransactionCreator);
 
     std::map<Notification::Type,bool> activeNotifications {
         { Notification::Type::SoftwareUpdateAvailable, false }, // TODO(sergey.zavarza): deprecated 
@@ -299,6 +487,11 @@ void AppModel::startWallet()
 
     bool isSecondCurrencyEnabled = m_settings.getSecondCurrency().toStdString() != noSecondCurrencyStr;
     m_wallet->start(activeNotifications, false, isSecondCurrencyEnabled, additionalTxCreators);
+
+    m_walletQueue->post([this]()
+    {
+        m_walletReactorProbe.start(*m_walletReactor);
+    });
 }
 
 void AppModel::applySettingsChanges()
@@ -322,6 +515,11 @@ void AppModel::applySettingsChanges()
         auto nodeAddr = m_settings.getNodeAddress().toStdString();
         m_wallet->getAsync()->setNodeAddress(nodeAddr);
     }
+
+    if (m_nodeFailover)
+    {
+        m_nodeFailover->reset();
+    }
 }
 
 void AppModel::nodeSettingsChanged()
@@ -336,6 +534,16 @@ void AppModel::nodeSettingsChanged()
     }
 }
 
+void AppModel::onNodeConnectionChanged(bool isNodeConnected)
+{
+    if (!isNodeConnected && !m_settings.getRunLocalNode())
+    {
+        // the peers could have changed since the ranking, so the next
+        // choice of the node is made with the fresh latencies
+        m_peerRanker.rankIfStale(PeerRanker::getDefaultPeers(), kPeerReRankInterval);
+    }
+}
+
 void AppModel::onStartedNode()
 {
     m_nsc.disconnect();
@@ -370,6 +578,7 @@ void AppModel::onFailedToStartNode(hds::wallet::ErrorType errorCode)
 
 void AppModel::start()
 {
+    STARTUP_TRACE_SPAN("AppModel::start");
     m_walletConnections << connect(this, &AppModel::walletReset, this, &AppModel::onResetWallet);
 
     m_nodeModel.setKdf(m_db->get_MasterKdf());
@@ -383,12 +592,20 @@ void AppModel::start()
         nodeAddrStr = nodeAddr.str();
     }
 
-    InitBtcClient();
-    InitLtcClient();
-    InitQtumClient();
-
     m_wallet = std::make_shared<WalletModel>(m_db, nodeAddrStr, m_walletReactor);
 
+    // the swap coin clients are created on first use, see getSwapClient
+    for (const auto& client : { m_bitcoinClient, m_litecoinClient, m_qtumClient })
+    {
+        if (client)
+        {
+            m_walletConnections << connect(m_wallet.get(), &WalletModel::transactionsChanged, client.get(), &SwapCoinClientModel::onTransactionsChanged);
+        }
+    }
+    m_walletConnections << connect(m_wallet.get(), &WalletModel::nodeConnectionChanged, this, &AppModel::onNodeConnectionChanged);
+    m_nodeFailover = std::make_unique<NodeFailover>(*m_wallet, m_settings, m_peerRanker);
+    connect(m_nodeFailover.get(), &NodeFailover::nodeSwitched, this, &AppModel::nodeSwitched);
+
     if (m_settings.getRunLocalNode())
     {
         startNode();
@@ -401,6 +618,7 @@ void AppModel::start()
 
 void AppModel::startNode()
 {
+    STARTUP_TRACE_SPAN("AppModel::startNode");
     m_nsc
         << connect(&m_nodeModel, &NodeModel::startedNode, this, &AppModel::onStartedNode)
         << connect(&m_nodeModel, &NodeModel::failedToStartNode, this, &AppModel::onFailedToStartNode)
@@ -442,41 +660,188 @@ NodeModel& AppModel::getNode()
     return m_nodeModel;
 }
 
-SwapCoinClientModel::Ptr AppModel::getBitcoinClient() const
+PeerRanker& AppModel::getPeerRanker()
+{
+    return m_peerRanker;
+}
+
+QString AppModel::getFallbackNode() const
+{
+    return m_nodeFailover && m_nodeFailover->isOnFallback() ? m_nodeFailover->getCurrentNode() : QString();
+}
+
+SwapCoinClientModel::Ptr AppModel::getBitcoinClient()
+{
+    return getSwapClient(AtomicSwapCoin::Bitcoin);
+}
+
+SwapCoinClientModel::Ptr AppModel::getLitecoinClient()
+{
+    return getSwapClient(AtomicSwapCoin::Litecoin);
+}
+
+SwapCoinClientModel::Ptr AppModel::getQtumClient()
 {
-    return m_bitcoinClient;
+    return getSwapClient(AtomicSwapCoin::Qtum);
 }
 
-SwapCoinClientModel::Ptr AppModel::getLitecoinClient() const
+SwapCoinClientModel::Ptr AppModel::getSwapClient(AtomicSwapCoin coin)
 {
-    return m_litecoinClient;
+    auto* client = &m_bitcoinClient;
+    const char* name = "Bitcoin";
+    void (AppModel::*init)() = &AppModel::InitBtcClient;
+    switch (coin)
+    {
+    case AtomicSwapCoin::Bitcoin:
+        break;
+    case AtomicSwapCoin::Litecoin:
+        client = &m_litecoinClient;
+        name = "Litecoin";
+        init = &AppModel::InitLtcClient;
+        break;
+    case AtomicSwapCoin::Qtum:
+        client = &m_qtumClient;
+        name = "Qtum";
+        init = &AppModel::InitQtumClient;
+        break;
+    default:
+        assert(false && "unknown swap coin");
+        return {};
+    }
+
+    if (*client || !m_db)
+    {
+        return *client;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    (this->*init)();
+    LOG_INFO() << name << " swap client created in " << timer.elapsed() << " ms";
+
+    if (m_wallet)
+    {
+        m_walletConnections << connect(m_wallet.get(), &WalletModel::transactionsChanged, client->get(), &SwapCoinClientModel::onTransactionsChanged);
+    }
+    if (m_swapTransactionCreator)
+    {
+        registerSecondSideFactory(coin);
+    }
+    return *client;
 }
 
-SwapCoinClientModel::Ptr AppModel::getQtumClient() const
+void AppModel::registerSecondSideFactory(AtomicSwapCoin coin)
 {
-    return m_qtumClient;
+    std::function<void()> registerFactory;
+    switch (coin)
+    {
+    case AtomicSwapCoin::Bitcoin:
+    {
+        auto bridgeCreator = m_btcReactorThread
+            ? makeThreadBridgeCreator(m_btcBridgeHolder, m_btcReactorThread, m_walletQueue, m_bitcoinClient)
+            : makeBridgeCreator(m_btcBridgeHolder, m_walletReactor, m_bitcoinClient, true);
+        auto factory = MakeSecondSideFactory<BitcoinSide, bitcoin::IBridge, bitcoin::ISettingsProvider>(bridgeCreator, *m_bitcoinClient);
+        registerFactory = [creator = m_swapTransactionCreator, factory]() { creator->RegisterFactory(AtomicSwapCoin::Bitcoin, factory); };
+        break;
+    }
+    case AtomicSwapCoin::Litecoin:
+    {
+        auto bridgeCreator = m_ltcReactorThread
+            ? makeThreadBridgeCreator(m_ltcBridgeHolder, m_ltcReactorThread, m_walletQueue, m_litecoinClient)
+            : makeBridgeCreator(m_ltcBridgeHolder, m_walletReactor, m_litecoinClient, true);
+        auto factory = MakeSecondSideFactory<LitecoinSide, bitcoin::IBridge, litecoin::ISettingsProvider>(bridgeCreator, *m_litecoinClient);
+        registerFactory = [creator = m_swapTransactionCreator, factory]() { creator->RegisterFactory(AtomicSwapCoin::Litecoin, factory); };
+        break;
+    }
+    case AtomicSwapCoin::Qtum:
+    {
+        auto bridgeCreator = makeBridgeCreator(m_qtumBridgeHolder, m_walletReactor, m_qtumClient, !m_qtumReactorThread);
+        auto factory = MakeSecondSideFactory<QtumSide, qtum::Electrum, qtum::ISettingsProvider>(bridgeCreator, *m_qtumClient);
+        registerFactory = [creator = m_swapTransactionCreator, factory]() { creator->RegisterFactory(AtomicSwapCoin::Qtum, factory); };
+        break;
+    }
+    default:
+        assert(false && "unknown swap coin");
+        return;
+    }
+
+    if (m_wallet && m_wallet->isRunning())
+    {
+        // the creator is used on the wallet reactor
+        m_walletQueue->post(std::move(registerFactory));
+    }
+    else
+    {
+        registerFactory();
+    }
 }
 
 void AppModel::InitBtcClient()
 {
-    m_btcBridgeHolder = std::make_shared<bitcoin::BridgeHolder<bitcoin::Electrum, bitcoin::BitcoinCore017>>();
+    m_btcBridgeHolder = std::make_shared<CachingBridgeHolder>("btc", std::make_shared<bitcoin::BridgeHolder<bitcoin::Electrum, bitcoin::BitcoinCore017>>());
     auto settingsProvider = std::make_unique<bitcoin::SettingsProvider>(m_db);
     settingsProvider->Initialize();
-    m_bitcoinClient = std::make_shared<SwapCoinClientModel>(m_btcBridgeHolder, std::move(settingsProvider), *m_walletReactor);
+
+    if (m_settings.isSwapClientsOwnThreads())
+    {
+        // the swap transactions share the client bridge on its thread
+        m_btcReactorThread = std::make_shared<ReactorThread>("btc");
+        m_bitcoinClient = std::make_shared<SwapCoinClientModel>(m_btcBridgeHolder, std::move(settingsProvider), m_btcReactorThread->getReactor(), AtomicSwapCoin::Bitcoin);
+        startOnRequest(*m_bitcoinClient, m_btcReactorThread);
+    }
+    else
+    {
+        m_bitcoinClient = std::make_shared<SwapCoinClientModel>(m_btcBridgeHolder, std::move(settingsProvider), *m_walletReactor, AtomicSwapCoin::Bitcoin);
+    }
 }
 
 void AppModel::InitLtcClient()
 {
-    m_ltcBridgeHolder = std::make_shared<bitcoin::BridgeHolder<litecoin::Electrum, litecoin::LitecoinCore017>>();
+    m_ltcBridgeHolder = std::make_shared<CachingBridgeHolder>("ltc", std::make_shared<bitcoin::BridgeHolder<litecoin::Electrum, litecoin::LitecoinCore017>>());
     auto settingsProvider = std::make_unique<litecoin::SettingsProvider>(m_db);
     settingsProvider->Initialize();
-    m_litecoinClient = std::make_shared<SwapCoinClientModel>(m_ltcBridgeHolder, std::move(settingsProvider), *m_walletReactor);
+
+    if (m_settings.isSwapClientsOwnThreads())
+    {
+        // the swap transactions share the client bridge on its thread
+        m_ltcReactorThread = std::make_shared<ReactorThread>("ltc");
+        m_litecoinClient = std::make_shared<SwapCoinClientModel>(m_ltcBridgeHolder, std::move(settingsProvider), m_ltcReactorThread->getReactor(), AtomicSwapCoin::Litecoin);
+        startOnRequest(*m_litecoinClient, m_ltcReactorThread);
+    }
+    else
+    {
+        m_litecoinClient = std::make_shared<SwapCoinClientModel>(m_ltcBridgeHolder, std::move(settingsProvider), *m_walletReactor, AtomicSwapCoin::Litecoin);
+    }
 }
 
 void AppModel::InitQtumClient()
 {
+    // not wrapped into CachingBridgeHolder, QtumSide works with qtum::Electrum itself
     m_qtumBridgeHolder = std::make_shared<bitcoin::BridgeHolder<qtum::Electrum, qtum::QtumCore017>>();
     auto settingsProvider = std::make_unique<qtum::SettingsProvider>(m_db);
     settingsProvider->Initialize();
-    m_qtumClient = std::make_shared<SwapCoinClientModel>(m_qtumBridgeHolder, std::move(settingsProvider), *m_walletReactor);
+
+    if (m_settings.isSwapClientsOwnThreads())
+    {
+        // QtumSide needs qtum::Electrum, so the swap transactions keep their own bridge on the wallet reactor
+        m_qtumReactorThread = std::make_shared<ReactorThread>("qtum");
+        auto clientBridgeHolder = std::make_shared<bitcoin::BridgeHolder<qtum::Electrum, qtum::QtumCore017>>();
+        m_qtumClient = std::make_shared<SwapCoinClientModel>(clientBridgeHolder, std::move(settingsProvider), m_qtumReactorThread->getReactor(), AtomicSwapCoin::Qtum);
+        startOnRequest(*m_qtumClient, m_qtumReactorThread);
+    }
+    else
+    {
+        m_qtumClient = std::make_shared<SwapCoinClientModel>(m_qtumBridgeHolder, std::move(settingsProvider), *m_walletReactor, AtomicSwapCoin::Qtum);
+    }
+}
+
+void AppModel::stopSwapClientThreads()
+{
+    for (auto* reactorThread : { m_btcReactorThread.get(), m_ltcReactorThread.get(), m_qtumReactorThread.get() })
+    {
+        if (reactorThread)
+        {
+            reactorThread->stop();
+        }
+    }
 }
@@ -18,12 +18,19 @@
 #include "settings.h"
 #include "messages.h"
 #include "node_model.h"
+#include "reactor_thread.h"
+#include "peer_ranker.h"
 #include "helpers.h"
 #include "wallet/core/secstring.h"
 #include "wallet/core/private_key_keeper.h"
 #include "wallet/transactions/swaps/bridges/bitcoin/bridge_holder.h"
+#include "wallet/transactions/swaps/swap_transaction.h"
+#include <functional>
 #include <memory>
 
+class WalletDBLoader;
+class NodeFailover;
+
 #if defined(HDS_HW_WALLET)
 namespace hds::wallet
 {
@@ -41,7 +48,14 @@ public:
     AppModel(WalletSettings& settings);
     ~AppModel() override;
 
-    bool createWallet(const hds::SecString& seed, const hds::SecString& pass);
+    using WalletDBCallback = std::function<void(bool)>;
+
+    // The wallet DB is created/opened in a worker thread, the callback is called
+    // in the GUI thread when the wallet is started or failed to, but not if cancelled
+    void createWallet(const hds::SecString& seed, const hds::SecString& pass, WalletDBCallback callback);
+    void openWalletAsync(const hds::SecString& pass, WalletDBCallback callback);
+    void cancelWalletDBLoading();
+    bool isWalletDBLoading() const;
 
 #if defined(HDS_HW_WALLET)
     bool createTrezorWallet(const hds::SecString& pass, hds::wallet::IPrivateKeyKeeper2::Ptr keyKeeper);
@@ -55,23 +69,35 @@ public:
     void applySettingsChanges();
     void nodeSettingsChanged();
     void resetWallet();
+    // the integrated node is stopped for the import and started again after
+    void importNodeSnapshot(const QString& snapshotPath, const QString& checkpointPath);
 
     WalletModel::Ptr getWallet() const;
     WalletSettings& getSettings() const;
     MessageManager& getMessages();
     NodeModel& getNode();
-    SwapCoinClientModel::Ptr getBitcoinClient() const;
-    SwapCoinClientModel::Ptr getLitecoinClient() const;
-    SwapCoinClientModel::Ptr getQtumClient() const;
+    PeerRanker& getPeerRanker();
+    // the default peer used instead of the node from the settings, empty if there is none
+    QString getFallbackNode() const;
+    // the swap coin clients are created on first use once the wallet DB is open
+    SwapCoinClientModel::Ptr getBitcoinClient();
+    SwapCoinClientModel::Ptr getLitecoinClient();
+    SwapCoinClientModel::Ptr getQtumClient();
 
 public slots:
     void onStartedNode();
     void onFailedToStartNode(hds::wallet::ErrorType errorCode);
     void onResetWallet();
+    void onNodeConnectionChanged(bool isNodeConnected);
 
 signals:
     void walletReset();
     void walletResetCompleted();
+    void walletDBLoadingStarted();
+    // stage is WalletDBLoader::Stage
+    void walletDBLoadingStageChanged(int stage);
+    void walletDBLoadingFinished();
+    void nodeSwitched(const QString& node);
 
 private:
     void start();
@@ -80,11 +106,26 @@ private:
     void InitBtcClient();
     void InitLtcClient();
     void InitQtumClient();
+    SwapCoinClientModel::Ptr getSwapClient(hds::wallet::AtomicSwapCoin coin);
+    void registerSecondSideFactory(hds::wallet::AtomicSwapCoin coin);
+    void stopSwapClientThreads();
     void onWalledOpened(const hds::SecString& pass);
+    void loadWalletDB(WalletDBLoader* loader, const hds::SecString& pass, WalletDBCallback callback);
     void backupDB(const std::string& dbFilePath);
     void restoreDBFromBackup(const std::string& dbFilePath);
 
 private:
+    // Own reactors of the swap coin clients, see WalletSettings::isSwapClientsOwnThreads.
+    // Must be stopped before and destroyed after SwapCoinClientModels
+    ReactorThread::Ptr m_btcReactorThread;
+    ReactorThread::Ptr m_ltcReactorThread;
+    ReactorThread::Ptr m_qtumReactorThread;
+
+    // Bound to m_walletReactor, must be destroyed after WalletModel.
+    // The queue receives the swap bridge callbacks from the coin threads
+    ReactorQueue::Ptr m_walletQueue;
+    ReactorProbe m_walletReactorProbe;
+
     // SwapCoinClientModels must be destroyed after WalletModel
     SwapCoinClientModel::Ptr m_bitcoinClient;
     SwapCoinClientModel::Ptr m_litecoinClient;
@@ -94,10 +135,14 @@ private:
     hds::bitcoin::IBridgeHolder::Ptr m_ltcBridgeHolder;
     hds::bitcoin::IBridgeHolder::Ptr m_qtumBridgeHolder;
 
+    // set while the wallet runs, the clients created then register their factories
+    std::shared_ptr<hds::wallet::AtomicSwapTransaction::Creator> m_swapTransactionCreator;
     WalletModel::Ptr m_wallet;
+    std::unique_ptr<NodeFailover> m_nodeFailover;
     NodeModel m_nodeModel;
     WalletSettings& m_settings;
     MessageManager m_messages;
+    PeerRanker m_peerRanker;
     ECC::NoLeak<ECC::uintBig> m_passwordHash;
     hds::io::Reactor::Ptr m_walletReactor;
     hds::wallet::IWalletDB::Ptr m_db;
@@ -105,6 +150,7 @@ private:
     Connections m_walletConnections;
     static AppModel* s_instance;
     std::string m_walletDBBackupPath;
+    WalletDBLoader* m_walletDBLoader = nullptr;
 
 #if defined(HDS_HW_WALLET)
     mutable std::shared_ptr<hds::wallet::HWWallet> m_hwWallet;
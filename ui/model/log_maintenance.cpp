@@ -0,0 +1,176 @@
+// Copyright 2019 The Hds Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "log_maintenance.h"
+
+#include <algorithm>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include "quazip/quagzipfile.h"
+#include "ui_log.h"
+
+namespace
+{
+    const char* kCompressedSuffix = ".gz";
+    const qint64 kChunkSize = 64 * 1024;
+}  // namespace
+
+LogMaintenance::LogMaintenance(const QString& logsFolder, const QStringList& prefixes, const Limits& limits)
+    : m_logsFolder(logsFolder)
+    , m_prefixes(prefixes)
+    , m_limits(limits)
+{
+}
+
+LogMaintenance::~LogMaintenance()
+{
+    requestInterruption();
+    wait();
+}
+
+void LogMaintenance::run()
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    QStringList filters;
+    for (const auto& prefix : m_prefixes)
+    {
+        filters << prefix + "*";
+    }
+
+    // the most recent first
+    auto files = m_logsFolder.entryInfoList(filters, QDir::Files, QDir::Time);
+
+    QList<QFileInfo> rotated;
+    QStringList activePrefixes;
+    for (const auto& file : files)
+    {
+        if (!file.fileName().endsWith(kCompressedSuffix))
+        {
+            auto prefix = std::find_if(m_prefixes.begin(), m_prefixes.end(), [&file](const QString& p)
+            {
+                return file.fileName().startsWith(p);
+            });
+            if (prefix != m_prefixes.end() && !activePrefixes.contains(*prefix))
+            {
+                activePrefixes << *prefix;
+                continue;
+            }
+        }
+        rotated.push_back(file);
+    }
+
+    const auto now = QDateTime::currentDateTime();
+    int compressedCount = 0;
+    int removedCount = 0;
+    qint64 totalSize = 0;
+    QList<QFileInfo> kept;
+
+    for (const auto& file : rotated)
+    {
+        if (isInterruptionRequested())
+        {
+            return;
+        }
+
+        if (m_limits.maxAgeSeconds > 0 && file.lastModified().secsTo(now) > m_limits.maxAgeSeconds)
+        {
+            remove(file);
+            ++removedCount;
+            continue;
+        }
+
+        if (!file.fileName().endsWith(kCompressedSuffix) && compress(file))
+        {
+            ++compressedCount;
+            kept.push_back(QFileInfo(file.absoluteFilePath() + kCompressedSuffix));
+        }
+        else
+        {
+            kept.push_back(file);
+        }
+        totalSize += kept.back().size();
+    }
+
+    // drop the oldest ones while over the budget
+    while (m_limits.maxTotalSize > 0 && totalSize > m_limits.maxTotalSize && !kept.isEmpty())
+    {
+        auto file = kept.takeLast();
+        totalSize -= file.size();
+        remove(file);
+        ++removedCount;
+    }
+
+    UI_LOG_INFO() << "Log maintenance: " << compressedCount << " compressed, " << removedCount << " removed, "
+                  << totalSize / 1024 << " KB kept in " << timer.elapsed() << " ms";
+}
+
+bool LogMaintenance::compress(const QFileInfo& file)
+{
+    const auto sourcePath = file.absoluteFilePath();
+    const auto targetPath = sourcePath + kCompressedSuffix;
+
+    QFile source(sourcePath);
+    QuaGzipFile target(targetPath);
+    if (!source.open(QIODevice::ReadOnly) || !target.open(QIODevice::WriteOnly))
+    {
+        return false;
+    }
+
+    bool isOk = true;
+    QByteArray chunk;
+    while (!source.atEnd())
+    {
+        if (isInterruptionRequested())
+        {
+            isOk = false;
+            break;
+        }
+
+        chunk = source.read(kChunkSize);
+        if (chunk.isEmpty() || target.write(chunk) != chunk.size())
+        {
+            isOk = source.atEnd() && chunk.isEmpty();
+            break;
+        }
+    }
+    target.close();
+    source.close();
+
+    if (!isOk)
+    {
+        QFile::remove(targetPath);
+        return false;
+    }
+
+    // keep the age of the log for the retention
+    QFile compressed(targetPath);
+    if (compressed.open(QIODevice::ReadWrite))
+    {
+        compressed.setFileTime(file.lastModified(), QFileDevice::FileModificationTime);
+    }
+
+    QFile::remove(sourcePath);
+    return true;
+}
+
+void LogMaintenance::remove(const QFileInfo& file)
+{
+    if (!QFile::remove(file.absoluteFilePath()))
+    {
+        UI_LOG_WARNING() << "Failed to remove log file " << file.fileName().toStdString();
+    }
+}
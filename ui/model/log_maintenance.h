@@ -0,0 +1,46 @@
+// Copyright 2019 The Hds Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <QDir>
+#include <QStringList>
+#include <QThread>
+
+// Compresses rotated log files and keeps the logs folder within the age and
+// size limits. Runs once at startup with the lowest priority, the active
+// (the most recent) log of every prefix is never touched
+class LogMaintenance : public QThread
+{
+    Q_OBJECT
+public:
+    struct Limits
+    {
+        qint64 maxAgeSeconds = 0;   // 0 - no age limit
+        qint64 maxTotalSize = 0;    // bytes, 0 - no size limit
+    };
+
+    LogMaintenance(const QString& logsFolder, const QStringList& prefixes, const Limits& limits);
+    ~LogMaintenance() override;
+
+    void run() override;
+
+private:
+    bool compress(const QFileInfo& file);
+    void remove(const QFileInfo& file);
+
+    QDir m_logsFolder;
+    QStringList m_prefixes;
+    Limits m_limits;
+};
@@ -0,0 +1,209 @@
+// Copyright 2019 The Hds Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "node_address_checker.h"
+
+#include <QDateTime>
+#include <QTcpSocket>
+#include "ui_log.h"
+
+NodeAddressChecker::NodeAddressChecker(QObject* parent)
+    : QObject(parent)
+{
+    m_debounce.setSingleShot(true);
+    m_debounce.setInterval(kDebounceInterval);
+    connect(&m_debounce, SIGNAL(timeout()), SLOT(onDebounce()));
+
+    m_probeTimeout.setSingleShot(true);
+    m_probeTimeout.setInterval(kProbeTimeout);
+    connect(&m_probeTimeout, &QTimer::timeout, this, [this]() { finishProbes(); });
+}
+
+NodeAddressChecker::~NodeAddressChecker()
+{
+    cancel();
+}
+
+void NodeAddressChecker::check(const QString& host, quint16 port)
+{
+    cancel();
+    m_host = host;
+    m_port = port;
+    m_debounce.start();
+}
+
+void NodeAddressChecker::cancel()
+{
+    m_debounce.stop();
+    if (m_lookupId != -1)
+    {
+        QHostInfo::abortHostLookup(m_lookupId);
+        m_lookupId = -1;
+    }
+    abortProbes();
+}
+
+bool NodeAddressChecker::isChecking() const
+{
+    return m_debounce.isActive() || m_lookupId != -1 || !m_probes.isEmpty();
+}
+
+void NodeAddressChecker::onDebounce()
+{
+    if (m_host.isEmpty())
+    {
+        emit addressChecked(m_host, false);
+        return;
+    }
+
+    QList<QHostAddress> addresses;
+    if (findInCache(m_host, addresses))
+    {
+        onResolved(addresses);
+        return;
+    }
+
+    QHostAddress literal;
+    if (literal.setAddress(m_host))
+    {
+        onResolved({ literal });
+        return;
+    }
+
+    m_lookupId = QHostInfo::lookupHost(m_host, this, SLOT(onLookedUp(const QHostInfo&)));
+}
+
+void NodeAddressChecker::onLookedUp(const QHostInfo& info)
+{
+    if (info.lookupId() != m_lookupId)
+    {
+        // superseded by a newer check
+        return;
+    }
+    m_lookupId = -1;
+
+    if (info.error() != QHostInfo::NoError)
+    {
+        UI_LOG_DEBUG() << "Node address " << m_host.toStdString() << " is not resolved: " << info.errorString().toStdString();
+    }
+    else
+    {
+        putToCache(m_host, info.addresses());
+    }
+    onResolved(info.addresses());
+}
+
+void NodeAddressChecker::onResolved(const QList<QHostAddress>& addresses)
+{
+    emit addressChecked(m_host, !addresses.isEmpty());
+
+    if (!addresses.isEmpty() && m_port != 0)
+    {
+        startProbes(addresses);
+    }
+}
+
+void NodeAddressChecker::startProbes(const QList<QHostAddress>& addresses)
+{
+    m_bestLatency = -1;
+    m_clock.start();
+    m_probeTimeout.start();
+
+    for (const auto& address : addresses.mid(0, kMaxProbes))
+    {
+        auto socket = new QTcpSocket(this);
+        m_probes.push_back(socket);
+        connect(socket, &QTcpSocket::connected, this, [this, socket]() { onProbeDone(socket, true); });
+        connect(socket, QOverload<QAbstractSocket::SocketError>::of(&QAbstractSocket::error),
+                this, [this, socket]() { onProbeDone(socket, false); });
+        socket->connectToHost(address, m_port);
+    }
+}
+
+void NodeAddressChecker::onProbeDone(QTcpSocket* socket, bool connected)
+{
+    if (!m_probes.contains(socket))
+    {
+        return;
+    }
+
+    if (connected)
+    {
+        // probes run in parallel, so the first connection is the fastest one
+        m_bestLatency = static_cast<int>(m_clock.elapsed());
+        finishProbes();
+        return;
+    }
+
+    m_probes.removeOne(socket);
+    socket->deleteLater();
+    if (m_probes.isEmpty())
+    {
+        finishProbes();
+    }
+}
+
+void NodeAddressChecker::abortProbes()
+{
+    m_probeTimeout.stop();
+    for (auto socket : m_probes)
+    {
+        socket->disconnect(this);
+        socket->abort();
+        socket->deleteLater();
+    }
+    m_probes.clear();
+}
+
+void NodeAddressChecker::finishProbes()
+{
+    abortProbes();
+    UI_LOG_DEBUG() << "Node " << m_host.toStdString() << ":" << m_port << " latency: " << m_bestLatency << " ms";
+    emit probeFinished(m_host, m_port, m_bestLatency);
+}
+
+bool NodeAddressChecker::findInCache(const QString& host, QList<QHostAddress>& addresses)
+{
+    auto it = m_cache.find(host);
+    if (it == m_cache.end())
+    {
+        return false;
+    }
+
+    if (it->expiresAt < QDateTime::currentMSecsSinceEpoch())
+    {
+        m_cache.erase(it);
+        return false;
+    }
+
+    addresses = it->addresses;
+    return true;
+}
+
+void NodeAddressChecker::putToCache(const QString& host, const QList<QHostAddress>& addresses)
+{
+    auto now = QDateTime::currentMSecsSinceEpoch();
+    if (m_cache.size() >= kMaxCacheSize)
+    {
+        for (auto it = m_cache.begin(); it != m_cache.end();)
+        {
+            it = it->expiresAt < now ? m_cache.erase(it) : std::next(it);
+        }
+        if (m_cache.size() >= kMaxCacheSize)
+        {
+            m_cache.clear();
+        }
+    }
+    m_cache.insert(host, { addresses, now + kCacheTTL });
+}
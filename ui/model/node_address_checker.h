@@ -0,0 +1,85 @@
+// Copyright 2019 The Hds Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <QObject>
+#include <QTimer>
+#include <QHash>
+#include <QList>
+#include <QHostAddress>
+#include <QElapsedTimer>
+#include <QHostInfo>
+
+class QTcpSocket;
+
+// Validates the remote node address typed in settings.
+// Edits are debounced, a new check supersedes the one in flight (the pending
+// DNS lookup is aborted and late results are dropped), resolved addresses are
+// cached for a short time and every resolved address is probed with a TCP
+// connect in parallel to report the best round trip.
+class NodeAddressChecker : public QObject
+{
+    Q_OBJECT
+public:
+    static constexpr int kDebounceInterval = 1000;      // ms
+    static constexpr int kProbeTimeout = 3000;          // ms
+    static constexpr qint64 kCacheTTL = 60 * 1000;      // ms
+    static constexpr int kMaxCacheSize = 32;
+    static constexpr int kMaxProbes = 4;
+
+    explicit NodeAddressChecker(QObject* parent = nullptr);
+    ~NodeAddressChecker() override;
+
+    // starts the check after kDebounceInterval of silence, port 0 skips the probes
+    void check(const QString& host, quint16 port);
+    void cancel();
+
+    bool isChecking() const;
+
+signals:
+    // the host is resolvable
+    void addressChecked(const QString& host, bool isValid);
+    // latency is -1 if no address accepted the connection
+    void probeFinished(const QString& host, quint16 port, int latency);
+
+private slots:
+    void onDebounce();
+    void onLookedUp(const QHostInfo& info);
+
+private:
+    struct CacheEntry
+    {
+        QList<QHostAddress> addresses;
+        qint64 expiresAt;
+    };
+
+    void onResolved(const QList<QHostAddress>& addresses);
+    void startProbes(const QList<QHostAddress>& addresses);
+    void onProbeDone(QTcpSocket* socket, bool connected);
+    void abortProbes();
+    void finishProbes();
+    bool findInCache(const QString& host, QList<QHostAddress>& addresses);
+    void putToCache(const QString& host, const QList<QHostAddress>& addresses);
+
+    QTimer m_debounce;
+    QTimer m_probeTimeout;
+    QElapsedTimer m_clock;
+    QString m_host;
+    quint16 m_port = 0;
+    int m_lookupId = -1;
+    QList<QTcpSocket*> m_probes;
+    int m_bestLatency = -1;
+    QHash<QString, CacheEntry> m_cache;
+};
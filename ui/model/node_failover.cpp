@@ -0,0 +1,246 @@
+// Copyright 2019 The Hds Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "node_failover.h"
+
+#include <algorithm>
+#include <sstream>
+#include <QDateTime>
+#include "wallet_model.h"
+#include "settings.h"
+#include "ui_log.h"
+#include "peer_ranker.h"
+#include "utility/logger.h"
+
+namespace
+{
+    std::string toString(const NodeFailover::LatencyHistogram& histogram)
+    {
+        std::ostringstream ss;
+        for (size_t i = 0; i < histogram.size(); ++i)
+        {
+            if (i < NodeFailover::kLatencyBuckets.size())
+            {
+                ss << "<" << NodeFailover::kLatencyBuckets[i] << ":" << histogram[i] << " ";
+            }
+            else
+            {
+                ss << ">=" << NodeFailover::kLatencyBuckets.back() << ":" << histogram[i];
+            }
+        }
+        return ss.str();
+    }
+}  // namespace
+
+NodeFailover::NodeFailover(WalletModel& wallet, WalletSettings& settings, PeerRanker& peerRanker, QObject* parent)
+    : QObject(parent)
+    , m_wallet(wallet)
+    , m_settings(settings)
+    , m_peerRanker(peerRanker)
+{
+    connect(&m_wallet, SIGNAL(nodeConnectionChanged(bool)), SLOT(onNodeConnectionChanged(bool)));
+    connect(&m_wallet, SIGNAL(stateIDChanged()), SLOT(onStateIDChanged()));
+    connect(&m_wallet, SIGNAL(syncProgressUpdated(int, int)), SLOT(onSyncProgressUpdated(int, int)));
+    connect(&m_peerRanker, SIGNAL(rankingChanged()), SLOT(onRankingChanged()));
+    connect(&m_checkTimer, SIGNAL(timeout()), SLOT(onCheck()));
+
+    reset();
+    m_checkTimer.start(kCheckInterval);
+}
+
+void NodeFailover::reset()
+{
+    auto previousNode = m_currentNode;
+    m_currentNode = m_settings.getNodeAddress();
+    m_failedNodes.clear();
+    m_isConnected = false;
+    m_isConnecting = true;
+    m_sinceConnectionChanged.start();
+    m_sinceTipChanged.start();
+    m_sinceSwitched.start();
+
+    if (!previousNode.isEmpty() && previousNode != m_currentNode)
+    {
+        emit nodeSwitched(m_currentNode);
+    }
+}
+
+QString NodeFailover::getCurrentNode() const
+{
+    return m_currentNode;
+}
+
+bool NodeFailover::isOnFallback() const
+{
+    return m_currentNode != m_settings.getNodeAddress();
+}
+
+NodeFailover::LatencyHistogram NodeFailover::getLatencyHistogram(const QString& node) const
+{
+    return m_histograms.value(node, LatencyHistogram{});
+}
+
+void NodeFailover::onNodeConnectionChanged(bool isNodeConnected)
+{
+    if (isNodeConnected && !m_isConnected)
+    {
+        if (m_isConnecting)
+        {
+            // time to connect since the node was set
+            addLatency(m_currentNode, static_cast<int>(m_sinceSwitched.elapsed()));
+            m_isConnecting = false;
+        }
+        m_failedNodes.removeAll(m_currentNode);
+        m_sinceTipChanged.restart();
+    }
+
+    m_isConnected = isNodeConnected;
+    m_sinceConnectionChanged.restart();
+}
+
+void NodeFailover::onStateIDChanged()
+{
+    m_sinceTipChanged.restart();
+}
+
+void NodeFailover::onSyncProgressUpdated(int done, int total)
+{
+    m_isSyncing = done < total;
+}
+
+void NodeFailover::onRankingChanged()
+{
+    for (const auto& peer : m_peerRanker.getRanking())
+    {
+        addLatency(peer, m_peerRanker.getLatency(peer));
+    }
+}
+
+void NodeFailover::onCheck()
+{
+    if (!isEnabled())
+    {
+        if (!m_settings.getRunLocalNode() && isOnFallback())
+        {
+            UI_LOG_INFO() << "Node failover is turned off, back to the primary node " << m_settings.getNodeAddress().toStdString();
+            switchTo(m_settings.getNodeAddress());
+        }
+        return;
+    }
+
+    if (isNodeHealthy())
+    {
+        if (isOnFallback() && m_sinceSwitched.elapsed() > kPrimaryRetryInterval)
+        {
+            UI_LOG_INFO() << "Trying the primary node " << m_settings.getNodeAddress().toStdString() << " again";
+            switchTo(m_settings.getNodeAddress());
+        }
+        return;
+    }
+
+    if (!m_failedNodes.contains(m_currentNode))
+    {
+        m_failedNodes.push_back(m_currentNode);
+    }
+
+    auto candidates = getCandidates();
+    auto it = std::find_if(candidates.begin(), candidates.end(), [this](const QString& node)
+    {
+        return !m_failedNodes.contains(node);
+    });
+
+    if (it == candidates.end())
+    {
+        // all of them failed, go round again
+        m_failedNodes.clear();
+        m_failedNodes.push_back(m_currentNode);
+        it = std::find_if(candidates.begin(), candidates.end(), [this](const QString& node)
+        {
+            return node != m_currentNode;
+        });
+    }
+
+    if (it == candidates.end())
+    {
+        m_peerRanker.rankIfStale(PeerRanker::getDefaultPeers(), kPrimaryRetryInterval);
+        return;
+    }
+
+    switchTo(*it);
+}
+
+bool NodeFailover::isEnabled() const
+{
+    return !m_settings.getRunLocalNode() && m_settings.isNodeFailoverEnabled();
+}
+
+bool NodeFailover::isNodeHealthy() const
+{
+    if (!m_isConnected)
+    {
+        return m_sinceConnectionChanged.elapsed() < kMaxDisconnected;
+    }
+
+    if (m_isSyncing)
+    {
+        return true;
+    }
+
+    // the tip of a stalled node is old and does not move
+    auto tipTime = static_cast<qint64>(m_wallet.getCurrentHeightTimestamp());
+    auto lag = QDateTime::currentSecsSinceEpoch() - tipTime;
+    return tipTime == 0 || lag < kMaxTipLag || m_sinceTipChanged.elapsed() < kMaxTipLag * 1000;
+}
+
+QStringList NodeFailover::getCandidates() const
+{
+    QStringList candidates;
+    candidates.push_back(m_settings.getNodeAddress());
+    for (const auto& peer : m_peerRanker.getRanking())
+    {
+        if (!candidates.contains(peer))
+        {
+            candidates.push_back(peer);
+        }
+    }
+    return candidates;
+}
+
+void NodeFailover::switchTo(const QString& node)
+{
+    UI_LOG_INFO() << "Switching node " << m_currentNode.toStdString() << " -> " << node.toStdString()
+                  << ", connect latency " << toString(getLatencyHistogram(m_currentNode));
+
+    m_currentNode = node;
+    m_isConnected = false;
+    m_isConnecting = true;
+    m_sinceConnectionChanged.restart();
+    m_sinceTipChanged.restart();
+    m_sinceSwitched.restart();
+    m_wallet.getAsync()->setNodeAddress(node.toStdString());
+
+    emit nodeSwitched(node);
+}
+
+void NodeFailover::addLatency(const QString& node, int latency)
+{
+    if (latency < 0)
+    {
+        return;
+    }
+
+    auto& histogram = m_histograms[node];
+    auto bucket = std::upper_bound(kLatencyBuckets.begin(), kLatencyBuckets.end(), latency) - kLatencyBuckets.begin();
+    ++histogram[bucket];
+}
@@ -0,0 +1,86 @@
+// Copyright 2019 The Hds Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <QObject>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QStringList>
+#include <QMap>
+#include <array>
+
+class WalletModel;
+class WalletSettings;
+class PeerRanker;
+
+// Keeps the wallet on a healthy remote node. The node from the settings is
+// the primary one, the ranked default peers are the fallbacks. The node is
+// switched when it stays disconnected or its tip does not move, then the
+// primary node is tried again from time to time. Not used with the local node
+// and goes back to the primary node when turned off in the settings.
+class NodeFailover : public QObject
+{
+    Q_OBJECT
+public:
+    static constexpr int kCheckInterval = 10 * 1000;            // ms
+    static constexpr qint64 kMaxDisconnected = 30 * 1000;       // ms
+    static constexpr qint64 kMaxTipLag = 15 * 60;               // s
+    static constexpr qint64 kPrimaryRetryInterval = 10 * 60 * 1000; // ms
+
+    // connect latency buckets upper bounds in ms, the last bucket is for the rest
+    static constexpr std::array<int, 6> kLatencyBuckets = { 50, 100, 200, 500, 1000, 2000 };
+    using LatencyHistogram = std::array<int, kLatencyBuckets.size() + 1>;
+
+    NodeFailover(WalletModel& wallet, WalletSettings& settings, PeerRanker& peerRanker, QObject* parent = nullptr);
+
+    // the settings were changed, start over with the new primary node
+    void reset();
+
+    QString getCurrentNode() const;
+    bool isOnFallback() const;
+    LatencyHistogram getLatencyHistogram(const QString& node) const;
+
+signals:
+    // also emitted when reset() moves back to the primary node
+    void nodeSwitched(const QString& node);
+
+private slots:
+    void onNodeConnectionChanged(bool isNodeConnected);
+    void onStateIDChanged();
+    void onSyncProgressUpdated(int done, int total);
+    void onRankingChanged();
+    void onCheck();
+
+private:
+    bool isEnabled() const;
+    bool isNodeHealthy() const;
+    QStringList getCandidates() const;
+    void switchTo(const QString& node);
+    void addLatency(const QString& node, int latency);
+
+    WalletModel& m_wallet;
+    WalletSettings& m_settings;
+    PeerRanker& m_peerRanker;
+    QTimer m_checkTimer;
+    QString m_currentNode;
+    bool m_isConnected = false;
+    bool m_isConnecting = false;
+    bool m_isSyncing = false;
+    QElapsedTimer m_sinceConnectionChanged;
+    QElapsedTimer m_sinceTipChanged;
+    QElapsedTimer m_sinceSwitched;
+    QStringList m_failedNodes;
+    QMap<QString, LatencyHistogram> m_histograms;
+};
@@ -29,7 +29,8 @@ using namespace std;
 NodeModel::NodeModel()
     : m_nodeClient(this)
 {
-
+    connect(this, &NodeModel::startedNode, &m_resourceGovernor, &NodeResourceGovernor::onNodeStarted);
+    connect(this, &NodeModel::stoppedNode, &m_resourceGovernor, &NodeResourceGovernor::onNodeStopped);
 }
 
 void NodeModel::setKdf(hds::Key::IKdf::Ptr kdf)
@@ -44,6 +45,8 @@ void NodeModel::setOwnerKey(hds::Key::IPKdf::Ptr key)
 
 void NodeModel::startNode()
 {
+    auto& settings = AppModel::getInstance().getSettings();
+    m_resourceGovernor.setLimits(settings.getLocalNodeCpuCores(), settings.isLocalNodeLowPriority());
     m_nodeClient.startNode();
 }
 
@@ -62,6 +65,40 @@ bool NodeModel::isNodeRunning() const
     return m_nodeClient.isNodeRunning();
 }
 
+NodeResourceGovernor& NodeModel::getResourceGovernor()
+{
+    return m_resourceGovernor;
+}
+
+void NodeModel::importSnapshot(const QString& snapshotPath, const QString& checkpointPath)
+{
+    assert(!isNodeRunning());
+    if (m_snapshotImporter)
+    {
+        return;
+    }
+
+    auto nodeStorage = QString::fromStdString(AppModel::getInstance().getSettings().getLocalNodeStorage());
+    m_snapshotImporter = std::make_unique<NodeSnapshotImporter>(snapshotPath, checkpointPath, nodeStorage);
+    connect(m_snapshotImporter.get(), &NodeSnapshotImporter::progressChanged, this, [this](quint64 done, quint64 total)
+    {
+        onInitProgressUpdated(done, total);
+    });
+    connect(m_snapshotImporter.get(), &QThread::finished, this, [this]()
+    {
+        bool isSucceeded = m_snapshotImporter->isSucceeded();
+        auto error = m_snapshotImporter->getError();
+        m_snapshotImporter.reset();
+        emit snapshotImported(isSucceeded, error);
+    });
+    m_snapshotImporter->start(QThread::LowPriority);
+}
+
+bool NodeModel::isImportingSnapshot() const
+{
+    return m_snapshotImporter != nullptr;
+}
+
 void NodeModel::onInitProgressUpdated(uint64_t done, uint64_t total)
 {
     emit initProgressUpdated(
@@ -90,6 +127,8 @@ void NodeModel::onFailedToStartNode(io::ErrorCode errorCode)
 
 void NodeModel::onNodeCreated()
 {
+    // called in the node thread
+    m_resourceGovernor.onNodeCreated();
     emit createdNode();
 }
 
@@ -24,6 +24,8 @@
 #include "utility/io/errorhandling.h"
 #include "utility/io/reactor.h"
 #include "wallet/core/common.h"
+#include "node_resource_governor.h"
+#include "node_snapshot_importer.h"
 
 class NodeModel 
     : public QObject
@@ -42,6 +44,12 @@ public:
     void start();
 
     bool isNodeRunning() const;
+    NodeResourceGovernor& getResourceGovernor();
+
+    // replaces the node DB with a verified snapshot, the node must be stopped.
+    // The progress is reported as the node init progress
+    void importSnapshot(const QString& snapshotPath, const QString& checkpointPath);
+    bool isImportingSnapshot() const;
 
 signals:
     void initProgressUpdated(quint64 done, quint64 total);
@@ -52,6 +60,7 @@ signals:
     void failedToSyncNode(hds::wallet::ErrorType errorType);
     void createdNode();
     void destroyedNode();
+    void snapshotImported(bool isSucceeded, const QString& error);
 
 protected:
     void onInitProgressUpdated(uint64_t done, uint64_t total) override;
@@ -71,5 +80,8 @@ protected:
     void onNodeThreadFinished() override;
 
 private:
+    // must outlive the node thread, it registers there
+    NodeResourceGovernor m_resourceGovernor;
+    std::unique_ptr<NodeSnapshotImporter> m_snapshotImporter;
     hds::NodeClient m_nodeClient;
 };
@@ -0,0 +1,360 @@
+// Copyright 2019 The Hds Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "node_resource_governor.h"
+
+#include <algorithm>
+#include <thread>
+#include "utility/logger.h"
+
+#if defined(Q_OS_LINUX)
+#include <QDir>
+#include <QFile>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#elif defined(Q_OS_WIN32)
+#include <windows.h>
+#include <tlhelp32.h>
+#endif
+
+namespace
+{
+#if defined(Q_OS_LINUX)
+    const int kLowNice = 10;
+    // ioprio_set is not wrapped by glibc
+    const int kIOPrioWhoProcess = 1;
+    const int kIOPrioClassShift = 13;
+    const int kIOPrioClassBestEffort = 2;
+    const int kIOPrioLowest = 7;
+
+    QByteArray readTaskFile(NodeResourceGovernor::ThreadID thread, const char* name)
+    {
+        QFile file(QString("/proc/self/task/%1/%2").arg(thread).arg(name));
+        return file.open(QIODevice::ReadOnly) ? file.readAll() : QByteArray();
+    }
+#endif
+}  // namespace
+
+NodeResourceGovernor::NodeResourceGovernor(QObject* parent)
+    : QObject(parent)
+{
+    m_usageTimer.setInterval(kUsageInterval);
+    connect(&m_usageTimer, SIGNAL(timeout()), SLOT(onSampleUsage()));
+}
+
+bool NodeResourceGovernor::isSupported()
+{
+#if defined(Q_OS_LINUX) || defined(Q_OS_WIN32)
+    return true;
+#else
+    return false;
+#endif
+}
+
+void NodeResourceGovernor::setLimits(int cores, bool lowPriority)
+{
+    std::set<ThreadID> threads;
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (m_cores == cores && m_lowPriority == lowPriority)
+        {
+            return;
+        }
+        m_cores = cores;
+        m_lowPriority = lowPriority;
+        threads = m_nodeThreads;
+    }
+
+    for (auto thread : threads)
+    {
+        apply(thread, cores, lowPriority);
+    }
+}
+
+void NodeResourceGovernor::onNodeStarted()
+{
+    std::set<ThreadID> threads;
+    std::set<ThreadID> workers;
+    int cores = 0;
+    bool lowPriority = false;
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        for (auto thread : getProcessThreads())
+        {
+            if (m_otherThreads.find(thread) == m_otherThreads.end() && m_nodeThreads.insert(thread).second)
+            {
+                workers.insert(thread);
+            }
+        }
+        threads = m_nodeThreads;
+        cores = m_cores;
+        lowPriority = m_lowPriority;
+    }
+
+    for (auto thread : workers)
+    {
+        apply(thread, cores, lowPriority);
+    }
+    LOG_DEBUG() << "Node threads: " << threads.size() << ", " << workers.size() << " started by the node";
+
+    m_lastUsage = getUsage(threads);
+    m_sinceSample.start();
+    m_usageTimer.start();
+}
+
+void NodeResourceGovernor::onNodeStopped()
+{
+    m_usageTimer.stop();
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_nodeThreads.clear();
+        m_otherThreads.clear();
+    }
+    m_cpuUsage = 0.;
+    m_ioBytesPerSecond = 0;
+    emit usageChanged();
+}
+
+void NodeResourceGovernor::onNodeCreated()
+{
+    auto thread = getCurrentThreadID();
+    auto otherThreads = getProcessThreads();
+    otherThreads.erase(thread);
+    int cores = 0;
+    bool lowPriority = false;
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_otherThreads = std::move(otherThreads);
+        if (!m_nodeThreads.insert(thread).second)
+        {
+            return;
+        }
+        cores = m_cores;
+        lowPriority = m_lowPriority;
+    }
+    apply(thread, cores, lowPriority);
+}
+
+double NodeResourceGovernor::getCpuUsage() const
+{
+    return m_cpuUsage;
+}
+
+qint64 NodeResourceGovernor::getIOBytesPerSecond() const
+{
+    return m_ioBytesPerSecond;
+}
+
+void NodeResourceGovernor::onSampleUsage()
+{
+    std::set<ThreadID> threads;
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        threads = m_nodeThreads;
+    }
+
+    auto usage = getUsage(threads);
+    auto elapsed = std::max<qint64>(m_sinceSample.restart(), 1);
+    // the counters of the threads which have finished are gone
+    m_cpuUsage = std::max<qint64>(usage.cpuTime - m_lastUsage.cpuTime, 0) * 100. / elapsed;
+    m_ioBytesPerSecond = std::max<qint64>(usage.ioBytes - m_lastUsage.ioBytes, 0) * 1000 / elapsed;
+    m_lastUsage = usage;
+    emit usageChanged();
+}
+
+#if defined(Q_OS_LINUX)
+
+void NodeResourceGovernor::apply(ThreadID thread, int cores, bool lowPriority) const
+{
+    auto tid = static_cast<pid_t>(thread);
+
+    // unprivileged processes cannot lower nice, so normal priority is restored with the node restart
+    if (setpriority(PRIO_PROCESS, tid, lowPriority ? kLowNice : 0) != 0)
+    {
+        LOG_DEBUG() << "setpriority failed for the node thread " << thread << ": " << errno;
+    }
+
+    int ioprio = lowPriority ? (kIOPrioClassBestEffort << kIOPrioClassShift) | kIOPrioLowest : 0;
+    syscall(SYS_ioprio_set, kIOPrioWhoProcess, tid, ioprio);
+
+    // the node gets the last cores, the first one is left for the UI
+    int total = static_cast<int>(std::thread::hardware_concurrency());
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int i = (cores > 0 && cores < total) ? total - cores : 0; i < total; ++i)
+    {
+        CPU_SET(i, &set);
+    }
+    if (total > 0 && sched_setaffinity(tid, sizeof(set), &set) != 0)
+    {
+        LOG_DEBUG() << "sched_setaffinity failed for the node thread " << thread << ": " << errno;
+    }
+}
+
+NodeResourceGovernor::ThreadID NodeResourceGovernor::getCurrentThreadID()
+{
+    return static_cast<ThreadID>(syscall(SYS_gettid));
+}
+
+std::set<NodeResourceGovernor::ThreadID> NodeResourceGovernor::getProcessThreads()
+{
+    std::set<ThreadID> threads;
+    for (const auto& name : QDir("/proc/self/task").entryList(QDir::Dirs | QDir::NoDotAndDotDot))
+    {
+        bool isOk = false;
+        auto thread = name.toULongLong(&isOk);
+        if (isOk)
+        {
+            threads.insert(thread);
+        }
+    }
+    return threads;
+}
+
+NodeResourceGovernor::Usage NodeResourceGovernor::getUsage(const std::set<ThreadID>& threads)
+{
+    static const qint64 ticksPerSecond = sysconf(_SC_CLK_TCK);
+    Usage usage;
+    for (auto thread : threads)
+    {
+        // utime and stime are the 14th and 15th fields, the 2nd one is the name in braces
+        auto stat = readTaskFile(thread, "stat");
+        auto fields = stat.mid(stat.lastIndexOf(')') + 2).split(' ');
+        if (fields.size() > 12)
+        {
+            usage.cpuTime += (fields[11].toLongLong() + fields[12].toLongLong()) * 1000 / ticksPerSecond;
+        }
+
+        for (const auto& line : readTaskFile(thread, "io").split('\n'))
+        {
+            if (line.startsWith("read_bytes:") || line.startsWith("write_bytes:"))
+            {
+                usage.ioBytes += line.mid(line.indexOf(':') + 1).trimmed().toLongLong();
+            }
+        }
+    }
+    return usage;
+}
+
+#elif defined(Q_OS_WIN32)
+
+void NodeResourceGovernor::apply(ThreadID thread, int cores, bool lowPriority) const
+{
+    auto handle = OpenThread(THREAD_SET_INFORMATION | THREAD_QUERY_INFORMATION, FALSE, static_cast<DWORD>(thread));
+    if (!handle)
+    {
+        return;
+    }
+
+    SetThreadPriority(handle, lowPriority ? THREAD_PRIORITY_LOWEST : THREAD_PRIORITY_NORMAL);
+
+    // the node gets the last cores, the first one is left for the UI
+    int total = static_cast<int>(std::thread::hardware_concurrency());
+    total = total < 64 ? total : 64;
+    DWORD_PTR mask = 0;
+    for (int i = (cores > 0 && cores < total) ? total - cores : 0; i < total; ++i)
+    {
+        mask |= DWORD_PTR(1) << i;
+    }
+    if (mask)
+    {
+        SetThreadAffinityMask(handle, mask);
+    }
+    CloseHandle(handle);
+}
+
+NodeResourceGovernor::ThreadID NodeResourceGovernor::getCurrentThreadID()
+{
+    return GetCurrentThreadId();
+}
+
+std::set<NodeResourceGovernor::ThreadID> NodeResourceGovernor::getProcessThreads()
+{
+    std::set<ThreadID> threads;
+    auto snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPTHREAD, 0);
+    if (snapshot == INVALID_HANDLE_VALUE)
+    {
+        return threads;
+    }
+
+    const auto process = GetCurrentProcessId();
+    THREADENTRY32 entry = {};
+    entry.dwSize = sizeof(entry);
+    for (auto isOk = Thread32First(snapshot, &entry); isOk; isOk = Thread32Next(snapshot, &entry))
+    {
+        if (entry.th32OwnerProcessID == process)
+        {
+            threads.insert(entry.th32ThreadID);
+        }
+    }
+    CloseHandle(snapshot);
+    return threads;
+}
+
+NodeResourceGovernor::Usage NodeResourceGovernor::getUsage(const std::set<ThreadID>& threads)
+{
+    auto toMs = [](const FILETIME& time)
+    {
+        return static_cast<qint64>((static_cast<quint64>(time.dwHighDateTime) << 32 | time.dwLowDateTime) / 10000);
+    };
+
+    Usage usage;
+    for (auto thread : threads)
+    {
+        auto handle = OpenThread(THREAD_QUERY_LIMITED_INFORMATION, FALSE, static_cast<DWORD>(thread));
+        if (!handle)
+        {
+            continue;
+        }
+        FILETIME creation, exit, kernel, user;
+        if (GetThreadTimes(handle, &creation, &exit, &kernel, &user))
+        {
+            usage.cpuTime += toMs(kernel) + toMs(user);
+        }
+        CloseHandle(handle);
+    }
+
+    // there are no per thread I/O counters, the node makes the most of the process I/O
+    IO_COUNTERS counters;
+    if (GetProcessIoCounters(GetCurrentProcess(), &counters))
+    {
+        usage.ioBytes = static_cast<qint64>(counters.ReadTransferCount + counters.WriteTransferCount);
+    }
+    return usage;
+}
+
+#else
+
+void NodeResourceGovernor::apply(ThreadID, int, bool) const
+{
+}
+
+NodeResourceGovernor::ThreadID NodeResourceGovernor::getCurrentThreadID()
+{
+    return 0;
+}
+
+std::set<NodeResourceGovernor::ThreadID> NodeResourceGovernor::getProcessThreads()
+{
+    return {};
+}
+
+NodeResourceGovernor::Usage NodeResourceGovernor::getUsage(const std::set<ThreadID>&)
+{
+    return {};
+}
+
+#endif
@@ -0,0 +1,88 @@
+// Copyright 2019 The Hds Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <QObject>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <map>
+#include <mutex>
+#include <set>
+
+// Limits the CPU and disk use of the integrated node and measures it.
+// The node threads are the node thread of NodeClient and the threads of the process
+// which appear between the node creation and its start, the node starts its workers
+// then. The threads the node starts later are not handled, on Linux they inherit
+// the limits of the thread which starts them. The cores limit is applied as the CPU
+// affinity of the node threads and the low priority as nice 10 and the lowest best
+// effort I/O priority (thread priority on Windows).
+// Changes are applied to the running node.
+class NodeResourceGovernor : public QObject
+{
+    Q_OBJECT
+public:
+    static constexpr int kUsageInterval = 2000;    // ms
+
+    using ThreadID = quint64;
+
+    explicit NodeResourceGovernor(QObject* parent = nullptr);
+
+    static bool isSupported();
+
+    // 0 cores means all of them
+    void setLimits(int cores, bool lowPriority);
+
+    // called in the GUI thread
+    void onNodeStarted();
+    void onNodeStopped();
+    // called in the node thread
+    void onNodeCreated();
+
+    // percent of one core
+    double getCpuUsage() const;
+    qint64 getIOBytesPerSecond() const;
+
+signals:
+    void usageChanged();
+
+private slots:
+    void onSampleUsage();
+
+private:
+    struct Usage
+    {
+        qint64 cpuTime = 0;     // ms
+        qint64 ioBytes = 0;
+    };
+
+    void apply(ThreadID thread, int cores, bool lowPriority) const;
+    static ThreadID getCurrentThreadID();
+    static std::set<ThreadID> getProcessThreads();
+    // threads which have gone are skipped
+    static Usage getUsage(const std::set<ThreadID>& threads);
+
+    mutable std::mutex m_mutex;
+    int m_cores = 0;
+    bool m_lowPriority = false;
+    std::set<ThreadID> m_nodeThreads;
+    // of the process when the node was created
+    std::set<ThreadID> m_otherThreads;
+
+    QTimer m_usageTimer;
+    QElapsedTimer m_sinceSample;
+    Usage m_lastUsage;
+    double m_cpuUsage = 0.;
+    qint64 m_ioBytesPerSecond = 0;
+};
@@ -0,0 +1,203 @@
+// Copyright 2019 The Hds Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "node_snapshot_importer.h"
+
+#include <QCryptographicHash>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QElapsedTimer>
+#include "ui_log.h"
+
+namespace
+{
+    const qint64 kChunkSize = 1024 * 1024;
+    const char* kImportingSuffix = ".importing";
+    const char* kBackupSuffix = ".backup";
+    // SQLite files of the node DB which belong to the replaced one
+    const char* kNodeDBCompanions[] = { "-journal", "-wal", "-shm" };
+}  // namespace
+
+NodeSnapshotImporter::NodeSnapshotImporter(const QString& snapshotPath, const QString& checkpointPath, const QString& nodeStorage)
+    : m_snapshotPath(snapshotPath)
+    , m_checkpointPath(checkpointPath)
+    , m_nodeStorage(nodeStorage)
+{
+}
+
+NodeSnapshotImporter::~NodeSnapshotImporter()
+{
+    requestInterruption();
+    wait();
+}
+
+void NodeSnapshotImporter::run()
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    if (!readCheckpoint())
+    {
+        UI_LOG_ERROR() << "Node snapshot checkpoint is invalid: " << m_error.toStdString();
+        return;
+    }
+
+    auto target = m_nodeStorage + kImportingSuffix;
+    if (!copy(target))
+    {
+        QFile::remove(target);
+        if (!isInterruptionRequested())
+        {
+            UI_LOG_ERROR() << "Node snapshot import failed: " << m_error.toStdString();
+        }
+        return;
+    }
+
+    // the old DB stays until the new one is in place
+    auto backup = m_nodeStorage + kBackupSuffix;
+    QFile::remove(backup);
+    const bool hasOldDB = QFile::exists(m_nodeStorage);
+    if (hasOldDB && !QFile::rename(m_nodeStorage, backup))
+    {
+        QFile::remove(target);
+        m_error = "failed to back up " + m_nodeStorage;
+        UI_LOG_ERROR() << "Node snapshot import failed: " << m_error.toStdString();
+        return;
+    }
+
+    if (!QFile::rename(target, m_nodeStorage))
+    {
+        QFile::remove(target);
+        if (hasOldDB && !QFile::rename(backup, m_nodeStorage))
+        {
+            UI_LOG_ERROR() << "Failed to restore the node DB from " << backup.toStdString();
+        }
+        m_error = "failed to replace " + m_nodeStorage;
+        UI_LOG_ERROR() << "Node snapshot import failed: " << m_error.toStdString();
+        return;
+    }
+
+    for (auto companion : kNodeDBCompanions)
+    {
+        QFile::remove(m_nodeStorage + companion);
+    }
+    QFile::remove(backup);
+
+    UI_LOG_INFO() << "Node snapshot at height " << m_checkpoint.height << " imported in " << timer.elapsed() << " ms";
+    m_isSucceeded = true;
+}
+
+bool NodeSnapshotImporter::isSucceeded() const
+{
+    return m_isSucceeded;
+}
+
+const QString& NodeSnapshotImporter::getError() const
+{
+    return m_error;
+}
+
+const NodeSnapshotImporter::Checkpoint& NodeSnapshotImporter::getCheckpoint() const
+{
+    return m_checkpoint;
+}
+
+bool NodeSnapshotImporter::readCheckpoint()
+{
+    QFile file(m_checkpointPath);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        m_error = "cannot open " + m_checkpointPath;
+        return false;
+    }
+
+    QJsonParseError parseError;
+    auto json = QJsonDocument::fromJson(file.readAll(), &parseError).object();
+    if (parseError.error != QJsonParseError::NoError)
+    {
+        m_error = parseError.errorString();
+        return false;
+    }
+
+    m_checkpoint.height = static_cast<quint64>(json.value("height").toDouble());
+    m_checkpoint.size = static_cast<qint64>(json.value("size").toDouble());
+    m_checkpoint.sha256 = QByteArray::fromHex(json.value("sha256").toString().toLatin1());
+
+    if (m_checkpoint.height == 0 || m_checkpoint.size <= 0 || m_checkpoint.sha256.size() != 32)
+    {
+        m_error = "height, size and sha256 are required";
+        return false;
+    }
+
+    if (QFileInfo(m_snapshotPath).size() != m_checkpoint.size)
+    {
+        m_error = "the snapshot size does not match the checkpoint";
+        return false;
+    }
+    return true;
+}
+
+bool NodeSnapshotImporter::copy(const QString& target)
+{
+    QFile source(m_snapshotPath);
+    QFile destination(target);
+    if (!source.open(QIODevice::ReadOnly) || !destination.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        m_error = "cannot open the snapshot or the node storage";
+        return false;
+    }
+
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    QByteArray chunk;
+    quint64 done = 0;
+    const auto total = static_cast<quint64>(m_checkpoint.size);
+    while (!source.atEnd())
+    {
+        if (isInterruptionRequested())
+        {
+            m_error = "cancelled";
+            return false;
+        }
+
+        chunk = source.read(kChunkSize);
+        if (chunk.isEmpty() || destination.write(chunk) != chunk.size())
+        {
+            m_error = "read or write error";
+            return false;
+        }
+        hash.addData(chunk);
+
+        auto percent = done * 100 / total;
+        done += chunk.size();
+        if (done * 100 / total != percent)
+        {
+            emit progressChanged(done, total);
+        }
+    }
+
+    if (!destination.flush() || done != total)
+    {
+        m_error = "the snapshot is incomplete";
+        return false;
+    }
+
+    if (hash.result() != m_checkpoint.sha256)
+    {
+        m_error = "the snapshot hash does not match the checkpoint";
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,59 @@
+// Copyright 2019 The Hds Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <QString>
+#include <QThread>
+
+// Imports a chain snapshot of the integrated node: a node.db copy and its
+// checkpoint, a JSON file with the snapshot height, size and SHA-256 of the node.db.
+// The file is hashed while it is copied next to the node storage and replaces it
+// only if it matches the checkpoint, the old DB is kept as a backup until then.
+// The checkpoint only proves that the file is the one it describes, the chain
+// in the snapshot is trusted without validation. The node must be stopped.
+class NodeSnapshotImporter : public QThread
+{
+    Q_OBJECT
+public:
+    struct Checkpoint
+    {
+        quint64 height = 0;
+        qint64 size = 0;
+        QByteArray sha256;
+    };
+
+    NodeSnapshotImporter(const QString& snapshotPath, const QString& checkpointPath, const QString& nodeStorage);
+    ~NodeSnapshotImporter() override;
+
+    void run() override;
+
+    bool isSucceeded() const;
+    const QString& getError() const;
+    const Checkpoint& getCheckpoint() const;
+
+signals:
+    void progressChanged(quint64 done, quint64 total);
+
+private:
+    bool readCheckpoint();
+    bool copy(const QString& target);
+
+    QString m_snapshotPath;
+    QString m_checkpointPath;
+    QString m_nodeStorage;
+    Checkpoint m_checkpoint;
+    QString m_error;
+    bool m_isSucceeded = false;
+};
@@ -0,0 +1,232 @@
+// Copyright 2019 The Hds Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "peer_ranker.h"
+
+#include <algorithm>
+#include <QDateTime>
+#include <QTcpSocket>
+#include "settings.h"
+#include "wallet/core/default_peers.h"
+#include "ui_log.h"
+
+namespace
+{
+    const char* kAddressKey = "address";
+    const char* kLatencyKey = "latency";
+    const char* kRankedAtKey = "ranked";
+
+    bool splitAddress(const QString& address, QString& host, quint16& port)
+    {
+        auto pos = address.lastIndexOf(':');
+        if (pos <= 0)
+        {
+            return false;
+        }
+        bool ok = false;
+        host = address.left(pos);
+        port = address.mid(pos + 1).toUShort(&ok);
+        return ok && port != 0;
+    }
+}  // namespace
+
+PeerRanker::PeerRanker(WalletSettings& settings, QObject* parent)
+    : QObject(parent)
+    , m_settings(settings)
+{
+    m_timeout.setSingleShot(true);
+    m_timeout.setInterval(kProbeTimeout);
+    connect(&m_timeout, &QTimer::timeout, this, [this]() { finish(); });
+
+    load();
+}
+
+PeerRanker::~PeerRanker()
+{
+    for (auto& peer : m_probes)
+    {
+        if (peer.socket)
+        {
+            peer.socket->disconnect(this);
+            peer.socket->abort();
+        }
+    }
+}
+
+QStringList PeerRanker::getDefaultPeers()
+{
+    QStringList peers;
+    for (const auto& peer : hds::getDefaultPeers())
+    {
+        peers.push_back(QString::fromStdString(peer));
+    }
+    return peers;
+}
+
+void PeerRanker::rank(const QStringList& peers)
+{
+    if (isRanking() || peers.isEmpty())
+    {
+        return;
+    }
+
+    m_clock.start();
+    m_timeout.start();
+
+    m_probes.reserve(peers.size());
+    for (const auto& address : peers)
+    {
+        Peer peer;
+        peer.address = address;
+
+        QString host;
+        quint16 port = 0;
+        if (splitAddress(address, host, port))
+        {
+            peer.socket = new QTcpSocket(this);
+            auto socket = peer.socket;
+            connect(socket, &QTcpSocket::connected, this, [this, socket]() { onProbeDone(socket, true); });
+            connect(socket, QOverload<QAbstractSocket::SocketError>::of(&QAbstractSocket::error),
+                    this, [this, socket]() { onProbeDone(socket, false); });
+            socket->connectToHost(host, port);
+        }
+        m_probes.push_back(peer);
+    }
+}
+
+void PeerRanker::rankIfStale(const QStringList& peers, qint64 maxAge)
+{
+    if (m_ranking.empty() || QDateTime::currentMSecsSinceEpoch() - m_rankedAt > maxAge)
+    {
+        rank(peers);
+    }
+}
+
+bool PeerRanker::isRanking() const
+{
+    return !m_probes.empty();
+}
+
+QStringList PeerRanker::getRanking() const
+{
+    QStringList ranking;
+    for (const auto& peer : m_ranking)
+    {
+        if (peer.latency >= 0)
+        {
+            ranking.push_back(peer.address);
+        }
+    }
+    return ranking;
+}
+
+QString PeerRanker::getBest() const
+{
+    return !m_ranking.empty() && m_ranking.front().latency >= 0 ? m_ranking.front().address : QString();
+}
+
+int PeerRanker::getLatency(const QString& peer) const
+{
+    auto it = std::find_if(m_ranking.begin(), m_ranking.end(), [&peer](const Peer& p) { return p.address == peer; });
+    return it != m_ranking.end() ? it->latency : -1;
+}
+
+void PeerRanker::onProbeDone(QTcpSocket* socket, bool connected)
+{
+    auto it = std::find_if(m_probes.begin(), m_probes.end(), [socket](const Peer& p) { return p.socket == socket; });
+    if (it == m_probes.end())
+    {
+        return;
+    }
+
+    if (connected)
+    {
+        it->latency = static_cast<int>(m_clock.elapsed());
+    }
+    it->socket = nullptr;
+    socket->disconnect(this);
+    socket->abort();
+    socket->deleteLater();
+
+    if (std::none_of(m_probes.begin(), m_probes.end(), [](const Peer& p) { return p.socket != nullptr; }))
+    {
+        finish();
+    }
+}
+
+void PeerRanker::finish()
+{
+    m_timeout.stop();
+    for (auto& peer : m_probes)
+    {
+        if (peer.socket)
+        {
+            peer.socket->disconnect(this);
+            peer.socket->abort();
+            peer.socket->deleteLater();
+            peer.socket = nullptr;
+        }
+    }
+
+    std::stable_sort(m_probes.begin(), m_probes.end(), [](const Peer& lhs, const Peer& rhs)
+    {
+        // unreachable peers go last
+        if ((lhs.latency < 0) != (rhs.latency < 0))
+        {
+            return lhs.latency >= 0;
+        }
+        return lhs.latency < rhs.latency;
+    });
+
+    m_ranking.swap(m_probes);
+    m_probes.clear();
+    m_rankedAt = QDateTime::currentMSecsSinceEpoch();
+    save();
+
+    if (!m_ranking.empty())
+    {
+        UI_LOG_INFO() << "Best peer: " << m_ranking.front().address.toStdString() << " latency: " << m_ranking.front().latency << " ms";
+    }
+    emit rankingChanged();
+}
+
+void PeerRanker::load()
+{
+    for (const auto& item : m_settings.getPeerRanking())
+    {
+        auto map = item.toMap();
+        Peer peer;
+        peer.address = map.value(kAddressKey).toString();
+        peer.latency = map.value(kLatencyKey, -1).toInt();
+        m_rankedAt = map.value(kRankedAtKey).toLongLong();
+        if (!peer.address.isEmpty())
+        {
+            m_ranking.push_back(peer);
+        }
+    }
+}
+
+void PeerRanker::save() const
+{
+    QVariantList ranking;
+    for (const auto& peer : m_ranking)
+    {
+        QVariantMap map;
+        map[kAddressKey] = peer.address;
+        map[kLatencyKey] = peer.latency;
+        map[kRankedAtKey] = m_rankedAt;
+        ranking.push_back(map);
+    }
+    m_settings.setPeerRanking(ranking);
+}
@@ -0,0 +1,74 @@
+// Copyright 2019 The Hds Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <QObject>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QStringList>
+#include <vector>
+
+class QTcpSocket;
+class WalletSettings;
+
+// Orders the node peers by the connect round trip. All the peers are probed
+// in parallel with a short timeout, the ranking is kept in the settings so
+// the best peer is known right away on the next start.
+class PeerRanker : public QObject
+{
+    Q_OBJECT
+public:
+    static constexpr int kProbeTimeout = 2000;  // ms
+
+    explicit PeerRanker(WalletSettings& settings, QObject* parent = nullptr);
+    ~PeerRanker() override;
+
+    static QStringList getDefaultPeers();
+
+    // does nothing if a ranking is running
+    void rank(const QStringList& peers);
+    // ranks again if the last ranking is older than maxAge
+    void rankIfStale(const QStringList& peers, qint64 maxAge);
+    bool isRanking() const;
+
+    // reachable peers, the fastest first
+    QStringList getRanking() const;
+    QString getBest() const;
+    // -1 if not reachable or unknown
+    int getLatency(const QString& peer) const;
+
+signals:
+    void rankingChanged();
+
+private:
+    struct Peer
+    {
+        QString address;
+        int latency = -1;
+        QTcpSocket* socket = nullptr;
+    };
+
+    void onProbeDone(QTcpSocket* socket, bool connected);
+    void finish();
+    void load();
+    void save() const;
+
+    WalletSettings& m_settings;
+    QTimer m_timeout;
+    QElapsedTimer m_clock;
+    std::vector<Peer> m_probes;
+    std::vector<Peer> m_ranking;
+    qint64 m_rankedAt = 0;
+};
@@ -0,0 +1,190 @@
+// Copyright 2019 The Hds Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "reactor_thread.h"
+#include "utility/logger.h"
+
+using namespace hds;
+using namespace std::chrono;
+
+namespace
+{
+    const unsigned kProbeInterval = 1000;
+    // log statistics every this number of probes
+    const uint64_t kLogPeriod = 300;
+}
+
+ReactorQueue::ReactorQueue(io::Reactor& reactor)
+    : m_event(io::AsyncEvent::create(reactor, [this]() { flush(); }))
+{
+}
+
+void ReactorQueue::post(std::function<void()>&& call)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_event)
+    {
+        return;
+    }
+
+    m_calls.push_back(std::move(call));
+    if (m_calls.size() == 1)
+    {
+        // otherwise the event is posted already
+        m_event->post();
+    }
+}
+
+void ReactorQueue::close()
+{
+    io::AsyncEvent::Ptr event;
+    std::vector<std::function<void()>> calls;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        event = std::move(m_event);
+        calls.swap(m_calls);
+    }
+    // the calls are destroyed out of the lock, they may own this queue
+}
+
+void ReactorQueue::flush()
+{
+    std::vector<std::function<void()>> calls;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        calls.swap(m_calls);
+    }
+
+    // calls may post again
+    for (const auto& call : calls)
+    {
+        call();
+    }
+}
+
+ReactorProbe::ReactorProbe(const std::string& name)
+    : m_name(name)
+{
+}
+
+void ReactorProbe::start(io::Reactor& reactor)
+{
+    m_lastProbe = steady_clock::now();
+    m_timer = io::Timer::create(reactor);
+    m_timer->start(kProbeInterval, true, [this]() { onProbe(); });
+}
+
+void ReactorProbe::stop()
+{
+    if (!m_timer)
+    {
+        return;
+    }
+    m_timer.reset();
+
+    auto stats = getLatencyStats();
+    LOG_INFO() << m_name << " reactor stopped, loop latency avg: " << stats.averageMs << " ms, max: " << stats.maxMs << " ms";
+}
+
+ReactorProbe::LatencyStats ReactorProbe::getLatencyStats() const
+{
+    LatencyStats stats;
+    stats.samples = m_samples;
+    stats.averageMs = stats.samples ? m_totalLatencyMs / stats.samples : 0;
+    stats.maxMs = m_maxLatencyMs;
+    return stats;
+}
+
+void ReactorProbe::onProbe()
+{
+    auto now = steady_clock::now();
+    auto elapsed = static_cast<uint64_t>(duration_cast<milliseconds>(now - m_lastProbe).count());
+    m_lastProbe = now;
+
+    uint64_t latency = elapsed > kProbeInterval ? elapsed - kProbeInterval : 0;
+    auto samples = ++m_samples;
+    m_totalLatencyMs += latency;
+    if (latency > m_maxLatencyMs)
+    {
+        m_maxLatencyMs = latency;
+    }
+
+    if (samples % kLogPeriod == 0)
+    {
+        auto stats = getLatencyStats();
+        LOG_DEBUG() << m_name << " reactor loop latency avg: " << stats.averageMs << " ms, max: " << stats.maxMs << " ms";
+    }
+}
+
+ReactorThread::ReactorThread(const std::string& name)
+    : m_name(name)
+    , m_reactor(io::Reactor::create())
+    , m_queue(*m_reactor)
+    , m_probe(name)
+{
+}
+
+ReactorThread::~ReactorThread()
+{
+    stop();
+}
+
+io::Reactor& ReactorThread::getReactor()
+{
+    return *m_reactor;
+}
+
+void ReactorThread::start()
+{
+    std::lock_guard<std::mutex> lock(m_threadMutex);
+    if (m_thread.joinable() || m_isStopped)
+    {
+        return;
+    }
+    LOG_INFO() << m_name << " reactor started";
+    m_thread = std::thread(&ReactorThread::run, this);
+}
+
+void ReactorThread::stop()
+{
+    std::lock_guard<std::mutex> lock(m_threadMutex);
+    m_isStopped = true;
+    if (!m_thread.joinable())
+    {
+        return;
+    }
+
+    m_reactor->stop();
+    m_thread.join();
+}
+
+void ReactorThread::post(std::function<void()>&& call)
+{
+    start();
+    m_queue.post(std::move(call));
+}
+
+ReactorThread::LatencyStats ReactorThread::getLatencyStats() const
+{
+    return m_probe.getLatencyStats();
+}
+
+void ReactorThread::run()
+{
+    io::Reactor::Scope scope(*m_reactor);
+
+    m_probe.start(*m_reactor);
+    m_reactor->run();
+    m_probe.stop();
+}
@@ -0,0 +1,114 @@
+// Copyright 2019 The Hds Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "utility/io/asyncevent.h"
+#include "utility/io/reactor.h"
+#include "utility/io/timer.h"
+
+// Runs functions posted from any thread on the reactor thread, in the posting order.
+// Must be created and closed on the reactor thread or while the reactor is not running,
+// calls posted while the reactor is stopped wait for the next run
+class ReactorQueue
+{
+public:
+    using Ptr = std::shared_ptr<ReactorQueue>;
+
+    explicit ReactorQueue(hds::io::Reactor& reactor);
+
+    void post(std::function<void()>&& call);
+    // drops the pending calls, the calls posted after are dropped too
+    void close();
+
+private:
+    void flush();
+
+    std::mutex m_mutex;
+    hds::io::AsyncEvent::Ptr m_event;
+    std::vector<std::function<void()>> m_calls;
+};
+
+// Measures the loop latency of a reactor, i.e. how late a periodic timer
+// fires because the loop is busy. start and stop are called on the reactor
+// thread or while the reactor is not running, the statistics can be read from any thread
+class ReactorProbe
+{
+public:
+    struct LatencyStats
+    {
+        uint64_t samples = 0;
+        uint64_t averageMs = 0;
+        uint64_t maxMs = 0;
+    };
+
+    explicit ReactorProbe(const std::string& name);
+
+    void start(hds::io::Reactor& reactor);
+    void stop();
+
+    LatencyStats getLatencyStats() const;
+
+private:
+    void onProbe();
+
+    std::string m_name;
+    hds::io::Timer::Ptr m_timer;
+    std::chrono::steady_clock::time_point m_lastProbe;
+
+    std::atomic<uint64_t> m_samples{ 0 };
+    std::atomic<uint64_t> m_totalLatencyMs{ 0 };
+    std::atomic<uint64_t> m_maxLatencyMs{ 0 };
+};
+
+// Runs a reactor in its own thread and measures its loop latency
+class ReactorThread
+{
+public:
+    using Ptr = std::shared_ptr<ReactorThread>;
+    using LatencyStats = ReactorProbe::LatencyStats;
+
+    explicit ReactorThread(const std::string& name);
+    ~ReactorThread();
+
+    // objects bound to the reactor should be created before start
+    hds::io::Reactor& getReactor();
+    // can be called from any thread, does nothing if the thread is running or stopped
+    void start();
+    void stop();
+    // starts the thread if it is not started yet, calls posted after stop never run
+    void post(std::function<void()>&& call);
+
+    LatencyStats getLatencyStats() const;
+
+private:
+    void run();
+
+    std::string m_name;
+    hds::io::Reactor::Ptr m_reactor;
+    ReactorQueue m_queue;
+    ReactorProbe m_probe;
+
+    std::mutex m_threadMutex;
+    std::thread m_thread;
+    bool m_isStopped = false;
+};
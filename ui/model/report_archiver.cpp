@@ -0,0 +1,345 @@
+// Copyright 2019 The Hds Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "report_archiver.h"
+
+#include <algorithm>
+#include <cassert>
+#include <thread>
+#include <QDateTime>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QTemporaryFile>
+#include <zlib.h>
+#include "quazip/quazip.h"
+#include "quazip/quazipfile.h"
+#include "ui_log.h"
+
+namespace
+{
+    const qint64 kChunkSize = 256 * 1024;
+    // QuaZipNewInfo keeps the size in ulong, which is 32 bits on Windows
+    const qint64 kMaxEntrySize = 0xFFFFFFFFLL;
+}  // namespace
+
+ReportArchiver::ReportArchiver(const QList<Entry>& entries, const QString& zipPath, qint64 maxLogsSize, QObject* parent)
+    : QThread(parent)
+    , m_entries(entries)
+    , m_zipPath(zipPath)
+    , m_maxLogsSize(maxLogsSize)
+{
+}
+
+ReportArchiver::~ReportArchiver()
+{
+    requestInterruption();
+    wait();
+}
+
+bool ReportArchiver::isSucceeded() const
+{
+    return m_isSucceeded;
+}
+
+void ReportArchiver::run()
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    prepareTasks();
+
+    QuaZip zip(m_zipPath);
+    zip.setZip64Enabled(true);
+    if (!zip.open(QuaZip::mdCreate))
+    {
+        UI_LOG_ERROR() << "Failed to create " << m_zipPath.toStdString();
+        return;
+    }
+
+    std::vector<std::thread> workers;
+    const auto workersCount = std::min<size_t>(std::max(QThread::idealThreadCount() - 1, 1), m_tasks.size());
+    for (size_t i = 0; i < workersCount; ++i)
+    {
+        workers.emplace_back([this]() { compressTasks(); });
+    }
+
+    // folders are stored as empty entries
+    QStringList folders;
+    for (const auto& entry : m_entries)
+    {
+        if (!entry.folder.isEmpty() && !folders.contains(entry.folder))
+        {
+            folders << entry.folder;
+            QuaZipFile folderFile(&zip);
+            folderFile.open(QIODevice::WriteOnly, QuaZipNewInfo(entry.folder));
+            folderFile.close();
+        }
+    }
+
+    // stored in order, while the next ones are being compressed
+    bool isOk = true;
+    for (auto& task : m_tasks)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            while (!task.isDone)
+            {
+                m_taskDone.wait_for(lock, std::chrono::milliseconds(100));
+                lock.unlock();
+                updateProgress();
+                lock.lock();
+            }
+        }
+
+        if (isInterruptionRequested())
+        {
+            isOk = false;
+            break;
+        }
+
+        if (task.isOk && !store(zip, task))
+        {
+            isOk = false;
+            break;
+        }
+        task.deflated.reset();
+        updateProgress();
+    }
+
+    if (!isOk)
+    {
+        requestInterruption();
+    }
+
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+    m_tasks.clear();
+
+    zip.close();
+    m_isSucceeded = isOk && zip.getZipError() == ZIP_OK;
+    if (!m_isSucceeded)
+    {
+        QFile::remove(m_zipPath);
+    }
+
+    UI_LOG_INFO() << "Problem report " << (m_isSucceeded ? "saved" : "failed or cancelled") << ", "
+                  << m_readBytes / 1024 << " KB read in " << timer.elapsed() << " ms";
+}
+
+void ReportArchiver::prepareTasks()
+{
+    std::vector<QFileInfo> logs;
+    for (const auto& entry : m_entries)
+    {
+        QFileInfo info(entry.filePath);
+        if (!info.isFile())
+        {
+            continue;
+        }
+
+        Task task;
+        task.filePath = info.absoluteFilePath();
+        task.zipName = entry.folder + info.fileName();
+        task.size = info.size();
+        if (task.size > kMaxEntrySize)
+        {
+            if (!entry.isLog)
+            {
+                UI_LOG_WARNING() << "Skipping " << task.filePath.toStdString() << ", it is too big for the report";
+                continue;
+            }
+            // the tail of the log is the most useful
+            task.offset = task.size - kMaxEntrySize;
+            task.size = kMaxEntrySize;
+        }
+        if (entry.isLog)
+        {
+            logs.push_back(info);
+        }
+        m_tasks.push_back(std::move(task));
+    }
+
+    if (m_maxLogsSize > 0)
+    {
+        // the most recent logs are kept in full while the cap allows
+        std::sort(logs.begin(), logs.end(), [](const QFileInfo& left, const QFileInfo& right)
+        {
+            return left.lastModified() > right.lastModified();
+        });
+
+        qint64 available = m_maxLogsSize;
+        for (const auto& log : logs)
+        {
+            auto task = std::find_if(m_tasks.begin(), m_tasks.end(), [&log](const Task& t)
+            {
+                return t.filePath == log.absoluteFilePath();
+            });
+
+            if (task == m_tasks.end())
+            {
+                continue;
+            }
+
+            if (available == 0)
+            {
+                m_tasks.erase(task);
+                continue;
+            }
+
+            if (task->size > available)
+            {
+                task->offset += task->size - available;
+                task->size = available;
+            }
+            available -= task->size;
+        }
+    }
+
+    for (const auto& task : m_tasks)
+    {
+        m_totalBytes += task.size;
+    }
+}
+
+void ReportArchiver::compressTasks()
+{
+    for (auto i = m_nextTask++; i < m_tasks.size(); i = m_nextTask++)
+    {
+        auto& task = m_tasks[i];
+        if (!isInterruptionRequested())
+        {
+            compress(task);
+        }
+
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            task.isDone = true;
+        }
+        m_taskDone.notify_all();
+    }
+}
+
+void ReportArchiver::compress(Task& task)
+{
+    QFile source(task.filePath);
+    if (!source.open(QIODevice::ReadOnly) || !source.seek(task.offset))
+    {
+        UI_LOG_WARNING() << "Failed to read " << task.filePath.toStdString();
+        return;
+    }
+
+    auto deflated = std::make_unique<QTemporaryFile>();
+    if (!deflated->open())
+    {
+        return;
+    }
+
+    z_stream stream = {};
+    // raw deflate, the zip entry provides the header
+    if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+    {
+        return;
+    }
+
+    QByteArray in;
+    QByteArray out(kChunkSize, Qt::Uninitialized);
+    quint32 crc = crc32(0L, Z_NULL, 0);
+    qint64 left = task.size;
+    bool isOk = true;
+    int flush = Z_NO_FLUSH;
+
+    while (isOk && flush != Z_FINISH)
+    {
+        if (isInterruptionRequested())
+        {
+            isOk = false;
+            break;
+        }
+
+        in = source.read(std::min(kChunkSize, left));
+        left -= in.size();
+        m_readBytes += in.size();
+        flush = (left == 0 || in.isEmpty()) ? Z_FINISH : Z_NO_FLUSH;
+        crc = crc32(crc, reinterpret_cast<const Bytef*>(in.constData()), static_cast<uInt>(in.size()));
+
+        stream.next_in = reinterpret_cast<Bytef*>(in.data());
+        stream.avail_in = static_cast<uInt>(in.size());
+        do
+        {
+            stream.next_out = reinterpret_cast<Bytef*>(out.data());
+            stream.avail_out = static_cast<uInt>(out.size());
+            deflate(&stream, flush);
+            const auto have = out.size() - static_cast<int>(stream.avail_out);
+            if (deflated->write(out.constData(), have) != have)
+            {
+                isOk = false;
+                break;
+            }
+        } while (stream.avail_out == 0);
+    }
+    deflateEnd(&stream);
+
+    if (isOk && deflated->flush() && deflated->seek(0))
+    {
+        // the size may be less if the file is shrunk meanwhile
+        task.size -= left;
+        task.crc = crc;
+        task.deflated = std::move(deflated);
+        task.isOk = true;
+    }
+}
+
+bool ReportArchiver::store(QuaZip& zip, Task& task)
+{
+    QuaZipNewInfo info(task.zipName, task.filePath);
+    // prepareTasks() keeps the entries within kMaxEntrySize
+    assert(task.size <= kMaxEntrySize);
+    info.uncompressedSize = static_cast<ulong>(task.size);
+
+    QuaZipFile zipFile(&zip);
+    if (!zipFile.open(QIODevice::WriteOnly, info, nullptr, task.crc, Z_DEFLATED, Z_DEFAULT_COMPRESSION, true))
+    {
+        return false;
+    }
+
+    while (!task.deflated->atEnd())
+    {
+        if (isInterruptionRequested())
+        {
+            return false;
+        }
+
+        auto chunk = task.deflated->read(kChunkSize);
+        if (chunk.isEmpty() || zipFile.write(chunk) != chunk.size())
+        {
+            return false;
+        }
+    }
+    zipFile.close();
+    return zipFile.getZipError() == ZIP_OK;
+}
+
+void ReportArchiver::updateProgress()
+{
+    const int progress = m_totalBytes > 0 ? static_cast<int>(m_readBytes * 100 / m_totalBytes) : 100;
+    if (progress != m_progress)
+    {
+        m_progress = progress;
+        emit progressChanged(progress);
+    }
+}
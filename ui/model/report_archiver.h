@@ -0,0 +1,89 @@
+// Copyright 2019 The Hds Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <QList>
+#include <QString>
+#include <QThread>
+
+class QuaZip;
+class QTemporaryFile;
+
+// Builds the problem report zip out of the GUI thread. Files are read in
+// chunks and deflated in parallel, each into a temporary file, which are then
+// stored in the zip as they are. The logs share a size cap: the most recent
+// ones are kept, of the oldest kept one only the tail
+class ReportArchiver : public QThread
+{
+    Q_OBJECT
+public:
+    struct Entry
+    {
+        QString filePath;
+        QString folder;     // in the zip, empty or ends with '/'
+        bool isLog = false;
+    };
+
+    // maxLogsSize is in bytes, 0 - no cap
+    ReportArchiver(const QList<Entry>& entries, const QString& zipPath, qint64 maxLogsSize, QObject* parent = nullptr);
+    ~ReportArchiver() override;
+
+    void run() override;
+
+    // valid after finished()
+    bool isSucceeded() const;
+
+signals:
+    // percent of the bytes to read
+    void progressChanged(int progress);
+
+private:
+    struct Task
+    {
+        QString filePath;
+        QString zipName;
+        qint64 offset = 0;
+        qint64 size = 0;
+        std::unique_ptr<QTemporaryFile> deflated;
+        quint32 crc = 0;
+        bool isDone = false;
+        bool isOk = false;
+    };
+
+    void prepareTasks();
+    void compressTasks();
+    void compress(Task& task);
+    bool store(QuaZip& zip, Task& task);
+    void updateProgress();
+
+    QList<Entry> m_entries;
+    QString m_zipPath;
+    qint64 m_maxLogsSize;
+    bool m_isSucceeded = false;
+
+    std::vector<Task> m_tasks;
+    std::atomic<size_t> m_nextTask{ 0 };
+    std::mutex m_mutex;
+    std::condition_variable m_taskDone;
+
+    qint64 m_totalBytes = 0;
+    std::atomic<qint64> m_readBytes{ 0 };
+    int m_progress = -1;
+};
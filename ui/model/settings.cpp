@@ -26,11 +26,9 @@
 #include "wallet/core/default_peers.h"
 
 #include "version.h"
+#include "utility/logger.h"
 #include "wallet/client/extensions/news_channels/interface.h"
 
-#include "quazip/quazip.h"
-#include "quazip/quazipfile.h"
-
 using namespace std;
 
 namespace
@@ -42,9 +40,18 @@ namespace
     const char* kIsAlowedHdsCOMLink = "hds_mw_links_allowed";
     const char* kshowSwapBetaWarning = "show_swap_beta_warning";
     const char* kRateUnit = "rateUnit";
+    const char* kSwapClientsOwnThreads = "swap/clients_own_threads";
+    const char* kNodeFailover = "node/failover";
+    const char* kWalletDBCache = "start/wallet_db_cache";
+    const char* kPeerRanking = "start/peer_ranking";
+    const char* kFileLogLevel = "log/file_level";
+    const char* kLogsSizeLimit = "log/max_size_mb";
+    const char* kReportLogsSizeLimit = "report/max_logs_size_mb";
 
     const char* kLocalNodeRun = "localnode/run";
     const char* kLocalNodePort = "localnode/port";
+    const char* kLocalNodeCpuCores = "localnode/cpu_cores";
+    const char* kLocalNodeLowPriority = "localnode/low_priority";
     const char* kLocalNodePeers = "localnode/peers";
 
     const char* kDefaultLocale = "zh_CN";
@@ -103,44 +110,120 @@ WalletSettings::WalletSettings(const QDir& appDataDir)
     : m_data{ appDataDir.filePath(SettingsFile), QSettings::IniFormat }
     , m_appDataDir{appDataDir}
 {
+    auto version = QString::fromStdString(PROJECT_VERSION);
+    if (!m_appDataDir.exists(version))
+    {
+        m_appDataDir.mkdir(version);
+    }
+
+    Lock lock(m_mutex);
+    publishSnapshot();
+}
+
+WalletSettings::~WalletSettings() = default;
+
+const WalletSettings::Snapshot& WalletSettings::getSnapshot() const
+{
+    return *m_snapshot.load(std::memory_order_acquire);
+}
+
+void WalletSettings::publishSnapshot()
+{
+    auto snapshot = std::make_unique<Snapshot>();
+
+    snapshot->nodeAddress = m_data.value(kNodeAddressName).toString();
+    snapshot->lockTimeout = m_data.value(kLockTimeoutName, 0).toInt();
+    snapshot->isPasswordReqiredToSpendMoney = m_data.value(kRequirePasswordToSpendMoney, false).toBool();
+    snapshot->isAllowedHdsCOMLinks = m_data.value(kIsAlowedHdsCOMLink, false).toBool();
+    snapshot->isSwapClientsOwnThreads = m_data.value(kSwapClientsOwnThreads, false).toBool();
+    snapshot->isNodeFailoverEnabled = m_data.value(kNodeFailover, false).toBool();
+    snapshot->localNodeCpuCores = m_data.value(kLocalNodeCpuCores, 0).toInt();
+    snapshot->isLocalNodeLowPriority = m_data.value(kLocalNodeLowPriority, false).toBool();
+    snapshot->fileLogLevel = m_data.value(kFileLogLevel, LOG_LEVEL_DEBUG).toInt();
+    snapshot->logsSizeLimit = m_data.value(kLogsSizeLimit, 500).toLongLong() * 1024 * 1024;
+    snapshot->walletDBCache = m_data.value(kWalletDBCache).toList();
+    snapshot->peerRanking = m_data.value(kPeerRanking).toList();
+    snapshot->runLocalNode = m_data.value(kLocalNodeRun, false).toBool();
+#ifdef HDS_TESTNET
+    snapshot->localNodePort = m_data.value(kLocalNodePort, 11005).toUInt();
+#else
+    snapshot->localNodePort = m_data.value(kLocalNodePort, 16668).toUInt();
+#endif // HDS_TESTNET
+
+    auto savedLocale = m_data.value(kLocaleName).toString();
+    snapshot->locale = kSupportedLangs.find(savedLocale) != kSupportedLangs.end()
+        ? savedLocale
+        : QString::fromUtf8(kDefaultLocale);
 
+    QString savedAmountUnit = m_data.value(kRateUnit, kDefaultAmountUnit).toString();
+    const auto it = find(std::begin(kSupportedAmountUnits),
+                         std::cend(kSupportedAmountUnits),
+                         savedAmountUnit);
+    snapshot->secondCurrency = it != std::cend(kSupportedAmountUnits)
+        ? savedAmountUnit
+        : QString::fromUtf8(kDefaultAmountUnit);
+
+    snapshot->isNewVersionActive = m_data.value(kNewVersionActive, true).toBool();
+    snapshot->isHdsNewsActive = m_data.value(kHdsNewsActive, true).toBool();
+    snapshot->isTxStatusActive = m_data.value(kTxStatusActive, true).toBool();
+
+    // the paths do not change, computed once
+    if (const auto* previous = m_snapshot.load(std::memory_order_relaxed))
+    {
+        snapshot->appDataPath = previous->appDataPath;
+        snapshot->walletFolder = previous->walletFolder;
+        snapshot->walletStorage = previous->walletStorage;
+#if defined(HDS_HW_WALLET)
+        snapshot->trezorWalletStorage = previous->trezorWalletStorage;
+#endif
+        snapshot->localNodeStorage = previous->localNodeStorage;
+        snapshot->tempDir = previous->tempDir;
+    }
+    else
+    {
+        snapshot->appDataPath = m_appDataDir.path().toStdString();
+        snapshot->walletFolder = m_appDataDir.filePath(QString::fromStdString(PROJECT_VERSION)).toStdString();
+        snapshot->walletStorage = snapshot->walletFolder + "/" + WalletDBFile;
+#if defined(HDS_HW_WALLET)
+        snapshot->trezorWalletStorage = snapshot->walletFolder + "/" + TrezorWalletDBFile;
+#endif
+        snapshot->localNodeStorage = m_appDataDir.filePath(NodeDBFile).toStdString();
+        snapshot->tempDir = m_appDataDir.filePath("./temp").toStdString();
+    }
+
+    m_snapshot.store(snapshot.get(), std::memory_order_release);
+    m_snapshots.push_back(std::move(snapshot));
+    if (m_snapshots.size() > kKeptSnapshots)
+    {
+        m_snapshots.pop_front();
+    }
 }
 
 #if defined(HDS_HW_WALLET)
 string WalletSettings::getTrezorWalletStorage() const
 {
-    return getWalletFolder() + "/" + TrezorWalletDBFile;
+    return getSnapshot().trezorWalletStorage;
 }
 #endif
 
 string WalletSettings::getWalletStorage() const
 {
-    return getWalletFolder() + "/" + WalletDBFile;
+    return getSnapshot().walletStorage;
 }
 
 string WalletSettings::getWalletFolder() const
 {
-    Lock lock(m_mutex);
-
-    auto version = QString::fromStdString(PROJECT_VERSION);
-    if (!m_appDataDir.exists(version))
-    {
-        m_appDataDir.mkdir(version);
-    }
-
-    return m_appDataDir.filePath(version).toStdString();
+    return getSnapshot().walletFolder;
 }
 
 string WalletSettings::getAppDataPath() const
 {
-    Lock lock(m_mutex);
-    return m_appDataDir.path().toStdString();
+    return getSnapshot().appDataPath;
 }
 
 QString WalletSettings::getNodeAddress() const
 {
-    Lock lock(m_mutex);
-    return m_data.value(kNodeAddressName).toString();
+    return getSnapshot().nodeAddress;
 }
 
 void WalletSettings::setNodeAddress(const QString& addr)
@@ -155,6 +238,7 @@ void WalletSettings::setNodeAddress(const QString& addr)
         {
             Lock lock(m_mutex);
             m_data.setValue(kNodeAddressName, addr);
+            publishSnapshot();
         }
         
         emit nodeAddressChanged();
@@ -164,8 +248,7 @@ void WalletSettings::setNodeAddress(const QString& addr)
 
 int WalletSettings::getLockTimeout() const
 {
-    Lock lock(m_mutex);
-    return m_data.value(kLockTimeoutName, 0).toInt();
+    return getSnapshot().lockTimeout;
 }
 
 void WalletSettings::setLockTimeout(int value)
@@ -175,6 +258,7 @@ void WalletSettings::setLockTimeout(int value)
         {
             Lock lock(m_mutex);
             m_data.setValue(kLockTimeoutName, value);
+            publishSnapshot();
         }
         emit lockTimeoutChanged();
     }
@@ -182,20 +266,19 @@ void WalletSettings::setLockTimeout(int value)
 
 bool WalletSettings::isPasswordReqiredToSpendMoney() const
 {
-    Lock lock(m_mutex);
-    return m_data.value(kRequirePasswordToSpendMoney, false).toBool();
+    return getSnapshot().isPasswordReqiredToSpendMoney;
 }
 
 void WalletSettings::setPasswordReqiredToSpendMoney(bool value)
 {
     Lock lock(m_mutex);
     m_data.setValue(kRequirePasswordToSpendMoney, value);
+    publishSnapshot();
 }
 
 bool WalletSettings::isAllowedHdsCOMLinks() const
 {
-    Lock lock(m_mutex);
-    return m_data.value(kIsAlowedHdsCOMLink, false).toBool();
+    return getSnapshot().isAllowedHdsCOMLinks;
 }
 
 void WalletSettings::setAllowedHdsCOMLinks(bool value)
@@ -203,6 +286,7 @@ void WalletSettings::setAllowedHdsCOMLinks(bool value)
     {
         Lock lock(m_mutex);
         m_data.setValue(kIsAlowedHdsCOMLink, value);
+        publishSnapshot();
     }
     emit hdsMWLinksChanged();
 }
@@ -219,10 +303,104 @@ void WalletSettings::setShowSwapBetaWarning(bool value)
     m_data.setValue(kshowSwapBetaWarning, value);
 }
 
-bool WalletSettings::getRunLocalNode() const
+bool WalletSettings::isSwapClientsOwnThreads() const
+{
+    return getSnapshot().isSwapClientsOwnThreads;
+}
+
+void WalletSettings::setSwapClientsOwnThreads(bool value)
+{
+    Lock lock(m_mutex);
+    m_data.setValue(kSwapClientsOwnThreads, value);
+    publishSnapshot();
+}
+
+bool WalletSettings::isNodeFailoverEnabled() const
+{
+    return getSnapshot().isNodeFailoverEnabled;
+}
+
+void WalletSettings::setNodeFailoverEnabled(bool value)
+{
+    Lock lock(m_mutex);
+    m_data.setValue(kNodeFailover, value);
+    publishSnapshot();
+}
+
+int WalletSettings::getLocalNodeCpuCores() const
+{
+    return getSnapshot().localNodeCpuCores;
+}
+
+void WalletSettings::setLocalNodeCpuCores(int cores)
+{
+    Lock lock(m_mutex);
+    m_data.setValue(kLocalNodeCpuCores, cores);
+    publishSnapshot();
+}
+
+bool WalletSettings::isLocalNodeLowPriority() const
+{
+    return getSnapshot().isLocalNodeLowPriority;
+}
+
+void WalletSettings::setLocalNodeLowPriority(bool value)
+{
+    Lock lock(m_mutex);
+    m_data.setValue(kLocalNodeLowPriority, value);
+    publishSnapshot();
+}
+
+int WalletSettings::getFileLogLevel() const
+{
+    return getSnapshot().fileLogLevel;
+}
+
+void WalletSettings::setFileLogLevel(int level)
+{
+    Lock lock(m_mutex);
+    m_data.setValue(kFileLogLevel, level);
+    publishSnapshot();
+}
+
+int WalletSettings::readFileLogLevel(const QDir& appDataDir)
+{
+    QSettings data(appDataDir.filePath(SettingsFile), QSettings::IniFormat);
+    return data.value(kFileLogLevel, LOG_LEVEL_DEBUG).toInt();
+}
+
+qint64 WalletSettings::getLogsSizeLimit() const
+{
+    return getSnapshot().logsSizeLimit;
+}
+
+QVariantList WalletSettings::getWalletDBCache() const
+{
+    return getSnapshot().walletDBCache;
+}
+
+void WalletSettings::setWalletDBCache(const QVariantList& value)
+{
+    Lock lock(m_mutex);
+    m_data.setValue(kWalletDBCache, value);
+    publishSnapshot();
+}
+
+QVariantList WalletSettings::getPeerRanking() const
+{
+    return getSnapshot().peerRanking;
+}
+
+void WalletSettings::setPeerRanking(const QVariantList& value)
 {
     Lock lock(m_mutex);
-    return m_data.value(kLocalNodeRun, false).toBool();
+    m_data.setValue(kPeerRanking, value);
+    publishSnapshot();
+}
+
+bool WalletSettings::getRunLocalNode() const
+{
+    return getSnapshot().runLocalNode;
 }
 
 void WalletSettings::setRunLocalNode(bool value)
@@ -230,18 +408,14 @@ void WalletSettings::setRunLocalNode(bool value)
     {
         Lock lock(m_mutex);
         m_data.setValue(kLocalNodeRun, value);
+        publishSnapshot();
     }
     emit localNodeRunChanged();
 }
 
 uint WalletSettings::getLocalNodePort() const
 {
-    Lock lock(m_mutex);
-#ifdef HDS_TESTNET
-    return m_data.value(kLocalNodePort, 11005).toUInt();
-#else
-    return m_data.value(kLocalNodePort, 16668).toUInt();
-#endif // HDS_TESTNET
+    return getSnapshot().localNodePort;
 }
 
 void WalletSettings::setLocalNodePort(uint port)
@@ -249,34 +423,19 @@ void WalletSettings::setLocalNodePort(uint port)
     {
         Lock lock(m_mutex);
         m_data.setValue(kLocalNodePort, port);
+        publishSnapshot();
     }
     emit localNodePortChanged();
 }
 
 string WalletSettings::getLocalNodeStorage() const
 {
-    Lock lock(m_mutex);
-    return m_appDataDir.filePath(NodeDBFile).toStdString();
+    return getSnapshot().localNodeStorage;
 }
 
 string WalletSettings::getTempDir() const
 {
-    Lock lock(m_mutex);
-    return m_appDataDir.filePath("./temp").toStdString();
-}
-
-static void zipLocalFile(QuaZip& zip, const QString& path, const QString& folder = QString())
-{
-    QFile file(path);
-    if (file.open(QIODevice::ReadOnly))
-    {
-        QuaZipFile zipFile(&zip);
-
-        zipFile.open(QIODevice::WriteOnly, QuaZipNewInfo((folder.isEmpty() ? "" : folder) + QFileInfo(file).fileName(), file.fileName()));
-        zipFile.write(file.readAll());
-        file.close();
-        zipFile.close();
-    }
+    return getSnapshot().tempDir;
 }
 
 QStringList WalletSettings::getLocalNodePeers()
@@ -315,21 +474,7 @@ void WalletSettings::setLocalNodePeers(const QStringList& qPeers)
 
 QString WalletSettings::getLocale() const
 {
-    QString savedLocale;
-    {
-        Lock lock(m_mutex);
-        savedLocale = m_data.value(kLocaleName).toString();
-    }
-
-    if (!savedLocale.isEmpty()) {
-        const auto& it = kSupportedLangs.find(savedLocale);
-        if (it != kSupportedLangs.end())
-        {
-            return savedLocale;
-        }
-    }
-
-    return QString::fromUtf8(kDefaultLocale);
+    return getSnapshot().locale;
 }
 
 QString WalletSettings::getLanguageName() const
@@ -353,26 +498,14 @@ void WalletSettings::setLocaleByLanguageName(const QString& language)
     {
         Lock lock(m_mutex);
         m_data.setValue(kLocaleName, locale);
+        publishSnapshot();
     }
     emit localeChanged();
 }
 
 QString WalletSettings::getSecondCurrency() const
 {
-    Lock lock(m_mutex);
-    QString savedAmountUnit = m_data.value(kRateUnit, kDefaultAmountUnit).toString();
-
-    const auto it = find(std::begin(kSupportedAmountUnits),
-                         std::cend(kSupportedAmountUnits),
-                         savedAmountUnit);
-    if (it == std::cend(kSupportedAmountUnits))
-    {
-        return kDefaultAmountUnit;
-    }
-    else
-    {
-        return savedAmountUnit;
-    }
+    return getSnapshot().secondCurrency;
 }
 
 void WalletSettings::setSecondCurrency(const QString& name)
@@ -388,26 +521,24 @@ void WalletSettings::setSecondCurrency(const QString& name)
     {
         Lock lock(m_mutex);
         m_data.setValue(kRateUnit, unitName);
+        publishSnapshot();
         emit secondCurrencyChanged();
     }
 }
 
 bool WalletSettings::isNewVersionActive() const
 {
-    Lock lock(m_mutex);
-    return m_data.value(kNewVersionActive, true).toBool();
+    return getSnapshot().isNewVersionActive;
 }
 
 bool WalletSettings::isHdsNewsActive() const
 {
-    Lock lock(m_mutex);
-    return m_data.value(kHdsNewsActive, true).toBool();
+    return getSnapshot().isHdsNewsActive;
 }
 
 bool WalletSettings::isTxStatusActive() const
 {
-    Lock lock(m_mutex);
-    return m_data.value(kTxStatusActive, true).toBool();
+    return getSnapshot().isTxStatusActive;
 }
 
 void WalletSettings::setNewVersionActive(bool isActive)
@@ -423,6 +554,7 @@ void WalletSettings::setNewVersionActive(bool isActive)
         }
         Lock lock(m_mutex);
         m_data.setValue(kNewVersionActive, isActive);
+        publishSnapshot();
     }
 }
 
@@ -439,6 +571,7 @@ void WalletSettings::setHdsNewsActive(bool isActive)
         }
         Lock lock(m_mutex);
         m_data.setValue(kHdsNewsActive, isActive);
+        publishSnapshot();
     }
 }
 
@@ -459,6 +592,7 @@ void WalletSettings::setTxStatusActive(bool isActive)
         }
         Lock lock(m_mutex);
         m_data.setValue(kTxStatusActive, isActive);
+        publishSnapshot();
     }
 }
 
@@ -496,35 +630,36 @@ void WalletSettings::openFolder(const QString& path)
             fileInfo.isFile() ? fileInfo.absolutePath() : path));
 }
 
-void WalletSettings::reportProblem()
+std::unique_ptr<ReportArchiver> WalletSettings::reportProblem()
 {
     auto logsFolder = QString::fromStdString(LogsFolder) + "/";
 
-    QFile zipFile = m_appDataDir.filePath("hds v" + QString::fromStdString(PROJECT_VERSION)
-        + " " + QSysInfo::productType().toLower() + " report.zip");
+    QString fileName = "hds v" + QString::fromStdString(PROJECT_VERSION)
+        + " " + QSysInfo::productType().toLower() + " report.zip";
+
+    QString path = QFileDialog::getSaveFileName(nullptr, "Save problem report",
+        QDir(QStandardPaths::writableLocation(QStandardPaths::DesktopLocation)).filePath(fileName),
+        "Archives (*.zip)");
+
+    if (path.isEmpty())
+    {
+        return {};
+    }
 
-    QuaZip zip(zipFile.fileName());
-    zip.open(QuaZip::mdCreate);
+    QList<ReportArchiver::Entry> entries;
 
     // save settings.ini
-    zipLocalFile(zip, m_appDataDir.filePath(SettingsFile));
+    entries.push_back({ m_appDataDir.filePath(SettingsFile), {}, false });
 
     // save .cfg
-    zipLocalFile(zip, QDir(QDir::currentPath()).filePath(WalletCfg));
-
-    // create 'logs' folder
-    {
-        QuaZipFile zipLogsFile(&zip);
-        zipLogsFile.open(QIODevice::WriteOnly, QuaZipNewInfo(logsFolder, logsFolder));
-        zipLogsFile.close();
-    }
+    entries.push_back({ QDir(QDir::currentPath()).filePath(WalletCfg), {}, false });
 
     {
-        QDirIterator it(m_appDataDir.filePath(LogsFolder));
+        QDirIterator it(m_appDataDir.filePath(LogsFolder), QDir::Files);
 
         while (it.hasNext())
         {
-            zipLocalFile(zip, it.next(), logsFolder);
+            entries.push_back({ it.next(), logsFolder, true });
         }
     }
 
@@ -536,31 +671,18 @@ void WalletSettings::reportProblem()
             const auto& name = it.next();
             if (QFileInfo(name).completeSuffix() == "dmp")
             {
-                zipLocalFile(zip, m_appDataDir.filePath(name));
+                entries.push_back({ m_appDataDir.filePath(name), {}, false });
             }
         }
     }
 
-    zip.close();
-
-    QString path = QFileDialog::getSaveFileName(nullptr, "Save problem report", 
-        QDir(QStandardPaths::writableLocation(QStandardPaths::DesktopLocation)).filePath(QFileInfo(zipFile).fileName()),
-        "Archives (*.zip)");
-
-    if (path.isEmpty())
+    qint64 maxLogsSize = 0;
     {
-        zipFile.remove();
+        Lock lock(m_mutex);
+        maxLogsSize = m_data.value(kReportLogsSizeLimit, 200).toLongLong() * 1024 * 1024;
     }
-    else
-    {
-        {
-            QFile file(path);
-            if(file.exists())
-                file.remove();
-        }
 
-        zipFile.rename(path);
-    }
+    return std::make_unique<ReportArchiver>(entries, path, maxLogsSize);
 }
 
 void WalletSettings::applyChanges()
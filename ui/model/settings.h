@@ -18,8 +18,13 @@
 #include <QSettings>
 #include <QDir>
 #include <QStringList>
+#include <atomic>
+#include <deque>
+#include <memory>
 #include <mutex>
+#include <vector>
 #include "model/wallet_model.h"
+#include "model/report_archiver.h"
 #include "wallet/transactions/swaps/bridges/bitcoin/settings.h"
 
 
@@ -28,6 +33,7 @@ class WalletSettings : public QObject
     Q_OBJECT
 public:
     WalletSettings(const QDir& appDataDir);
+    ~WalletSettings() override;
 
     QString getNodeAddress() const;
     void setNodeAddress(const QString& value);
@@ -44,13 +50,44 @@ public:
     bool showSwapBetaWarning();
     void setShowSwapBetaWarning(bool value);
 
+    // run swap coin clients on their own reactor threads, applied on wallet start
+    bool isSwapClientsOwnThreads() const;
+    void setSwapClientsOwnThreads(bool value);
+    // switch to a default peer when the remote node fails, see NodeFailover.
+    // Off by default, the user may have chosen the node not to trust the others
+    bool isNodeFailoverEnabled() const;
+    void setNodeFailoverEnabled(bool value);
+    // limits of the integrated node, see NodeResourceGovernor. 0 cores means all of them
+    int getLocalNodeCpuCores() const;
+    void setLocalNodeCpuCores(int cores);
+    bool isLocalNodeLowPriority() const;
+    void setLocalNodeLowPriority(bool value);
+
+    // LOG_LEVEL_* of the log files, the logger is created before the settings
+    // and reads it with readFileLogLevel, so a new value is applied to the UI
+    // messages at once (see UILog) and to the rest on the next start
+    int getFileLogLevel() const;
+    void setFileLogLevel(int level);
+    static int readFileLogLevel(const QDir& appDataDir);
+    // budget of the rotated logs in bytes, see LogMaintenance
+    qint64 getLogsSizeLimit() const;
+
+    // wallet DBs found in the app data folders by the start screen, see StartViewModel
+    QVariantList getWalletDBCache() const;
+    void setWalletDBCache(const QVariantList& value);
+
+    // default peers ordered by the measured latency, see PeerRanker
+    QVariantList getPeerRanking() const;
+    void setPeerRanking(const QVariantList& value);
+
 #if defined(HDS_HW_WALLET)
     std::string getTrezorWalletStorage() const;
 #endif
     std::string getWalletStorage() const;
     std::string getWalletFolder() const;
     std::string getAppDataPath() const;
-    void reportProblem();
+    // asks where to save the report, nothing to do if the user declined
+    std::unique_ptr<ReportArchiver> reportProblem();
 
     bool getRunLocalNode() const;
     void setRunLocalNode(bool value);
@@ -106,9 +143,53 @@ signals:
     void hdsMWLinksChanged();
     void secondCurrencyChanged();
 
+private:
+    // Typed copy of the values read by the getters without locking.
+    // Published anew by the setters, under m_mutex
+    struct Snapshot
+    {
+        QString nodeAddress;
+        int lockTimeout = 0;
+        bool isPasswordReqiredToSpendMoney = false;
+        bool isAllowedHdsCOMLinks = false;
+        bool isSwapClientsOwnThreads = false;
+        bool isNodeFailoverEnabled = false;
+        int localNodeCpuCores = 0;
+        bool isLocalNodeLowPriority = false;
+        int fileLogLevel = 0;
+        qint64 logsSizeLimit = 0;
+        QVariantList walletDBCache;
+        QVariantList peerRanking;
+        bool runLocalNode = false;
+        uint localNodePort = 0;
+        QString locale;
+        QString secondCurrency;
+        bool isNewVersionActive = true;
+        bool isHdsNewsActive = true;
+        bool isTxStatusActive = true;
+
+        std::string appDataPath;
+        std::string walletFolder;
+        std::string walletStorage;
+#if defined(HDS_HW_WALLET)
+        std::string trezorWalletStorage;
+#endif
+        std::string localNodeStorage;
+        std::string tempDir;
+    };
+
+    const Snapshot& getSnapshot() const;
+    void publishSnapshot();
+
 private:
     QSettings m_data;
     QDir m_appDataDir;
     mutable std::recursive_mutex m_mutex;
     using Lock = std::unique_lock<decltype(m_mutex)>;
+
+    std::atomic<const Snapshot*> m_snapshot{ nullptr };
+    // The last replaced snapshots are kept for the readers which loaded them
+    // just before a change, the getters copy the value out at once
+    static constexpr size_t kKeptSnapshots = 8;
+    std::deque<std::unique_ptr<const Snapshot>> m_snapshots;
 };
@@ -0,0 +1,160 @@
+// Copyright 2019 The Hds Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "startup_tracer.h"
+
+#include <algorithm>
+#include <functional>
+#include <thread>
+#include <QCoreApplication>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include "utility/logger.h"
+
+using namespace std::chrono;
+
+namespace
+{
+    const auto kProcessStart = steady_clock::now();
+
+    uint64_t currentThreadID()
+    {
+        return std::hash<std::thread::id>()(std::this_thread::get_id());
+    }
+}
+
+StartupTracer::Span::Span(const char* name)
+    : m_name(name)
+    , m_start(StartupTracer::getInstance().isEnabled() ? StartupTracer::now() : -1)
+{
+}
+
+StartupTracer::Span::~Span()
+{
+    if (m_start >= 0)
+    {
+        StartupTracer::getInstance().addSpan(m_name, m_start, StartupTracer::now() - m_start);
+    }
+}
+
+StartupTracer& StartupTracer::getInstance()
+{
+    static StartupTracer instance;
+    return instance;
+}
+
+void StartupTracer::enable(const std::string& filePath)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_filePath = filePath;
+    m_isEnabled = true;
+}
+
+bool StartupTracer::isEnabled() const
+{
+    return m_isEnabled;
+}
+
+void StartupTracer::addSpan(const char* name, int64_t start, int64_t duration)
+{
+    addEvent({ name, 'X', start, duration, currentThreadID() });
+}
+
+void StartupTracer::addInstant(const char* name)
+{
+    addEvent({ name, 'i', now(), 0, currentThreadID() });
+}
+
+void StartupTracer::addEvent(Event&& event)
+{
+    if (!m_isEnabled)
+    {
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_events.push_back(std::move(event));
+}
+
+void StartupTracer::finish()
+{
+    if (!m_isEnabled.exchange(false))
+    {
+        return;
+    }
+
+    std::vector<Event> events;
+    std::string filePath;
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        events.swap(m_events);
+        filePath = m_filePath;
+    }
+
+    // thread ids are shown as small numbers, the main thread goes first
+    std::vector<uint64_t> threads;
+    auto getThreadIndex = [&threads](uint64_t threadID)
+    {
+        auto it = std::find(threads.begin(), threads.end(), threadID);
+        if (it == threads.end())
+        {
+            threads.push_back(threadID);
+            return static_cast<int>(threads.size());
+        }
+        return static_cast<int>(std::distance(threads.begin(), it)) + 1;
+    };
+    getThreadIndex(currentThreadID());
+
+    QJsonArray traceEvents;
+    auto pid = static_cast<qint64>(QCoreApplication::applicationPid());
+    for (const auto& event : events)
+    {
+        QJsonObject traceEvent;
+        traceEvent["name"] = QString::fromStdString(event.name);
+        traceEvent["cat"] = "startup";
+        traceEvent["ph"] = QString(QChar(event.phase));
+        traceEvent["ts"] = static_cast<qint64>(event.start);
+        if (event.phase == 'X')
+        {
+            traceEvent["dur"] = static_cast<qint64>(event.duration);
+        }
+        else
+        {
+            traceEvent["s"] = "p";
+        }
+        traceEvent["pid"] = pid;
+        traceEvent["tid"] = getThreadIndex(event.threadID);
+        traceEvents.append(traceEvent);
+    }
+
+    QJsonObject trace;
+    trace["traceEvents"] = traceEvents;
+    trace["displayTimeUnit"] = "ms";
+
+    QFile file(QString::fromStdString(filePath));
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        LOG_ERROR() << "Failed to write startup trace to " << filePath;
+        return;
+    }
+    file.write(QJsonDocument(trace).toJson(QJsonDocument::Compact));
+    LOG_INFO() << "Startup trace with " << events.size() << " events is written to " << filePath;
+}
+
+int64_t StartupTracer::now()
+{
+    return duration_cast<microseconds>(steady_clock::now() - kProcessStart).count();
+}
@@ -0,0 +1,80 @@
+// Copyright 2019 The Hds Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Collects durations of the startup phases and writes them as Chrome trace events,
+// the file can be opened with chrome://tracing or Perfetto UI.
+// Does nothing unless enabled, so spans may be left in the code.
+class StartupTracer
+{
+public:
+    // RAII span, is recorded when goes out of scope
+    class Span
+    {
+    public:
+        explicit Span(const char* name);
+        ~Span();
+
+        Span(const Span&) = delete;
+        Span& operator=(const Span&) = delete;
+
+    private:
+        const char* m_name;
+        int64_t m_start;
+    };
+
+    static StartupTracer& getInstance();
+
+    void enable(const std::string& filePath);
+    bool isEnabled() const;
+
+    void addSpan(const char* name, int64_t start, int64_t duration);
+    void addInstant(const char* name);
+
+    // writes collected events and disables the tracer, subsequent calls do nothing
+    void finish();
+
+    // microseconds since the process start
+    static int64_t now();
+
+private:
+    StartupTracer() = default;
+
+    struct Event
+    {
+        std::string name;
+        char phase;
+        int64_t start;
+        int64_t duration;
+        uint64_t threadID;
+    };
+
+    void addEvent(Event&& event);
+
+    std::atomic<bool> m_isEnabled{ false };
+    std::mutex m_mutex;
+    std::string m_filePath;
+    std::vector<Event> m_events;
+};
+
+#define STARTUP_TRACE_CONCAT_IMPL(a, b) a##b
+#define STARTUP_TRACE_CONCAT(a, b) STARTUP_TRACE_CONCAT_IMPL(a, b)
+#define STARTUP_TRACE_SPAN(name) StartupTracer::Span STARTUP_TRACE_CONCAT(startupSpan, __LINE__)(name)
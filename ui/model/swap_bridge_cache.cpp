@@ -0,0 +1,417 @@
+// Copyright 2019 The Hds Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "swap_bridge_cache.h"
+
+#include <chrono>
+#include <map>
+#include <tuple>
+#include <type_traits>
+#include "utility/io/timer.h"
+#include "utility/logger.h"
+
+using namespace hds;
+using namespace hds::bitcoin;
+using namespace std::chrono;
+
+namespace
+{
+    const auto kChainStateTTL = seconds(5);
+    // swap confirmations must not lag, identical requests in flight are merged only
+    const auto kTxOutTTL = seconds(0);
+    const auto kFeeRateTTL = seconds(60);
+    const auto kGenesisBlockTTL = hours(24);
+    const unsigned kStatsLogInterval = 10 * 60 * 1000;
+
+    // Runs the callbacks of cache hits from the reactor as the bridges do,
+    // the caller must not be re-entered from its own request
+    class DeferredCalls
+    {
+    public:
+        explicit DeferredCalls(io::Reactor& reactor)
+            : m_timer(io::Timer::create(reactor))
+        {
+        }
+
+        void post(std::function<void()>&& call)
+        {
+            m_calls.push_back(std::move(call));
+            if (m_calls.size() == 1)
+            {
+                m_timer->start(0, false, [this]() { flush(); });
+            }
+        }
+
+    private:
+        void flush()
+        {
+            // calls may post again
+            auto calls = std::move(m_calls);
+            m_calls.clear();
+            for (const auto& call : calls)
+            {
+                call();
+            }
+        }
+
+        io::Timer::Ptr m_timer;
+        std::vector<std::function<void()>> m_calls;
+    };
+
+    // Responses of one bridge method keyed by the call arguments
+    template <typename... Results>
+    class CachedMethod : public std::enable_shared_from_this<CachedMethod<Results...>>
+    {
+    public:
+        using Callback = std::function<void(const IBridge::Error&, Results...)>;
+        using Request = std::function<void(Callback)>;
+
+        CachedMethod(const char* name, steady_clock::duration ttl, std::shared_ptr<DeferredCalls> deferredCalls)
+            : m_name(name)
+            , m_ttl(ttl)
+            , m_deferredCalls(std::move(deferredCalls))
+        {
+        }
+
+        void call(const std::string& key, Callback&& callback, const Request& request)
+        {
+            auto it = m_values.find(key);
+            if (it != m_values.end())
+            {
+                if (it->second.expiresAt > steady_clock::now())
+                {
+                    ++m_stats.hits;
+                    m_deferredCalls->post([callback = std::move(callback), value = it->second.value]()
+                    {
+                        std::apply([&callback](const auto&... values)
+                        {
+                            callback(IBridge::Error{ IBridge::ErrorType::None, "" }, values...);
+                        }, value);
+                    });
+                    return;
+                }
+                m_values.erase(it);
+            }
+
+            auto pendingIt = m_pending.find(key);
+            if (pendingIt != m_pending.end())
+            {
+                ++m_stats.joined;
+                pendingIt->second.push_back(std::move(callback));
+                return;
+            }
+
+            ++m_stats.requests;
+            m_pending[key].push_back(std::move(callback));
+            // the response may come after the bridge is released
+            request([self = this->shared_from_this(), key, generation = m_generation](const IBridge::Error& error, Results... results)
+            {
+                self->onResponse(key, generation, error, results...);
+            });
+        }
+
+        // values requested before this call are not cached anymore
+        void invalidate()
+        {
+            ++m_generation;
+            m_values.clear();
+        }
+
+        CachingBridge::MethodStats getStats() const
+        {
+            auto stats = m_stats;
+            stats.method = m_name;
+            return stats;
+        }
+
+    private:
+        using Value = std::tuple<std::decay_t<Results>...>;
+
+        struct Entry
+        {
+            steady_clock::time_point expiresAt;
+            Value value;
+        };
+
+        void onResponse(const std::string& key, uint64_t generation, const IBridge::Error& error, Results... results)
+        {
+            if (error.m_type == IBridge::ErrorType::None && generation == m_generation && m_ttl > steady_clock::duration::zero())
+            {
+                m_values[key] = Entry{ steady_clock::now() + m_ttl, Value(results...) };
+            }
+
+            auto it = m_pending.find(key);
+            if (it == m_pending.end())
+            {
+                return;
+            }
+
+            // callbacks may issue the same request again
+            auto callbacks = std::move(it->second);
+            m_pending.erase(it);
+            for (const auto& callback : callbacks)
+            {
+                callback(error, results...);
+            }
+        }
+
+        const char* m_name;
+        steady_clock::duration m_ttl;
+        std::shared_ptr<DeferredCalls> m_deferredCalls;
+        uint64_t m_generation = 0;
+        std::map<std::string, Entry> m_values;
+        std::map<std::string, std::vector<Callback>> m_pending;
+        CachingBridge::MethodStats m_stats;
+    };
+}  // namespace
+
+struct CachingBridge::Caches
+{
+    Caches(io::Reactor& reactor, const std::string& bridgeName)
+        : name(bridgeName)
+        , statsTimer(io::Timer::create(reactor))
+        , deferredCalls(std::make_shared<DeferredCalls>(reactor))
+        , txOut(std::make_shared<CachedMethod<const std::string&, double, uint32_t>>("getTxOut", kTxOutTTL, deferredCalls))
+        , blockCount(std::make_shared<CachedMethod<uint64_t>>("getBlockCount", kChainStateTTL, deferredCalls))
+        , balance(std::make_shared<CachedMethod<double>>("getBalance", kChainStateTTL, deferredCalls))
+        , detailedBalance(std::make_shared<CachedMethod<Amount, Amount, Amount>>("getDetailedBalance", kChainStateTTL, deferredCalls))
+        , genesisBlockHash(std::make_shared<CachedMethod<const std::string&>>("getGenesisBlockHash", kGenesisBlockTTL, deferredCalls))
+        , feeRate(std::make_shared<CachedMethod<Amount>>("estimateFee", kFeeRateTTL, deferredCalls))
+    {
+        statsTimer->start(kStatsLogInterval, true, [this]()
+        {
+            // nothing to add since the previous time
+            auto requests = getRequestCount();
+            if (requests != loggedRequests)
+            {
+                loggedRequests = requests;
+                logStats();
+            }
+        });
+    }
+
+    std::string name;
+    io::Timer::Ptr statsTimer;
+    uint64_t loggedRequests = 0;
+    std::shared_ptr<DeferredCalls> deferredCalls;
+    std::shared_ptr<CachedMethod<const std::string&, double, uint32_t>> txOut;
+    std::shared_ptr<CachedMethod<uint64_t>> blockCount;
+    std::shared_ptr<CachedMethod<double>> balance;
+    std::shared_ptr<CachedMethod<Amount, Amount, Amount>> detailedBalance;
+    std::shared_ptr<CachedMethod<const std::string&>> genesisBlockHash;
+    std::shared_ptr<CachedMethod<Amount>> feeRate;
+    uint64_t height = 0;
+
+    void onBlockCount(uint64_t blockCount)
+    {
+        if (blockCount > height)
+        {
+            height = blockCount;
+            invalidateChainState();
+        }
+    }
+
+    void invalidateChainState()
+    {
+        txOut->invalidate();
+        balance->invalidate();
+        detailedBalance->invalidate();
+        feeRate->invalidate();
+    }
+
+    std::vector<MethodStats> getStats() const
+    {
+        return {
+            txOut->getStats(),
+            blockCount->getStats(),
+            balance->getStats(),
+            detailedBalance->getStats(),
+            genesisBlockHash->getStats(),
+            feeRate->getStats()
+        };
+    }
+
+    uint64_t getRequestCount() const
+    {
+        uint64_t count = 0;
+        for (const auto& stats : getStats())
+        {
+            count += stats.hits + stats.joined + stats.requests;
+        }
+        return count;
+    }
+
+    void logStats() const
+    {
+        for (const auto& stats : getStats())
+        {
+            if (stats.hits || stats.joined || stats.requests)
+            {
+                LOG_INFO() << "Swap bridge cache " << name << " " << stats.method << ": hits " << stats.hits
+                           << ", joined " << stats.joined << ", requests " << stats.requests;
+            }
+        }
+    }
+};
+
+CachingBridge::CachingBridge(IBridge::Ptr bridge, io::Reactor& reactor, const std::string& name)
+    : m_bridge(std::move(bridge))
+    , m_caches(std::make_shared<Caches>(reactor, name))
+{
+}
+
+CachingBridge::~CachingBridge()
+{
+    m_caches->logStats();
+    // the caches may live until the last response
+    m_caches->statsTimer.reset();
+}
+
+IBridge::Ptr CachingBridge::getBridge() const
+{
+    return m_bridge;
+}
+
+std::vector<CachingBridge::MethodStats> CachingBridge::getStats() const
+{
+    return m_caches->getStats();
+}
+
+void CachingBridge::fundRawTransaction(const std::string& rawTx, Amount feeRate, std::function<void(const Error&, const std::string&, int)> callback)
+{
+    m_bridge->fundRawTransaction(rawTx, feeRate, std::move(callback));
+}
+
+void CachingBridge::signRawTransaction(const std::string& rawTx, std::function<void(const Error&, const std::string&, bool)> callback)
+{
+    m_bridge->signRawTransaction(rawTx, std::move(callback));
+}
+
+void CachingBridge::sendRawTransaction(const std::string& rawTx, std::function<void(const Error&, const std::string&)> callback)
+{
+    m_bridge->sendRawTransaction(rawTx, [caches = m_caches, callback = std::move(callback)](const Error& error, const std::string& txID)
+    {
+        // spent outputs and balance are changed
+        caches->invalidateChainState();
+        callback(error, txID);
+    });
+}
+
+void CachingBridge::getRawChangeAddress(std::function<void(const Error&, const std::string&)> callback)
+{
+    m_bridge->getRawChangeAddress(std::move(callback));
+}
+
+void CachingBridge::createRawTransaction(
+    const std::string& withdrawAddress,
+    const std::string& contractTxId,
+    Amount amount,
+    int outputIndex,
+    Timestamp locktime,
+    std::function<void(const Error&, const std::string&)> callback)
+{
+    m_bridge->createRawTransaction(withdrawAddress, contractTxId, amount, outputIndex, locktime, std::move(callback));
+}
+
+void CachingBridge::getTxOut(const std::string& txid, int outputIndex, std::function<void(const Error&, const std::string&, double, uint32_t)> callback)
+{
+    m_caches->txOut->call(txid + ":" + std::to_string(outputIndex), std::move(callback),
+        [bridge = m_bridge, txid, outputIndex](auto&& onResponse)
+        {
+            bridge->getTxOut(txid, outputIndex, std::move(onResponse));
+        });
+}
+
+void CachingBridge::getBlockCount(std::function<void(const Error&, uint64_t)> callback)
+{
+    auto onBlockCount = [caches = m_caches, callback = std::move(callback)](const Error& error, uint64_t blockCount)
+    {
+        if (error.m_type == ErrorType::None)
+        {
+            caches->onBlockCount(blockCount);
+        }
+        callback(error, blockCount);
+    };
+
+    m_caches->blockCount->call({}, std::move(onBlockCount),
+        [bridge = m_bridge](auto&& onResponse)
+        {
+            bridge->getBlockCount(std::move(onResponse));
+        });
+}
+
+void CachingBridge::getBalance(uint32_t confirmations, std::function<void(const Error&, double)> callback)
+{
+    m_caches->balance->call(std::to_string(confirmations), std::move(callback),
+        [bridge = m_bridge, confirmations](auto&& onResponse)
+        {
+            bridge->getBalance(confirmations, std::move(onResponse));
+        });
+}
+
+void CachingBridge::getDetailedBalance(std::function<void(const Error&, Amount, Amount, Amount)> callback)
+{
+    m_caches->detailedBalance->call({}, std::move(callback),
+        [bridge = m_bridge](auto&& onResponse)
+        {
+            bridge->getDetailedBalance(std::move(onResponse));
+        });
+}
+
+void CachingBridge::getGenesisBlockHash(std::function<void(const Error&, const std::string&)> callback)
+{
+    m_caches->genesisBlockHash->call({}, std::move(callback),
+        [bridge = m_bridge](auto&& onResponse)
+        {
+            bridge->getGenesisBlockHash(std::move(onResponse));
+        });
+}
+
+void CachingBridge::estimateFee(int blocks, std::function<void(const Error&, Amount)> callback)
+{
+    m_caches->feeRate->call(std::to_string(blocks), std::move(callback),
+        [bridge = m_bridge, blocks](auto&& onResponse)
+        {
+            bridge->estimateFee(blocks, std::move(onResponse));
+        });
+}
+
+CachingBridgeHolder::CachingBridgeHolder(const std::string& name, IBridgeHolder::Ptr bridgeHolder)
+    : m_name(name)
+    , m_bridgeHolder(std::move(bridgeHolder))
+{
+}
+
+IBridge::Ptr CachingBridgeHolder::Get(io::Reactor& reactor, ISettingsProvider& settingsProvider)
+{
+    auto bridge = m_bridgeHolder->Get(reactor, settingsProvider);
+    if (!bridge)
+    {
+        m_bridge.reset();
+        return bridge;
+    }
+
+    if (!m_bridge || m_bridge->getBridge() != bridge)
+    {
+        // settings are changed, responses of the previous bridge are not valid
+        m_bridge = std::make_shared<CachingBridge>(bridge, reactor, m_name);
+    }
+    return m_bridge;
+}
+
+void CachingBridgeHolder::Reset()
+{
+    m_bridgeHolder->Reset();
+    m_bridge.reset();
+}
@@ -0,0 +1,88 @@
+// Copyright 2019 The Hds Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "wallet/transactions/swaps/bridges/bitcoin/bridge.h"
+#include "wallet/transactions/swaps/bridges/bitcoin/bridge_holder.h"
+
+// Caches read-only bridge responses for a short time and merges identical
+// concurrent requests into one RPC. Cached values which depend on the chain state
+// are dropped when a new block is seen or a transaction is sent, getTxOut is not cached.
+// Cache hits are answered from the reactor, never from the calling stack.
+// Must be used from the reactor thread of the wrapped bridge only. The swap coin
+// client and the swap transactions of a coin share one instance through CachingBridgeHolder,
+// so a block seen by either of them invalidates the cache for both.
+// The statistics are logged periodically and on destruction.
+class CachingBridge : public hds::bitcoin::IBridge
+{
+public:
+    struct MethodStats
+    {
+        std::string method;
+        uint64_t hits = 0;      // served from the cache
+        uint64_t joined = 0;    // attached to the request in flight
+        uint64_t requests = 0;  // passed to the bridge
+    };
+
+    CachingBridge(hds::bitcoin::IBridge::Ptr bridge, hds::io::Reactor& reactor, const std::string& name);
+    ~CachingBridge() override;
+
+    hds::bitcoin::IBridge::Ptr getBridge() const;
+    std::vector<MethodStats> getStats() const;
+
+    void fundRawTransaction(const std::string& rawTx, hds::Amount feeRate, std::function<void(const Error&, const std::string&, int)> callback) override;
+    void signRawTransaction(const std::string& rawTx, std::function<void(const Error&, const std::string&, bool)> callback) override;
+    void sendRawTransaction(const std::string& rawTx, std::function<void(const Error&, const std::string&)> callback) override;
+    void getRawChangeAddress(std::function<void(const Error&, const std::string&)> callback) override;
+    void createRawTransaction(
+        const std::string& withdrawAddress,
+        const std::string& contractTxId,
+        hds::Amount amount,
+        int outputIndex,
+        hds::Timestamp locktime,
+        std::function<void(const Error&, const std::string&)> callback) override;
+    void getTxOut(const std::string& txid, int outputIndex, std::function<void(const Error&, const std::string&, double, uint32_t)> callback) override;
+    void getBlockCount(std::function<void(const Error&, uint64_t)> callback) override;
+    void getBalance(uint32_t confirmations, std::function<void(const Error&, double)> callback) override;
+    void getDetailedBalance(std::function<void(const Error&, hds::Amount, hds::Amount, hds::Amount)> callback) override;
+    void getGenesisBlockHash(std::function<void(const Error&, const std::string&)> callback) override;
+    void estimateFee(int blocks, std::function<void(const Error&, hds::Amount)> callback) override;
+
+private:
+    struct Caches;
+
+    hds::bitcoin::IBridge::Ptr m_bridge;
+    std::shared_ptr<Caches> m_caches;
+};
+
+// Wraps bridges of the holder into CachingBridge, the cache lives
+// as long as the wrapped bridge is not changed
+class CachingBridgeHolder : public hds::bitcoin::IBridgeHolder
+{
+public:
+    // name is used in the log
+    CachingBridgeHolder(const std::string& name, hds::bitcoin::IBridgeHolder::Ptr bridgeHolder);
+
+    hds::bitcoin::IBridge::Ptr Get(hds::io::Reactor& reactor, hds::bitcoin::ISettingsProvider& settingsProvider) override;
+    void Reset() override;
+
+private:
+    std::string m_name;
+    hds::bitcoin::IBridgeHolder::Ptr m_bridgeHolder;
+    std::shared_ptr<CachingBridge> m_bridge;
+};
@@ -14,6 +14,8 @@
 
 #include "swap_coin_client_model.h"
 
+#include <algorithm>
+
 #include "model/app_model.h"
 #include "wallet/core/common.h"
 #include "wallet/transactions/swaps/common.h"
@@ -21,35 +23,68 @@
 #include "wallet/transactions/swaps/bridges/bitcoin/settings_provider.h"
 
 using namespace hds;
+using namespace hds::wallet;
 
 namespace
 {
     const int kUpdateInterval = 10000;
+    // idle polling interval is doubled up to this value
+    const int kMaxUpdateInterval = 5 * 60 * 1000;
+    // balance request without response is considered lost
+    const qint64 kBalanceRequestTimeout = 60 * 1000;
 }
 
 SwapCoinClientModel::SwapCoinClientModel(hds::bitcoin::IBridgeHolder::Ptr bridgeHolder,
     std::unique_ptr<hds::bitcoin::SettingsProvider> settingsProvider,
-    io::Reactor& reactor)
+    io::Reactor& reactor,
+    AtomicSwapCoin swapCoin)
     : bitcoin::Client(bridgeHolder, std::move(settingsProvider), reactor)
+    , m_swapCoin(swapCoin)
     , m_timer(this)
+    , m_updateInterval(kUpdateInterval)
 {
     qRegisterMetaType<hds::bitcoin::Client::Status>("hds::bitcoin::Client::Status");
     qRegisterMetaType<hds::bitcoin::Client::Balance>("hds::bitcoin::Client::Balance");
     qRegisterMetaType<hds::bitcoin::IBridge::ErrorType>("hds::bitcoin::IBridge::ErrorType");
 
-    connect(&m_timer, SIGNAL(timeout()), this, SLOT(requestBalance()));
+    connect(&m_timer, SIGNAL(timeout()), this, SLOT(onTimer()));
 
     // connect to myself for save values in UI(main) thread
     connect(this, SIGNAL(gotBalance(const hds::bitcoin::Client::Balance&)), this, SLOT(setBalance(const hds::bitcoin::Client::Balance&)));
     connect(this, SIGNAL(gotStatus(hds::bitcoin::Client::Status)), this, SLOT(setStatus(hds::bitcoin::Client::Status)));
     connect(this, SIGNAL(gotCanModifySettings(bool)), this, SLOT(setCanModifySettings(bool)));
     connect(this, SIGNAL(gotConnectionError(hds::bitcoin::IBridge::ErrorType)), this, SLOT(setConnectionError(hds::bitcoin::IBridge::ErrorType)));
+    connect(this, SIGNAL(settingsChanged()), this, SLOT(onSettingsChanged()));
 
-    requestBalance();
+    // a client which has never been activated doesn't touch the bridge until it is used
+    if (GetSettings().IsActivated())
+    {
+        activate();
+    }
+}
+
+void SwapCoinClientModel::addActiveView()
+{
+    emit reactorRequested();
+    ++m_activeViewsCount;
+    if (!m_isStatusRequested)
+    {
+        m_isStatusRequested = true;
+        GetAsync()->GetStatus();
+    }
 
-    m_timer.start(kUpdateInterval);
+    if (m_updateInterval != kUpdateInterval)
+    {
+        // the view needs fresh data now
+        resetUpdateInterval();
+        requestBalance();
+    }
+}
 
-    GetAsync()->GetStatus();
+void SwapCoinClientModel::removeActiveView()
+{
+    assert(m_activeViewsCount > 0);
+    --m_activeViewsCount;
 }
 
 hds::Amount SwapCoinClientModel::getAvailable()
@@ -77,6 +112,11 @@ hds::bitcoin::IBridge::ErrorType SwapCoinClientModel::getConnectionError() const
     return m_connectionError;
 }
 
+uint32_t SwapCoinClientModel::getSettingsVersion() const
+{
+    return m_settingsVersion;
+}
+
 void SwapCoinClientModel::OnBalance(const bitcoin::Client::Balance& balance)
 {
     emit gotBalance(balance);
@@ -89,7 +129,8 @@ void SwapCoinClientModel::OnCanModifySettingsChanged(bool canModify)
 
 void SwapCoinClientModel::OnChangedSettings()
 {
-    requestBalance();
+    ++m_settingsVersion;
+    emit settingsChanged();
 }
 
 void SwapCoinClientModel::OnConnectionError(hds::bitcoin::IBridge::ErrorType error)
@@ -97,20 +138,132 @@ void SwapCoinClientModel::OnConnectionError(hds::bitcoin::IBridge::ErrorType err
     emit gotConnectionError(error);
 }
 
+void SwapCoinClientModel::onTransactionsChanged(ChangeAction action, const std::vector<TxDescription>& items)
+{
+    if (action == ChangeAction::Reset)
+    {
+        m_activeTxs.clear();
+    }
+
+    bool hasChanges = false;
+    for (const auto& tx : items)
+    {
+        if (tx.GetParameter<TxType>(TxParameterID::TransactionType) != TxType::AtomicSwap)
+        {
+            continue;
+        }
+
+        auto swapCoin = tx.GetParameter<AtomicSwapCoin>(TxParameterID::AtomicSwapCoin);
+        if (!swapCoin || *swapCoin != m_swapCoin)
+        {
+            continue;
+        }
+
+        if (action == ChangeAction::Removed || tx.canDelete())
+        {
+            m_activeTxs.erase(tx.m_txId);
+        }
+        else
+        {
+            m_activeTxs.insert(tx.m_txId);
+        }
+        hasChanges = true;
+    }
+
+    if (hasChanges)
+    {
+        // swap state changed, balance is expected to change too
+        resetUpdateInterval();
+        requestBalance();
+    }
+}
+
+void SwapCoinClientModel::onSettingsChanged()
+{
+    if (!GetSettings().IsActivated())
+    {
+        m_isActive = false;
+        m_isStatusRequested = false;
+        m_timer.stop();
+        return;
+    }
+
+    if (m_isActive)
+    {
+        requestBalance();
+    }
+    else
+    {
+        activate();
+    }
+}
+
+void SwapCoinClientModel::onTimer()
+{
+    requestBalance();
+
+    if (!isFastPolling() && m_updateInterval < kMaxUpdateInterval)
+    {
+        m_updateInterval = std::min(m_updateInterval * 2, kMaxUpdateInterval);
+        m_timer.setInterval(m_updateInterval);
+    }
+}
+
 void SwapCoinClientModel::requestBalance()
 {
-    if (GetSettings().IsActivated())
+    if (!GetSettings().IsActivated())
+    {
+        return;
+    }
+
+    if (m_balanceRequestTimer.isValid() && !m_balanceRequestTimer.hasExpired(kBalanceRequestTimeout))
+    {
+        // previous request is not completed yet
+        return;
+    }
+
+    // update balance
+    m_balanceRequestTimer.start();
+    GetAsync()->GetBalance();
+}
+
+void SwapCoinClientModel::activate()
+{
+    emit reactorRequested();
+    m_isActive = true;
+    m_updateInterval = kUpdateInterval;
+    m_timer.start(m_updateInterval);
+    requestBalance();
+
+    if (!m_isStatusRequested)
+    {
+        m_isStatusRequested = true;
+        GetAsync()->GetStatus();
+    }
+}
+
+bool SwapCoinClientModel::isFastPolling() const
+{
+    return m_activeViewsCount > 0 || !m_activeTxs.empty();
+}
+
+void SwapCoinClientModel::resetUpdateInterval()
+{
+    m_updateInterval = kUpdateInterval;
+    if (m_isActive)
     {
-        // update balance
-        GetAsync()->GetBalance();
+        m_timer.start(m_updateInterval);
     }
 }
 
 void SwapCoinClientModel::setBalance(const hds::bitcoin::Client::Balance& balance)
 {
+    m_balanceRequestTimer.invalidate();
+
     if (m_balance != balance)
     {
         m_balance = balance;
+        resetUpdateInterval();
         emit balanceChanged();
     }
 }
@@ -135,6 +288,12 @@ void SwapCoinClientModel::setCanModifySettings(bool canModify)
 
 void SwapCoinClientModel::setConnectionError(hds::bitcoin::IBridge::ErrorType error)
 {
+    if (error != hds::bitcoin::IBridge::ErrorType::None)
+    {
+        // balance request failed
+        m_balanceRequestTimer.invalidate();
+    }
+
     if (m_connectionError != error)
     {
         m_connectionError = error;
@@ -16,6 +16,10 @@
 
 #include <QObject>
 #include <QTimer>
+#include <QElapsedTimer>
+#include <atomic>
+#include <set>
+#include "wallet/core/common.h"
 #include "wallet/transactions/swaps/bridges/bitcoin/client.h"
 
 class SwapCoinClientModel
@@ -28,12 +32,20 @@ public:
 
     SwapCoinClientModel(hds::bitcoin::IBridgeHolder::Ptr bridgeHolder,
         std::unique_ptr<hds::bitcoin::SettingsProvider> settingsProvider,
-        hds::io::Reactor& reactor);
+        hds::io::Reactor& reactor,
+        hds::wallet::AtomicSwapCoin swapCoin);
+
+    // Balance is polled fast while there is an active view or an active swap,
+    // otherwise the polling interval grows
+    void addActiveView();
+    void removeActiveView();
 
     hds::Amount getAvailable();
     hds::bitcoin::Client::Status getStatus() const;
     bool canModifySettings() const;
     hds::bitcoin::IBridge::ErrorType getConnectionError() const;
+    // incremented on every settings change, can be read from any thread
+    uint32_t getSettingsVersion() const;
 
 signals:
     void gotStatus(hds::bitcoin::Client::Status status);
@@ -41,6 +53,11 @@ signals:
     void gotCanModifySettings(bool canModify);
     void gotConnectionError(const hds::bitcoin::IBridge::ErrorType& error);
 
+    void settingsChanged();
+    // emitted before a request is posted to the reactor, nobody is connected yet
+    // when the constructor activates the client
+    void reactorRequested();
+
     void canModifySettingsChanged();
     void balanceChanged();
     void statusChanged();
@@ -53,7 +70,12 @@ private:
     void OnChangedSettings() override;
     void OnConnectionError(hds::bitcoin::IBridge::ErrorType error) override;
 
+public slots:
+    void onTransactionsChanged(hds::wallet::ChangeAction action, const std::vector<hds::wallet::TxDescription>& items);
+
 private slots:
+    void onTimer();
+    void onSettingsChanged();
     void requestBalance();
     void setBalance(const hds::bitcoin::Client::Balance& balance);
     void setStatus(hds::bitcoin::Client::Status status);
@@ -61,7 +83,20 @@ private slots:
     void setConnectionError(hds::bitcoin::IBridge::ErrorType error);
 
 private:
+    void activate();
+    bool isFastPolling() const;
+    void resetUpdateInterval();
+
+private:
+    hds::wallet::AtomicSwapCoin m_swapCoin;
     QTimer m_timer;
+    int m_updateInterval;
+    bool m_isActive = false;            // polling runs for activated settings only
+    bool m_isStatusRequested = false;  // until the settings are deactivated
+    int m_activeViewsCount = 0;
+    std::set<hds::wallet::TxID> m_activeTxs;
+    std::atomic<uint32_t> m_settingsVersion{ 0 };
+    QElapsedTimer m_balanceRequestTimer; // valid while the balance request is in flight
     Client::Balance m_balance;
     Status m_status = Status::Unknown;
     bool m_canModifySettings = true;
@@ -0,0 +1,353 @@
+// Copyright 2019 The Hds Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "sync_benchmark.h"
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTcpSocket>
+#include <QTextStream>
+#include <QDateTime>
+#include "app_model.h"
+#include "mnemonic/mnemonic.h"
+#include "wallet/core/secstring.h"
+#include "wallet/core/wallet_db.h"
+#include "utility/logger.h"
+#include "version.h"
+
+#if defined(Q_OS_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+using namespace hds;
+
+namespace
+{
+    const char* kBenchmarkPassword = "benchmark";
+}
+
+SyncBenchmark::SyncBenchmark(AppModel& appModel, const QString& configPath)
+    : m_appModel(appModel)
+    , m_configPath(configPath)
+{
+    m_peer.setProcessChannelMode(QProcess::ForwardedChannels);
+
+    m_peerProbeTimer.setInterval(500);
+    connect(&m_peerProbeTimer, SIGNAL(timeout()), this, SLOT(onPeerProbe()));
+
+    m_walletSettleTimer.setSingleShot(true);
+    m_walletSettleTimer.setInterval(kWalletSettleTime);
+    connect(&m_walletSettleTimer, SIGNAL(timeout()), this, SLOT(onWalletSettled()));
+
+    m_timeoutTimer.setSingleShot(true);
+    connect(&m_timeoutTimer, SIGNAL(timeout()), this, SLOT(onTimeout()));
+}
+
+SyncBenchmark::~SyncBenchmark()
+{
+    if (m_peer.state() != QProcess::NotRunning)
+    {
+        m_peer.terminate();
+        if (!m_peer.waitForFinished(5000))
+        {
+            m_peer.kill();
+            m_peer.waitForFinished();
+        }
+    }
+}
+
+bool SyncBenchmark::start()
+{
+    if (!readConfig())
+    {
+        return false;
+    }
+
+    auto& settings = m_appModel.getSettings();
+    if (wallet::WalletDB::isInitialized(settings.getWalletStorage()))
+    {
+        LOG_ERROR() << "Sync benchmark needs an empty app data folder, found " << settings.getWalletStorage();
+        return false;
+    }
+
+    // only the stand-in, nothing is fetched from the network
+    io::Address peerAddr = io::Address::LOCALHOST;
+    peerAddr.port(static_cast<uint16_t>(m_peerPort));
+    settings.setRunLocalNode(true);
+    settings.setLocalNodePort(m_nodePort);
+    settings.setLocalNodePeers({ QString::fromStdString(peerAddr.str()) });
+    settings.setNewVersionActive(false);
+    settings.setHdsNewsActive(false);
+    settings.setTxStatusActive(false);
+    settings.applyChanges();
+
+    m_clock.start();
+    m_timeoutTimer.start(m_timeout * 1000);
+
+    if (!m_peerProgram.isEmpty())
+    {
+        LOG_INFO() << "Sync benchmark: starting the peer " << m_peerProgram.toStdString();
+        m_peer.start(m_peerProgram, m_peerArguments);
+        if (!m_peer.waitForStarted())
+        {
+            LOG_ERROR() << "Sync benchmark: failed to start the peer, " << m_peer.errorString().toStdString();
+            return false;
+        }
+    }
+
+    m_peerProbeTimer.start();
+    return true;
+}
+
+bool SyncBenchmark::readConfig()
+{
+    QFile file(m_configPath);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        LOG_ERROR() << "Sync benchmark: cannot read " << m_configPath.toStdString();
+        return false;
+    }
+
+    QJsonParseError error;
+    const auto config = QJsonDocument::fromJson(file.readAll(), &error).object();
+    if (error.error != QJsonParseError::NoError)
+    {
+        LOG_ERROR() << "Sync benchmark: " << m_configPath.toStdString() << ", " << error.errorString().toStdString();
+        return false;
+    }
+
+    const auto peer = config["peer"].toObject();
+    m_peerProgram = peer["program"].toString();
+    for (const auto& argument : peer["arguments"].toArray())
+    {
+        m_peerArguments << argument.toString();
+    }
+    m_peerPort = static_cast<uint>(peer["port"].toInt());
+    m_nodePort = static_cast<uint>(config["nodePort"].toInt(static_cast<int>(m_nodePort)));
+    m_seed = config["seed"].toString();
+    m_outputPath = config["output"].toString();
+    m_timeout = config["timeout"].toInt(kDefaultTimeout);
+
+    if (m_peerPort == 0 || m_peerPort > 65535 || m_nodePort == 0 || m_nodePort > 65535 || m_peerPort == m_nodePort)
+    {
+        LOG_ERROR() << "Sync benchmark: invalid peer or node port";
+        return false;
+    }
+
+    if (m_seed.split(' ', QString::SkipEmptyParts).size() != static_cast<int>(WORD_COUNT))
+    {
+        LOG_ERROR() << "Sync benchmark: the seed must have " << WORD_COUNT << " words";
+        return false;
+    }
+    return true;
+}
+
+void SyncBenchmark::onPeerProbe()
+{
+    if (!m_peerProgram.isEmpty() && m_peer.state() == QProcess::NotRunning)
+    {
+        finish(false, "the peer exited with code " + QString::number(m_peer.exitCode()));
+        return;
+    }
+
+    QTcpSocket socket;
+    socket.connectToHost(QHostAddress::LocalHost, static_cast<quint16>(m_peerPort));
+    if (socket.waitForConnected(200))
+    {
+        socket.disconnectFromHost();
+        m_peerProbeTimer.stop();
+        LOG_INFO() << "Sync benchmark: the peer is listening after " << m_clock.elapsed() << " ms";
+        startWallet();
+    }
+    else if (m_clock.elapsed() > kPeerStartTimeout)
+    {
+        finish(false, "the peer is not listening on port " + QString::number(m_peerPort));
+    }
+}
+
+void SyncBenchmark::startWallet()
+{
+    auto& node = m_appModel.getNode();
+    connect(&node, SIGNAL(syncProgressUpdated(int, int)), this, SLOT(onNodeSyncProgress(int, int)));
+    connect(&node, SIGNAL(failedToStartNode(hds::wallet::ErrorType)), this, SLOT(onNodeFailed(hds::wallet::ErrorType)));
+    connect(&node, SIGNAL(failedToSyncNode(hds::wallet::ErrorType)), this, SLOT(onNodeFailed(hds::wallet::ErrorType)));
+
+    WordList phrase;
+    for (const auto& word : m_seed.split(' ', QString::SkipEmptyParts))
+    {
+        phrase.push_back(word.toStdString());
+    }
+    auto buf = decodeMnemonic(phrase);
+    SecString seed;
+    seed.assign(buf.data(), buf.size());
+
+    m_appModel.createWallet(seed, std::string(kBenchmarkPassword), [this](bool created)
+    {
+        if (!created)
+        {
+            finish(false, "failed to create the wallet");
+            return;
+        }
+        connect(m_appModel.getWallet().get(), SIGNAL(syncProgressUpdated(int, int)), this, SLOT(onWalletSyncProgress(int, int)));
+    });
+}
+
+void SyncBenchmark::onNodeSyncProgress(int done, int total)
+{
+    if (total <= 0 || m_nodeSyncEnd >= 0)
+    {
+        return;
+    }
+
+    if (m_nodeSyncStart < 0)
+    {
+        m_nodeSyncStart = m_clock.elapsed();
+    }
+
+    if (done >= total)
+    {
+        m_nodeSyncEnd = m_clock.elapsed();
+        LOG_INFO() << "Sync benchmark: the node is synchronized in " << m_nodeSyncEnd - m_nodeSyncStart << " ms";
+        if (m_walletSynced)
+        {
+            m_walletSettleTimer.start();
+        }
+    }
+}
+
+void SyncBenchmark::onWalletSyncProgress(int done, int total)
+{
+    m_walletSynced = done >= total;
+    if (!m_walletSynced)
+    {
+        if (m_walletRescanStart < 0)
+        {
+            m_walletRescanStart = m_clock.elapsed();
+        }
+        m_walletSettleTimer.stop();
+        return;
+    }
+
+    if (m_walletRescanStart >= 0)
+    {
+        m_walletRescanEnd = m_clock.elapsed();
+    }
+
+    if (m_nodeSyncEnd >= 0)
+    {
+        m_walletSettleTimer.start();
+    }
+}
+
+void SyncBenchmark::onWalletSettled()
+{
+    finish(true);
+}
+
+void SyncBenchmark::onNodeFailed(hds::wallet::ErrorType errorType)
+{
+    finish(false, "the node failed, error " + QString::number(static_cast<int>(errorType)));
+}
+
+void SyncBenchmark::onTimeout()
+{
+    finish(false, "timed out after " + QString::number(m_timeout) + " s");
+}
+
+void SyncBenchmark::finish(bool succeeded, const QString& error)
+{
+    if (m_finished)
+    {
+        return;
+    }
+    m_finished = true;
+    m_peerProbeTimer.stop();
+    m_walletSettleTimer.stop();
+    m_timeoutTimer.stop();
+
+    const qint64 nodeSyncTime = m_nodeSyncEnd >= 0 ? m_nodeSyncEnd - m_nodeSyncStart : -1;
+    // the node DB is empty at the start, so the tip is the number of synced blocks
+    const auto wallet = m_appModel.getWallet();
+    const qint64 blocks = wallet && m_nodeSyncEnd >= 0 ? static_cast<qint64>(wallet->getCurrentHeight()) : 0;
+
+    QJsonObject result;
+    result["version"] = QString::fromStdString(PROJECT_VERSION);
+    result["timestamp"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+    result["succeeded"] = succeeded;
+    if (!error.isEmpty())
+    {
+        result["error"] = error;
+    }
+    result["blocks"] = blocks;
+    result["nodeSyncMs"] = nodeSyncTime;
+    result["blocksPerSecond"] = nodeSyncTime > 0 ? blocks * 1000. / nodeSyncTime : 0.;
+    result["walletRescanMs"] = m_walletRescanEnd >= 0 ? m_walletRescanEnd - m_walletRescanStart : -1;
+    result["peakRssBytes"] = getPeakRss();
+
+    const auto json = QJsonDocument(result).toJson();
+    if (m_outputPath.isEmpty())
+    {
+        QTextStream(stdout) << json;
+    }
+    else
+    {
+        QFile file(m_outputPath);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate) || file.write(json) != json.size())
+        {
+            LOG_ERROR() << "Sync benchmark: cannot write " << m_outputPath.toStdString();
+            succeeded = false;
+        }
+    }
+
+    if (succeeded)
+    {
+        LOG_INFO() << "Sync benchmark: " << blocks << " blocks in " << nodeSyncTime << " ms";
+    }
+    else
+    {
+        LOG_ERROR() << "Sync benchmark failed: " << error.toStdString();
+    }
+    QCoreApplication::exit(succeeded ? 0 : 1);
+}
+
+qint64 SyncBenchmark::getPeakRss()
+{
+#if defined(Q_OS_WIN32)
+    PROCESS_MEMORY_COUNTERS counters = {};
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+    {
+        return static_cast<qint64>(counters.PeakWorkingSetSize);
+    }
+    return -1;
+#else
+    rusage usage = {};
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+    {
+        return -1;
+    }
+#if defined(Q_OS_MAC)
+    return static_cast<qint64>(usage.ru_maxrss);
+#else
+    // kilobytes on Linux
+    return static_cast<qint64>(usage.ru_maxrss) * 1024;
+#endif
+#endif
+}
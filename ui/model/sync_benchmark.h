@@ -0,0 +1,95 @@
+// Copyright 2019 The Hds Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QProcess>
+#include <QTimer>
+#include <QString>
+#include "wallet/core/common.h"
+
+class AppModel;
+
+// Headless sync benchmark, run by hds-sync-bench, see bench/make_sync_fixture.sh
+// for the recorded chain and the peer stand-in.
+// Starts a local peer stand-in serving a recorded chain segment, creates a wallet with
+// the integrated node connected only to that peer and measures the node sync rate,
+// the wallet UTXO rescan time and the peak RSS. The result is written as JSON.
+// The rescan is measured from the first wallet progress with work left to the last
+// time the wallet caught up, -1 if the wallet reported no work.
+//
+// Config:
+//   "peer":     { "program": "...", "arguments": [...], "port": 10100 } - the stand-in,
+//               without "program" a peer already listening on the port is used
+//   "seed":     the 12 words of the recorded wallet
+//   "nodePort": port of the integrated node, 10105 by default
+//   "timeout":  seconds, 3600 by default
+//   "output":   path of the result, stdout if omitted
+// The app data folder (--appdata) must not contain a wallet.
+class SyncBenchmark : public QObject
+{
+    Q_OBJECT
+public:
+    static constexpr int kDefaultTimeout = 3600;            // s
+    static constexpr int kPeerStartTimeout = 60 * 1000;     // ms
+    static constexpr int kWalletSettleTime = 3000;          // ms without wallet progress after the node sync
+
+    SyncBenchmark(AppModel& appModel, const QString& configPath);
+    ~SyncBenchmark() override;
+
+    // false if the benchmark could not be started, the application exits
+    // with the result code otherwise, see QCoreApplication::exit
+    bool start();
+
+private slots:
+    void onPeerProbe();
+    void onNodeSyncProgress(int done, int total);
+    void onWalletSyncProgress(int done, int total);
+    void onNodeFailed(hds::wallet::ErrorType errorType);
+    void onWalletSettled();
+    void onTimeout();
+
+private:
+    bool readConfig();
+    void startWallet();
+    void finish(bool succeeded, const QString& error = QString());
+    static qint64 getPeakRss();
+
+    AppModel& m_appModel;
+    QString m_configPath;
+
+    QString m_peerProgram;
+    QStringList m_peerArguments;
+    uint m_peerPort = 0;
+    uint m_nodePort = 10105;
+    QString m_seed;
+    QString m_outputPath;
+    int m_timeout = kDefaultTimeout;
+
+    QProcess m_peer;
+    QTimer m_peerProbeTimer;
+    QTimer m_walletSettleTimer;
+    QTimer m_timeoutTimer;
+    QElapsedTimer m_clock;
+
+    qint64 m_nodeSyncStart = -1;    // ms since m_clock start
+    qint64 m_nodeSyncEnd = -1;
+    qint64 m_walletRescanStart = -1;
+    qint64 m_walletRescanEnd = -1;
+    bool m_walletSynced = true;
+    bool m_finished = false;
+};
@@ -0,0 +1,157 @@
+// Copyright 2019 The Hds Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sync_telemetry.h"
+
+#include <QDateTime>
+#include <QDir>
+#include "ui_log.h"
+
+namespace
+{
+    const char* kTelemetryFolder = "telemetry";
+    const char* kSessionPrefix = "sync_";
+    const char* kSessionTimeFormat = "yyyyMMdd_HHmmss";
+
+    const char* toString(SyncTelemetry::Phase phase)
+    {
+        switch (phase)
+        {
+        case SyncTelemetry::Phase::RebuildUTXO: return "rebuild_utxo";
+        case SyncTelemetry::Phase::BlockDownload: return "block_download";
+        case SyncTelemetry::Phase::WalletScan: return "wallet_scan";
+        default: return "none";
+        }
+    }
+}  // namespace
+
+SyncTelemetry::SyncTelemetry(const QString& appDataPath)
+{
+    QDir dir(appDataPath);
+    if (!dir.mkpath(kTelemetryFolder) || !dir.cd(kTelemetryFolder))
+    {
+        UI_LOG_WARNING() << "Failed to create the telemetry folder in " << appDataPath.toStdString();
+        return;
+    }
+    pruneSessions(dir.path());
+
+    auto name = kSessionPrefix + QDateTime::currentDateTime().toString(kSessionTimeFormat) + ".csv";
+    m_file.setFileName(dir.filePath(name));
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Text))
+    {
+        UI_LOG_WARNING() << "Failed to open " << m_file.fileName().toStdString();
+        return;
+    }
+
+    m_stream.setDevice(&m_file);
+    m_stream << "time_ms,event,phase,done,total,rate\n";
+    m_clock.start();
+}
+
+SyncTelemetry::~SyncTelemetry()
+{
+    if (m_file.isOpen())
+    {
+        for (auto phase : { Phase::RebuildUTXO, Phase::BlockDownload, Phase::WalletScan })
+        {
+            if (!m_phases[static_cast<size_t>(phase)].isStarted)
+            {
+                continue;
+            }
+            auto summary = getSummary(phase);
+            UI_LOG_INFO() << "Sync " << toString(phase) << " rate p50: " << summary.rateP50 << "/s, p95: " << summary.rateP95 << "/s"
+                          << ", stalls: " << summary.stalls << " (" << summary.stalledMs << " ms)";
+        }
+        m_stream.flush();
+    }
+}
+
+void SyncTelemetry::addSample(Phase phase, quint64 done, quint64 total)
+{
+    if (!m_clock.isValid())
+    {
+        return;
+    }
+
+    auto& state = m_phases[static_cast<size_t>(phase)];
+    if (!state.isStarted)
+    {
+        startPhase(phase);
+    }
+
+    auto now = m_clock.elapsed();
+    double rate = 0.;
+    if (done > state.lastDone)
+    {
+        auto progressGap = now - state.lastProgressTime;
+        if (state.lastProgressTime > 0 && progressGap > kStallThreshold)
+        {
+            ++state.stalls;
+            state.stalledMs += progressGap;
+            // the rate column holds the stall duration in ms
+            write("stall", phase, done, total, static_cast<double>(progressGap));
+        }
+
+        if (now > state.lastTime)
+        {
+            rate = (done - state.lastDone) * 1000. / (now - state.lastTime);
+            state.p50.addSample(rate);
+            state.p95.addSample(rate);
+        }
+        state.lastProgressTime = now;
+    }
+
+    write("sample", phase, done, total, rate);
+    state.lastDone = done;
+    state.lastTime = now;
+}
+
+SyncTelemetry::Summary SyncTelemetry::getSummary(Phase phase) const
+{
+    const auto& state = m_phases[static_cast<size_t>(phase)];
+    Summary summary;
+    summary.phase = phase;
+    summary.rateP50 = state.p50.getValue();
+    summary.rateP95 = state.p95.getValue();
+    summary.stalls = state.stalls;
+    summary.stalledMs = state.stalledMs;
+    return summary;
+}
+
+void SyncTelemetry::startPhase(Phase phase)
+{
+    auto& state = m_phases[static_cast<size_t>(phase)];
+    state.isStarted = true;
+    state.lastTime = m_clock.elapsed();
+    state.lastProgressTime = state.lastTime;
+    write("phase", phase, 0, 0, 0.);
+    m_stream.flush();
+}
+
+void SyncTelemetry::write(const char* event, Phase phase, quint64 done, quint64 total, double rate)
+{
+    m_stream << m_clock.elapsed() << ',' << event << ',' << toString(phase) << ','
+             << done << ',' << total << ',' << rate << '\n';
+}
+
+void SyncTelemetry::pruneSessions(const QString& folder)
+{
+    QDir dir(folder);
+    auto sessions = dir.entryInfoList({ QString(kSessionPrefix) + "*.csv" }, QDir::Files, QDir::Name | QDir::Reversed);
+    // one place is for the new session
+    for (int i = kMaxSessions - 1; i < sessions.size(); ++i)
+    {
+        QFile::remove(sessions[i].filePath());
+    }
+}
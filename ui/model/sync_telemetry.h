@@ -0,0 +1,79 @@
+// Copyright 2019 The Hds Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <QFile>
+#include <QTextStream>
+#include <QElapsedTimer>
+#include <QString>
+#include <array>
+#include "viewmodel/ui_helpers.h"
+
+// Records the sync progress of a session to <app data>/telemetry/sync_<time>.csv:
+// timestamped done/total samples, phase starts and the derived rates.
+// The summary (rate percentiles and stalls) is computed from the same samples.
+// The phases may run at once, the node downloads blocks while the wallet scans
+// them, so each keeps its own progress, rates and stalls.
+class SyncTelemetry
+{
+public:
+    enum class Phase
+    {
+        None,
+        RebuildUTXO,
+        BlockDownload,
+        WalletScan
+    };
+
+    struct Summary
+    {
+        Phase phase = Phase::None;
+        double rateP50 = 0.;    // per second
+        double rateP95 = 0.;
+        int stalls = 0;
+        qint64 stalledMs = 0;
+    };
+
+    static constexpr int kMaxSessions = 10;
+    static constexpr qint64 kStallThreshold = 20 * 1000;    // ms
+
+    explicit SyncTelemetry(const QString& appDataPath);
+    ~SyncTelemetry();
+
+    void addSample(Phase phase, quint64 done, quint64 total);
+    Summary getSummary(Phase phase) const;
+
+private:
+    struct PhaseState
+    {
+        bool isStarted = false;
+        quint64 lastDone = 0;
+        qint64 lastTime = 0;
+        qint64 lastProgressTime = 0;
+        hdsui::StreamingQuantile p50{0.5};
+        hdsui::StreamingQuantile p95{0.95};
+        int stalls = 0;
+        qint64 stalledMs = 0;
+    };
+
+    void startPhase(Phase phase);
+    void write(const char* event, Phase phase, quint64 done, quint64 total, double rate);
+    void pruneSessions(const QString& folder);
+
+    QFile m_file;
+    QTextStream m_stream;
+    QElapsedTimer m_clock;
+    std::array<PhaseState, static_cast<size_t>(Phase::WalletScan) + 1> m_phases;
+};
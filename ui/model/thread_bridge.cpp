@@ -0,0 +1,153 @@
+// Copyright 2019 The Hds Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "thread_bridge.h"
+
+#include <tuple>
+#include <type_traits>
+
+using namespace hds;
+using namespace hds::bitcoin;
+
+ThreadBridge::ThreadBridge(ReactorThread::Ptr bridgeThread, ReactorQueue::Ptr callerQueue, BridgeGetter getBridge)
+    : m_bridgeThread(std::move(bridgeThread))
+    , m_callerQueue(std::move(callerQueue))
+    , m_getBridge(std::move(getBridge))
+{
+}
+
+template <typename... Results, typename Request>
+void ThreadBridge::call(std::function<void(const Error&, Results...)>&& callback, Request&& request)
+{
+    // runs on the coin thread
+    auto onBridgeThread = [getBridge = m_getBridge, callerQueue = m_callerQueue, callback = std::move(callback), request = std::forward<Request>(request)]()
+    {
+        auto onResponse = [callerQueue, callback](const Error& error, Results... results)
+        {
+            // the results are copied, references are not valid after return
+            callerQueue->post([callback, error, values = std::tuple<std::decay_t<Results>...>(results...)]()
+            {
+                std::apply([&callback, &error](const auto&... values)
+                {
+                    callback(error, values...);
+                }, values);
+            });
+        };
+
+        auto bridge = getBridge();
+        if (!bridge)
+        {
+            // the settings are reset after the call is posted
+            onResponse(Error{ ErrorType::IOError, "swap coin bridge is not available" }, std::decay_t<Results>{}...);
+            return;
+        }
+        request(*bridge, std::move(onResponse));
+    };
+    m_bridgeThread->post(std::move(onBridgeThread));
+}
+
+void ThreadBridge::fundRawTransaction(const std::string& rawTx, Amount feeRate, std::function<void(const Error&, const std::string&, int)> callback)
+{
+    call(std::move(callback), [rawTx, feeRate](IBridge& bridge, auto&& onResponse)
+    {
+        bridge.fundRawTransaction(rawTx, feeRate, std::move(onResponse));
+    });
+}
+
+void ThreadBridge::signRawTransaction(const std::string& rawTx, std::function<void(const Error&, const std::string&, bool)> callback)
+{
+    call(std::move(callback), [rawTx](IBridge& bridge, auto&& onResponse)
+    {
+        bridge.signRawTransaction(rawTx, std::move(onResponse));
+    });
+}
+
+void ThreadBridge::sendRawTransaction(const std::string& rawTx, std::function<void(const Error&, const std::string&)> callback)
+{
+    call(std::move(callback), [rawTx](IBridge& bridge, auto&& onResponse)
+    {
+        bridge.sendRawTransaction(rawTx, std::move(onResponse));
+    });
+}
+
+void ThreadBridge::getRawChangeAddress(std::function<void(const Error&, const std::string&)> callback)
+{
+    call(std::move(callback), [](IBridge& bridge, auto&& onResponse)
+    {
+        bridge.getRawChangeAddress(std::move(onResponse));
+    });
+}
+
+void ThreadBridge::createRawTransaction(
+    const std::string& withdrawAddress,
+    const std::string& contractTxId,
+    Amount amount,
+    int outputIndex,
+    Timestamp locktime,
+    std::function<void(const Error&, const std::string&)> callback)
+{
+    call(std::move(callback), [withdrawAddress, contractTxId, amount, outputIndex, locktime](IBridge& bridge, auto&& onResponse)
+    {
+        bridge.createRawTransaction(withdrawAddress, contractTxId, amount, outputIndex, locktime, std::move(onResponse));
+    });
+}
+
+void ThreadBridge::getTxOut(const std::string& txid, int outputIndex, std::function<void(const Error&, const std::string&, double, uint32_t)> callback)
+{
+    call(std::move(callback), [txid, outputIndex](IBridge& bridge, auto&& onResponse)
+    {
+        bridge.getTxOut(txid, outputIndex, std::move(onResponse));
+    });
+}
+
+void ThreadBridge::getBlockCount(std::function<void(const Error&, uint64_t)> callback)
+{
+    call(std::move(callback), [](IBridge& bridge, auto&& onResponse)
+    {
+        bridge.getBlockCount(std::move(onResponse));
+    });
+}
+
+void ThreadBridge::getBalance(uint32_t confirmations, std::function<void(const Error&, double)> callback)
+{
+    call(std::move(callback), [confirmations](IBridge& bridge, auto&& onResponse)
+    {
+        bridge.getBalance(confirmations, std::move(onResponse));
+    });
+}
+
+void ThreadBridge::getDetailedBalance(std::function<void(const Error&, Amount, Amount, Amount)> callback)
+{
+    call(std::move(callback), [](IBridge& bridge, auto&& onResponse)
+    {
+        bridge.getDetailedBalance(std::move(onResponse));
+    });
+}
+
+void ThreadBridge::getGenesisBlockHash(std::function<void(const Error&, const std::string&)> callback)
+{
+    call(std::move(callback), [](IBridge& bridge, auto&& onResponse)
+    {
+        bridge.getGenesisBlockHash(std::move(onResponse));
+    });
+}
+
+void ThreadBridge::estimateFee(int blocks, std::function<void(const Error&, Amount)> callback)
+{
+    call(std::move(callback), [blocks](IBridge& bridge, auto&& onResponse)
+    {
+        bridge.estimateFee(blocks, std::move(onResponse));
+    });
+}
@@ -0,0 +1,59 @@
+// Copyright 2019 The Hds Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include <functional>
+#include "reactor_thread.h"
+#include "wallet/transactions/swaps/bridges/bitcoin/bridge.h"
+
+// Bridge of a swap coin running on the coin reactor thread, used from another reactor.
+// Every call is posted to the coin thread, where the real bridge is taken from
+// getBridge, and its callback is posted back to the caller queue, so the caller
+// (e.g. AtomicSwapTransaction on the wallet reactor) never blocks on the coin RPC
+// and is never re-entered from the coin thread
+class ThreadBridge : public hds::bitcoin::IBridge
+{
+public:
+    using BridgeGetter = std::function<hds::bitcoin::IBridge::Ptr()>;
+
+    ThreadBridge(ReactorThread::Ptr bridgeThread, ReactorQueue::Ptr callerQueue, BridgeGetter getBridge);
+
+    void fundRawTransaction(const std::string& rawTx, hds::Amount feeRate, std::function<void(const Error&, const std::string&, int)> callback) override;
+    void signRawTransaction(const std::string& rawTx, std::function<void(const Error&, const std::string&, bool)> callback) override;
+    void sendRawTransaction(const std::string& rawTx, std::function<void(const Error&, const std::string&)> callback) override;
+    void getRawChangeAddress(std::function<void(const Error&, const std::string&)> callback) override;
+    void createRawTransaction(
+        const std::string& withdrawAddress,
+        const std::string& contractTxId,
+        hds::Amount amount,
+        int outputIndex,
+        hds::Timestamp locktime,
+        std::function<void(const Error&, const std::string&)> callback) override;
+    void getTxOut(const std::string& txid, int outputIndex, std::function<void(const Error&, const std::string&, double, uint32_t)> callback) override;
+    void getBlockCount(std::function<void(const Error&, uint64_t)> callback) override;
+    void getBalance(uint32_t confirmations, std::function<void(const Error&, double)> callback) override;
+    void getDetailedBalance(std::function<void(const Error&, hds::Amount, hds::Amount, hds::Amount)> callback) override;
+    void getGenesisBlockHash(std::function<void(const Error&, const std::string&)> callback) override;
+    void estimateFee(int blocks, std::function<void(const Error&, hds::Amount)> callback) override;
+
+private:
+    template <typename... Results, typename Request>
+    void call(std::function<void(const Error&, Results...)>&& callback, Request&& request);
+
+    ReactorThread::Ptr m_bridgeThread;
+    ReactorQueue::Ptr m_callerQueue;
+    BridgeGetter m_getBridge;
+};
@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 #include "translator.h"
+#include "ui_log.h"
 #include <QApplication>
 
 namespace
@@ -41,7 +42,7 @@ void Translator::loadTranslation()
         return;
     }
 
-    LOG_WARNING() << "Can't load translation from " << kDefaultTranslationsPath;
+    UI_LOG_WARNING() << "Can't load translation from " << kDefaultTranslationsPath;
 }
 
 void Translator::onLocaleChanged()
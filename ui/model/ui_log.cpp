@@ -0,0 +1,235 @@
+// Copyright 2019 The Hds Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "ui_log.h"
+
+#include <algorithm>
+
+namespace
+{
+    // the writer is far behind if that many are waiting, a power of two
+    const size_t kRingSize = 4096;
+    const size_t kRingMask = kRingSize - 1;
+}
+
+UILog::Message::Message(int level)
+    : m_level(level)
+{
+}
+
+UILog::Message::~Message()
+{
+    UILog::getInstance().push(m_level, m_stream.str());
+}
+
+UILog::Scope::Scope(int consoleLevel, int fileLevel)
+{
+    UILog::getInstance().start(consoleLevel, fileLevel);
+}
+
+UILog::Scope::~Scope()
+{
+    UILog::getInstance().stop();
+}
+
+UILog& UILog::getInstance()
+{
+    static UILog instance;
+    return instance;
+}
+
+UILog::UILog()
+    : m_cells(new Cell[kRingSize])
+{
+    for (size_t i = 0; i < kRingSize; ++i)
+    {
+        m_cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+void UILog::start(int consoleLevel, int fileLevel)
+{
+    m_consoleLevel = consoleLevel;
+    m_fileLevel = fileLevel;
+    m_loggerFileLevel = fileLevel;
+    m_isStopping = false;
+    m_thread = std::thread(&UILog::run, this);
+    m_isRunning = true;
+}
+
+void UILog::stop()
+{
+    if (!m_isRunning.exchange(false))
+    {
+        return;
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_isStopping = true;
+    }
+    m_condition.notify_one();
+    m_thread.join();
+}
+
+void UILog::setFileLevel(int level)
+{
+    m_fileLevel = level;
+}
+
+int UILog::getLoggerFileLevel() const
+{
+    return m_loggerFileLevel;
+}
+
+bool UILog::willLog(int level)
+{
+    if (level > m_consoleLevel && level > std::min(m_fileLevel.load(), m_loggerFileLevel.load()))
+    {
+        return false;
+    }
+
+    // do not format what would not fit
+    if (m_isRunning && m_pushPosition.load(std::memory_order_relaxed) - m_popPosition.load(std::memory_order_relaxed) >= kRingSize)
+    {
+        ++m_droppedCount;
+        return false;
+    }
+    return true;
+}
+
+uint64_t UILog::getDroppedCount() const
+{
+    return m_droppedCount;
+}
+
+void UILog::push(int level, std::string&& text)
+{
+    if (!m_isRunning)
+    {
+        write({ level, std::move(text) });
+        return;
+    }
+
+    auto position = m_pushPosition.load(std::memory_order_relaxed);
+    Cell* cell = nullptr;
+    for (;;)
+    {
+        cell = &m_cells[position & kRingMask];
+        auto sequence = cell->sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+        if (diff == 0)
+        {
+            if (m_pushPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            // the writer has not freed the cell yet
+            ++m_droppedCount;
+            return;
+        }
+        else
+        {
+            position = m_pushPosition.load(std::memory_order_relaxed);
+        }
+    }
+
+    cell->entry.level = level;
+    cell->entry.text = std::move(text);
+    cell->sequence.store(position + 1, std::memory_order_seq_cst);
+
+    // both are sequentially consistent with the writer going to sleep in run(),
+    // either it sees the cell or it is already waiting for the notification
+    if (m_isWriterWaiting.load(std::memory_order_seq_cst))
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_condition.notify_one();
+    }
+}
+
+bool UILog::pop(Entry& entry)
+{
+    auto position = m_popPosition.load(std::memory_order_relaxed);
+    auto& cell = m_cells[position & kRingMask];
+    if (cell.sequence.load(std::memory_order_acquire) != position + 1)
+    {
+        return false;
+    }
+
+    entry = std::move(cell.entry);
+    cell.sequence.store(position + kRingSize, std::memory_order_release);
+    m_popPosition.store(position + 1, std::memory_order_relaxed);
+    return true;
+}
+
+void UILog::run()
+{
+    Entry entry;
+    uint64_t reportedDropped = 0;
+    for (;;)
+    {
+        bool isStopping = m_isStopping;
+        while (pop(entry))
+        {
+            write(entry);
+        }
+
+        auto dropped = m_droppedCount.load();
+        if (dropped != reportedDropped)
+        {
+            LOG_WARNING() << "UI log: " << dropped - reportedDropped << " messages dropped, " << dropped << " in total";
+            reportedDropped = dropped;
+        }
+
+        if (isStopping)
+        {
+            break;
+        }
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_isWriterWaiting = true;
+        m_condition.wait(lock, [this]()
+        {
+            auto position = m_popPosition.load(std::memory_order_relaxed);
+            return m_isStopping || m_cells[position & kRingMask].sequence.load(std::memory_order_seq_cst) == position + 1;
+        });
+        m_isWriterWaiting = false;
+    }
+}
+void UILog::write(const Entry& entry)
+{
+    switch (entry.level)
+    {
+    case LOG_LEVEL_CRITICAL:
+    case LOG_LEVEL_ERROR:
+        LOG_ERROR() << entry.text;
+        break;
+    case LOG_LEVEL_WARNING:
+        LOG_WARNING() << entry.text;
+        break;
+    case LOG_LEVEL_INFO:
+        LOG_INFO() << entry.text;
+        break;
+    case LOG_LEVEL_DEBUG:
+        LOG_DEBUG() << entry.text;
+        break;
+    default:
+        LOG_VERBOSE() << entry.text;
+        break;
+    }
+}
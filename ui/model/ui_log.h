@@ -0,0 +1,125 @@
+// Copyright 2019 The Hds Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include "utility/logger.h"
+
+// Bounded ring of the UI log messages, they are written to hds::Logger by its own thread,
+// so the GUI thread does not wait for the file. Any thread may log, the writer is the only
+// reader. The console level is fixed at start, the file level can be changed at runtime
+// up to the file level of hds::Logger, more detailed messages need a restart.
+// When the ring is full new messages are counted as dropped before they are formatted.
+class UILog
+{
+public:
+    // collects the message and queues it when goes out of scope
+    class Message
+    {
+    public:
+        explicit Message(int level);
+        ~Message();
+
+        template<typename T>
+        Message& operator<<(const T& value)
+        {
+            m_stream << value;
+            return *this;
+        }
+
+    private:
+        int m_level;
+        std::ostringstream m_stream;
+    };
+
+    // starts the queue and writes it out when goes out of scope,
+    // has to be destroyed before hds::Logger
+    class Scope
+    {
+    public:
+        Scope(int consoleLevel, int fileLevel);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+    static UILog& getInstance();
+
+    // the levels are the ones hds::Logger was created with,
+    // messages logged before start() or after stop() go to hds::Logger directly
+    void start(int consoleLevel, int fileLevel);
+    void stop();
+
+    void setFileLevel(int level);
+    // the file level hds::Logger was created with, a higher one is applied after restart
+    int getLoggerFileLevel() const;
+    bool willLog(int level);
+
+    uint64_t getDroppedCount() const;
+
+private:
+    UILog();
+
+    struct Entry
+    {
+        int level = LOG_LEVEL_VERBOSE;
+        std::string text;
+    };
+
+    struct Cell
+    {
+        std::atomic<size_t> sequence{ 0 };
+        Entry entry;
+    };
+
+    void push(int level, std::string&& text);
+    bool pop(Entry& entry);
+    void run();
+    static void write(const Entry& entry);
+
+    std::atomic<int> m_consoleLevel{ LOG_LEVEL_VERBOSE };
+    std::atomic<int> m_fileLevel{ LOG_LEVEL_VERBOSE };
+    std::atomic<int> m_loggerFileLevel{ LOG_LEVEL_VERBOSE };
+    std::atomic<bool> m_isRunning{ false };
+    std::atomic<bool> m_isStopping{ false };
+    std::atomic<bool> m_isWriterWaiting{ false };
+    std::atomic<uint64_t> m_droppedCount{ 0 };
+
+    // the cell is free for the writer at position p when its sequence is p,
+    // filled when p + 1, see push() and pop()
+    std::unique_ptr<Cell[]> m_cells;
+    std::atomic<size_t> m_pushPosition{ 0 };
+    std::atomic<size_t> m_popPosition{ 0 };
+
+    // the writer sleeps here when the ring is empty
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::thread m_thread;
+};
+
+#define UI_LOG(level) if (UILog::getInstance().willLog(level)) UILog::Message(level)
+#define UI_LOG_ERROR() UI_LOG(LOG_LEVEL_ERROR)
+#define UI_LOG_WARNING() UI_LOG(LOG_LEVEL_WARNING)
+#define UI_LOG_INFO() UI_LOG(LOG_LEVEL_INFO)
+#define UI_LOG_DEBUG() UI_LOG(LOG_LEVEL_DEBUG)
+#define UI_LOG_VERBOSE() UI_LOG(LOG_LEVEL_VERBOSE)
@@ -0,0 +1,144 @@
+// Copyright 2019 The Hds Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "wallet_db_loader.h"
+
+#include <QElapsedTimer>
+#include "ui_log.h"
+#include "utility/io/reactor.h"
+
+using namespace hds;
+using namespace hds::wallet;
+
+WalletDBLoader::WalletDBLoader(const std::string& dbFilePath, const SecString& pass, QObject* parent)
+    : QThread(parent)
+    , m_dbFilePath(dbFilePath)
+    , m_pass(pass)
+    , m_isCreating(false)
+{
+}
+
+WalletDBLoader::WalletDBLoader(const std::string& dbFilePath, const SecString& seed, const SecString& pass, QObject* parent)
+    : QThread(parent)
+    , m_dbFilePath(dbFilePath)
+    , m_seed(seed)
+    , m_pass(pass)
+    , m_isCreating(true)
+{
+}
+
+void WalletDBLoader::run()
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    try
+    {
+        if (!m_isCreating || create())
+        {
+            open();
+        }
+    }
+    catch (const std::exception& e)
+    {
+        UI_LOG_ERROR() << "Failed to load wallet DB: " << e.what();
+        m_walletDB.reset();
+    }
+    catch (...)
+    {
+        UI_LOG_ERROR() << "Failed to load wallet DB";
+        m_walletDB.reset();
+    }
+
+    UI_LOG_INFO() << "Wallet DB " << (m_walletDB ? "loaded" : "failed to load") << " in " << timer.elapsed() << " ms"
+                  << (isCancelled() ? ", cancelled" : "");
+    setStage(Stage::Done);
+}
+
+bool WalletDBLoader::create()
+{
+    // WalletDB::init needs a reactor in scope
+    auto reactor = io::Reactor::create();
+    io::Reactor::Scope scope(*reactor);
+
+    QElapsedTimer timer;
+    setStage(Stage::Creating);
+    timer.start();
+    auto db = WalletDB::init(m_dbFilePath, m_pass, m_seed.hash());
+    UI_LOG_INFO() << "Wallet DB created in " << timer.elapsed() << " ms";
+    if (!db)
+    {
+        return false;
+    }
+
+    setStage(Stage::GeneratingAddress);
+    timer.restart();
+    generateDefaultAddress(db);
+    UI_LOG_INFO() << "Default address generated in " << timer.elapsed() << " ms";
+
+    // the new DB is closed here and opened as an existing one
+    return true;
+}
+
+void WalletDBLoader::open()
+{
+    if (isCancelled())
+    {
+        return;
+    }
+
+    setStage(Stage::Opening);
+    QElapsedTimer timer;
+    timer.start();
+    if (WalletDB::isInitialized(m_dbFilePath))
+    {
+        // includes key derivation and migration of the DB schema
+        m_walletDB = WalletDB::open(m_dbFilePath, m_pass);
+    }
+    UI_LOG_INFO() << "Wallet DB opened in " << timer.elapsed() << " ms";
+}
+
+void WalletDBLoader::cancel()
+{
+    m_isCancelled = true;
+}
+
+bool WalletDBLoader::isCancelled() const
+{
+    return m_isCancelled;
+}
+
+bool WalletDBLoader::isCreating() const
+{
+    return m_isCreating;
+}
+
+IWalletDB::Ptr WalletDBLoader::takeWalletDB()
+{
+    return std::move(m_walletDB);
+}
+
+void WalletDBLoader::generateDefaultAddress(IWalletDB::Ptr db)
+{
+    WalletAddress address;
+    db->createAddress(address);
+    address.m_label = "default";
+    db->saveAddress(address);
+}
+
+void WalletDBLoader::setStage(Stage stage)
+{
+    emit stageChanged(static_cast<int>(stage));
+}
@@ -0,0 +1,71 @@
+// Copyright 2019 The Hds Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <QThread>
+#include "wallet/core/wallet_db.h"
+#include "wallet/core/secstring.h"
+
+// Opens or creates the wallet DB out of the GUI thread.
+// Key derivation, opening and migration of the DB are done by WalletDB::open
+// at once, so the progress is reported per stage and cancellation only drops
+// the result: the DB is closed and a created one is removed in the GUI thread.
+class WalletDBLoader : public QThread
+{
+    Q_OBJECT
+public:
+    enum class Stage
+    {
+        Creating,
+        GeneratingAddress,
+        Opening,
+        Done
+    };
+
+    // opens the DB at dbFilePath
+    WalletDBLoader(const std::string& dbFilePath, const hds::SecString& pass, QObject* parent = nullptr);
+    // creates the DB at dbFilePath from the seed and opens it
+    WalletDBLoader(const std::string& dbFilePath, const hds::SecString& seed, const hds::SecString& pass, QObject* parent = nullptr);
+
+    void run() override;
+
+    // can be called from any thread, the work in progress is not interrupted
+    void cancel();
+    bool isCancelled() const;
+    bool isCreating() const;
+
+    // valid after finished(), empty on failure
+    // the loader keeps no reference, so dropping the result closes the DB
+    hds::wallet::IWalletDB::Ptr takeWalletDB();
+
+    static void generateDefaultAddress(hds::wallet::IWalletDB::Ptr db);
+
+signals:
+    void stageChanged(int stage);
+
+private:
+    void setStage(Stage stage);
+    bool create();
+    void open();
+
+    std::string m_dbFilePath;
+    hds::SecString m_seed;
+    hds::SecString m_pass;
+    bool m_isCreating;
+    std::atomic_bool m_isCancelled{ false };
+    hds::wallet::IWalletDB::Ptr m_walletDB;
+};
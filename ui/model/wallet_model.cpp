@@ -25,8 +25,14 @@ using namespace hds::wallet;
 using namespace hds::io;
 using namespace std;
 
+namespace
+{
+    const unsigned kSnapshotSaveIntervalMs = 5 * 60 * 1000;
+}
+
 WalletModel::WalletModel(IWalletDB::Ptr walletDB, const std::string& nodeAddr, hds::io::Reactor::Ptr reactor)
     : WalletClient(walletDB, nodeAddr, reactor)
+    , m_db(walletDB)
 {
     qRegisterMetaType<hds::ByteBuffer>("hds::ByteBuffer");
     qRegisterMetaType<hds::wallet::WalletStatus>("hds::wallet::WalletStatus");
@@ -51,6 +57,15 @@ WalletModel::WalletModel(IWalletDB::Ptr walletDB, const std::string& nodeAddr, h
     connect(this, SIGNAL(addressesChanged(bool, const std::vector<hds::wallet::WalletAddress>&)),
             this, SLOT(setAddresses(bool, const std::vector<hds::wallet::WalletAddress>&)));
     connect(this, SIGNAL(functionPosted(const std::function<void()>&)), this, SLOT(doFunction(const std::function<void()>&)));
+    connect(this, SIGNAL(transactionsChanged(hds::wallet::ChangeAction, const std::vector<hds::wallet::TxDescription>&)),
+            this, SLOT(updateSnapshot(hds::wallet::ChangeAction, const std::vector<hds::wallet::TxDescription>&)));
+
+    // the wallet thread is not running yet, DB can be accessed here
+    m_snapshot.load(*m_db);
+
+    // afterwards the DB belongs to the wallet thread, so the snapshot is saved there
+    m_snapshotTimer = io::Timer::create(*reactor);
+    m_snapshotTimer->start(kSnapshotSaveIntervalMs, true, [this]() { saveSnapshot(); });
 
     getAsync()->getAddresses(true);
 }
@@ -58,6 +73,10 @@ WalletModel::WalletModel(IWalletDB::Ptr walletDB, const std::string& nodeAddr, h
 WalletModel::~WalletModel()
 {
     stopReactor();
+    m_snapshotTimer.reset();
+
+    // the wallet thread is stopped, the last changes are saved here
+    saveSnapshot();
 }
 
 QString WalletModel::GetErrorString(hds::wallet::ErrorType type)
@@ -344,6 +363,16 @@ hds::Height WalletModel::getCurrentHeightTimestamp() const
     return m_status.update.lastTime;
 }
 
+const WalletSnapshot& WalletModel::getSnapshot() const
+{
+    return m_snapshot;
+}
+
+const hds::wallet::WalletStatus& WalletModel::getDisplayStatus() const
+{
+    return m_isStatusReceived ? m_status : m_snapshot.getStatus();
+}
+
 hds::Block::SystemState::ID WalletModel::getCurrentStateID() const
 {
     return m_status.stateID;
@@ -351,6 +380,27 @@ hds::Block::SystemState::ID WalletModel::getCurrentStateID() const
 
 void WalletModel::setStatus(const hds::wallet::WalletStatus& status)
 {
+    {
+        std::lock_guard<std::mutex> lock(m_snapshotMutex);
+        m_snapshot.setStatus(status);
+        m_isSnapshotChanged = true;
+    }
+
+    if (!m_isStatusReceived)
+    {
+        // the snapshot balance was displayed until now, everything is refreshed
+        m_isStatusReceived = true;
+        m_status = status;
+        emit availableChanged();
+        emit receivingChanged();
+        emit receivingIncomingChanged();
+        emit receivingChangeChanged();
+        emit sendingChanged();
+        emit maturingChanged();
+        emit stateIDChanged();
+        return;
+    }
+
     if (m_status.available != status.available)
     {
         m_status.available = status.available;
@@ -397,6 +447,12 @@ void WalletModel::setStatus(const hds::wallet::WalletStatus& status)
 
 void WalletModel::setAddresses(bool own, const std::vector<hds::wallet::WalletAddress>& addrs)
 {
+    {
+        std::lock_guard<std::mutex> lock(m_snapshotMutex);
+        m_snapshot.setAddresses(own, addrs);
+        m_isSnapshotChanged = true;
+    }
+
     if (own)
     {
         m_myWalletIds.clear();
@@ -410,6 +466,32 @@ void WalletModel::setAddresses(bool own, const std::vector<hds::wallet::WalletAd
     }
 }
 
+void WalletModel::updateSnapshot(hds::wallet::ChangeAction action, const std::vector<hds::wallet::TxDescription>& items)
+{
+    std::lock_guard<std::mutex> lock(m_snapshotMutex);
+    m_snapshot.updateTransactions(action, items);
+    m_isSnapshotChanged = true;
+}
+
+void WalletModel::saveSnapshot()
+{
+    std::lock_guard<std::mutex> lock(m_snapshotMutex);
+    if (!m_isSnapshotChanged)
+    {
+        return;
+    }
+
+    try
+    {
+        m_snapshot.save(*m_db);
+        m_isSnapshotChanged = false;
+    }
+    catch (const std::exception& e)
+    {
+        LOG_WARNING() << "Failed to save UI snapshot: " << e.what();
+    }
+}
+
 void WalletModel::doFunction(const std::function<void()>& func)
 {
     func();
@@ -17,7 +17,10 @@
 #include <QObject>
 
 #include "wallet/client/wallet_client.h"
+#include "utility/io/timer.h"
+#include "wallet_snapshot.h"
 #include <set>
+#include <mutex>
 
 class WalletModel
     : public QObject
@@ -45,6 +48,11 @@ public:
     hds::Timestamp getCurrentHeightTimestamp() const;
     hds::Block::SystemState::ID getCurrentStateID() const;
 
+    // the last known state, is loaded from the DB at start and follows the wallet afterwards
+    const WalletSnapshot& getSnapshot() const;
+    // for display only, the snapshot balance until the wallet reports the real one
+    const hds::wallet::WalletStatus& getDisplayStatus() const;
+
 signals:
     void walletStatus(const hds::wallet::WalletStatus& status);
     void transactionsChanged(hds::wallet::ChangeAction, const std::vector<hds::wallet::TxDescription>& items);
@@ -123,10 +131,21 @@ private:
 private slots:
     void setStatus(const hds::wallet::WalletStatus& status);
     void setAddresses(bool own, const std::vector<hds::wallet::WalletAddress>& addrs);
+    void updateSnapshot(hds::wallet::ChangeAction action, const std::vector<hds::wallet::TxDescription>& items);
     void doFunction(const std::function<void()>& func);
 
+private:
+    void saveSnapshot();
+
 private:
     std::set<hds::wallet::WalletID> m_myWalletIds;
     std::set<std::string> m_myAddrLabels;
     hds::wallet::WalletStatus m_status;
+    hds::wallet::IWalletDB::Ptr m_db;
+    bool m_isStatusReceived = false;
+    // the snapshot is changed in the UI thread and saved in the wallet thread
+    std::mutex m_snapshotMutex;
+    bool m_isSnapshotChanged = false;
+    WalletSnapshot m_snapshot;
+    hds::io::Timer::Ptr m_snapshotTimer;
 };
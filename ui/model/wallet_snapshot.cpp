@@ -0,0 +1,361 @@
+// Copyright 2019 The Hds Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "wallet_snapshot.h"
+
+#include <algorithm>
+#include <cstring>
+#include <QDataStream>
+#include "utility/logger.h"
+
+using namespace hds;
+using namespace hds::wallet;
+
+namespace
+{
+    const char* kSnapshotVarName = "UISnapshot";
+    const quint32 kSnapshotMagic = 0x48445355;  // HDSU
+    // increase on any change of the format, snapshots of other versions are ignored
+    const quint32 kSnapshotVersion = 1;
+    // the counts are read from the DB, a broken one must not allocate much
+    const quint32 kMaxReservedAddresses = 1024;
+
+    template<typename T>
+    QByteArray toBytes(const T& value)
+    {
+        return QByteArray(reinterpret_cast<const char*>(value.m_pData), static_cast<int>(value.nBytes));
+    }
+
+    template<typename T>
+    bool fromBytes(const QByteArray& data, T& value)
+    {
+        if (static_cast<size_t>(data.size()) != value.nBytes)
+        {
+            return false;
+        }
+        std::memcpy(value.m_pData, data.constData(), value.nBytes);
+        return true;
+    }
+
+    QByteArray toBytes(const TxID& txID)
+    {
+        return QByteArray(reinterpret_cast<const char*>(txID.data()), static_cast<int>(txID.size()));
+    }
+
+    bool fromBytes(const QByteArray& data, TxID& txID)
+    {
+        if (static_cast<size_t>(data.size()) != txID.size())
+        {
+            return false;
+        }
+        std::memcpy(txID.data(), data.constData(), txID.size());
+        return true;
+    }
+
+    // only the fields shown in the list
+    TxDescription makeRow(const TxDescription& tx)
+    {
+        TxDescription row(tx.m_txId);
+        row.m_txType = tx.m_txType;
+        row.m_amount = tx.m_amount;
+        row.m_fee = tx.m_fee;
+        row.m_createTime = tx.m_createTime;
+        row.m_modifyTime = tx.m_modifyTime;
+        row.m_sender = tx.m_sender;
+        row.m_selfTx = tx.m_selfTx;
+        row.m_status = tx.m_status;
+        row.m_failureReason = tx.m_failureReason;
+        row.m_message = tx.m_message;
+        row.m_myId = tx.m_myId;
+        row.m_peerId = tx.m_peerId;
+        row.m_kernelID = tx.m_kernelID;
+        row.SetParameter(TxParameterID::TransactionType, tx.m_txType);
+        if (auto assetID = tx.GetParameter<Asset::ID>(TxParameterID::AssetID); assetID && *assetID != Asset::s_InvalidID)
+        {
+            row.SetParameter(TxParameterID::AssetID, *assetID);
+        }
+        return row;
+    }
+
+    QString toString(const WalletID& walletID)
+    {
+        return walletID != Zero ? QString::fromStdString(std::to_string(walletID)) : QString();
+    }
+
+    WalletID fromString(const QString& str)
+    {
+        WalletID walletID = Zero;
+        if (!str.isEmpty())
+        {
+            walletID.FromHex(str.toStdString());
+        }
+        return walletID;
+    }
+
+    void writeAddresses(QDataStream& stream, const std::vector<WalletAddress>& addresses)
+    {
+        stream << static_cast<quint32>(addresses.size());
+        for (const auto& address : addresses)
+        {
+            stream << toString(address.m_walletID)
+                   << QString::fromStdString(address.m_label)
+                   << QString::fromStdString(address.m_category)
+                   << static_cast<quint64>(address.m_createTime)
+                   << static_cast<quint64>(address.m_duration)
+                   << static_cast<quint64>(address.m_OwnID)
+                   << toBytes(address.m_Identity);
+        }
+    }
+
+    bool readAddresses(QDataStream& stream, std::vector<WalletAddress>& addresses)
+    {
+        quint32 count = 0;
+        stream >> count;
+        addresses.clear();
+        addresses.reserve(std::min(count, kMaxReservedAddresses));
+        for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i)
+        {
+            QString walletID, label, category;
+            quint64 createTime = 0, duration = 0, ownID = 0;
+            QByteArray identity;
+            stream >> walletID >> label >> category >> createTime >> duration >> ownID >> identity;
+
+            WalletAddress address;
+            address.m_walletID = fromString(walletID);
+            address.m_label = label.toStdString();
+            address.m_category = category.toStdString();
+            address.m_createTime = createTime;
+            address.m_duration = duration;
+            address.m_OwnID = ownID;
+            fromBytes(identity, address.m_Identity);
+            addresses.push_back(std::move(address));
+        }
+        return stream.status() == QDataStream::Ok;
+    }
+}  // namespace
+
+bool WalletSnapshot::load(IWalletDB& walletDB)
+{
+    ByteBuffer blob;
+    if (!walletDB.getBlob(kSnapshotVarName, blob) || blob.empty())
+    {
+        return false;
+    }
+
+    if (!deserialize(QByteArray(reinterpret_cast<const char*>(blob.data()), static_cast<int>(blob.size()))))
+    {
+        LOG_WARNING() << "UI snapshot is not compatible and is ignored";
+        *this = WalletSnapshot();
+        return false;
+    }
+
+    LOG_INFO() << "UI snapshot loaded: " << m_transactions.size() << " transactions, "
+               << m_ownAddresses.size() + m_contacts.size() << " addresses";
+    return true;
+}
+
+void WalletSnapshot::save(IWalletDB& walletDB) const
+{
+    auto data = serialize();
+    walletDB.setVarRaw(kSnapshotVarName, data.constData(), static_cast<size_t>(data.size()));
+}
+
+bool WalletSnapshot::isEmpty() const
+{
+    return m_transactions.empty() && m_ownAddresses.empty() && m_contacts.empty();
+}
+
+void WalletSnapshot::setStatus(const WalletStatus& status)
+{
+    m_status = status;
+}
+
+const WalletStatus& WalletSnapshot::getStatus() const
+{
+    return m_status;
+}
+
+void WalletSnapshot::updateTransactions(ChangeAction action, const std::vector<TxDescription>& items)
+{
+    if (action == ChangeAction::Reset)
+    {
+        m_transactions.clear();
+    }
+
+    for (const auto& tx : items)
+    {
+        if (action == ChangeAction::Removed)
+        {
+            m_transactions.erase(tx.m_txId);
+            continue;
+        }
+
+        auto it = m_transactions.find(tx.m_txId);
+        if (it != m_transactions.end())
+        {
+            it->second = makeRow(tx);
+            continue;
+        }
+
+        if (m_transactions.size() >= kMaxTransactions)
+        {
+            auto oldest = std::min_element(m_transactions.begin(), m_transactions.end(),
+                [](const auto& lhs, const auto& rhs)
+                {
+                    return lhs.second.m_createTime < rhs.second.m_createTime;
+                });
+            if (oldest->second.m_createTime >= tx.m_createTime)
+            {
+                continue;
+            }
+            m_transactions.erase(oldest);
+        }
+        m_transactions.emplace(tx.m_txId, makeRow(tx));
+    }
+}
+
+std::vector<TxDescription> WalletSnapshot::getTransactions() const
+{
+    std::vector<TxDescription> transactions;
+    transactions.reserve(m_transactions.size());
+    for (const auto& p : m_transactions)
+    {
+        transactions.push_back(p.second);
+    }
+    return transactions;
+}
+
+void WalletSnapshot::setAddresses(bool own, const std::vector<WalletAddress>& addresses)
+{
+    (own ? m_ownAddresses : m_contacts) = addresses;
+}
+
+const std::vector<WalletAddress>& WalletSnapshot::getAddresses(bool own) const
+{
+    return own ? m_ownAddresses : m_contacts;
+}
+
+QByteArray WalletSnapshot::serialize() const
+{
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_5_0);
+
+    stream << kSnapshotMagic << kSnapshotVersion;
+
+    stream << static_cast<quint64>(m_status.available)
+           << static_cast<quint64>(m_status.receiving)
+           << static_cast<quint64>(m_status.receivingIncoming)
+           << static_cast<quint64>(m_status.receivingChange)
+           << static_cast<quint64>(m_status.sending)
+           << static_cast<quint64>(m_status.maturing);
+
+    // already limited to the most recent transactions
+    stream << static_cast<quint32>(m_transactions.size());
+    for (const auto& p : m_transactions)
+    {
+        const auto& tx = p.second;
+        auto assetID = tx.GetParameter<Asset::ID>(TxParameterID::AssetID);
+        stream << toBytes(tx.m_txId)
+               << static_cast<qint32>(tx.m_txType)
+               << static_cast<quint32>(assetID ? *assetID : Asset::s_InvalidID)
+               << static_cast<quint64>(tx.m_amount)
+               << static_cast<quint64>(tx.m_fee)
+               << static_cast<quint64>(tx.m_createTime)
+               << static_cast<quint64>(tx.m_modifyTime)
+               << tx.m_sender
+               << tx.m_selfTx
+               << static_cast<qint32>(tx.m_status)
+               << static_cast<qint32>(tx.m_failureReason)
+               << QByteArray(reinterpret_cast<const char*>(tx.m_message.data()), static_cast<int>(tx.m_message.size()))
+               << toString(tx.m_myId)
+               << toString(tx.m_peerId)
+               << toBytes(tx.m_kernelID);
+    }
+
+    writeAddresses(stream, m_ownAddresses);
+    writeAddresses(stream, m_contacts);
+    return data;
+}
+
+bool WalletSnapshot::deserialize(const QByteArray& data)
+{
+    QDataStream stream(data);
+    stream.setVersion(QDataStream::Qt_5_0);
+
+    quint32 magic = 0, version = 0;
+    stream >> magic >> version;
+    if (magic != kSnapshotMagic || version != kSnapshotVersion)
+    {
+        return false;
+    }
+
+    quint64 available = 0, receiving = 0, receivingIncoming = 0, receivingChange = 0, sending = 0, maturing = 0;
+    stream >> available >> receiving >> receivingIncoming >> receivingChange >> sending >> maturing;
+    m_status.available = available;
+    m_status.receiving = receiving;
+    m_status.receivingIncoming = receivingIncoming;
+    m_status.receivingChange = receivingChange;
+    m_status.sending = sending;
+    m_status.maturing = maturing;
+
+    quint32 count = 0;
+    stream >> count;
+    m_transactions.clear();
+    if (count > kMaxTransactions)
+    {
+        return false;
+    }
+    for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i)
+    {
+        QByteArray txIDBytes, message, kernelID;
+        qint32 txType = 0, status = 0, failureReason = 0;
+        quint32 assetID = 0;
+        quint64 amount = 0, fee = 0, createTime = 0, modifyTime = 0;
+        bool sender = false, selfTx = false;
+        QString myID, peerID;
+        stream >> txIDBytes >> txType >> assetID >> amount >> fee >> createTime >> modifyTime
+               >> sender >> selfTx >> status >> failureReason >> message >> myID >> peerID >> kernelID;
+
+        TxID txID;
+        if (!fromBytes(txIDBytes, txID))
+        {
+            return false;
+        }
+
+        TxDescription tx(txID);
+        tx.m_txType = static_cast<TxType>(txType);
+        tx.m_amount = amount;
+        tx.m_fee = fee;
+        tx.m_createTime = createTime;
+        tx.m_modifyTime = modifyTime;
+        tx.m_sender = sender;
+        tx.m_selfTx = selfTx;
+        tx.m_status = static_cast<TxStatus>(status);
+        tx.m_failureReason = static_cast<TxFailureReason>(failureReason);
+        tx.m_message.assign(message.begin(), message.end());
+        tx.m_myId = fromString(myID);
+        tx.m_peerId = fromString(peerID);
+        fromBytes(kernelID, tx.m_kernelID);
+        tx.SetParameter(TxParameterID::TransactionType, tx.m_txType);
+        if (assetID != Asset::s_InvalidID)
+        {
+            tx.SetParameter(TxParameterID::AssetID, static_cast<Asset::ID>(assetID));
+        }
+        m_transactions.emplace(txID, std::move(tx));
+    }
+
+    return readAddresses(stream, m_ownAddresses)
+        && readAddresses(stream, m_contacts);
+}
@@ -0,0 +1,53 @@
+// Copyright 2019 The Hds Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <map>
+#include <vector>
+#include <QByteArray>
+#include "wallet/client/wallet_client.h"
+
+// What the main screen needs to be drawn before the wallet is running:
+// balances, the most recent transactions and the address book.
+// Stored as a versioned blob in the (encrypted) wallet DB.
+class WalletSnapshot
+{
+public:
+    // transactions are limited to the most recent ones, only the fields shown in the list are kept
+    static constexpr size_t kMaxTransactions = 100;
+
+    bool load(hds::wallet::IWalletDB& walletDB);
+    void save(hds::wallet::IWalletDB& walletDB) const;
+
+    bool isEmpty() const;
+
+    void setStatus(const hds::wallet::WalletStatus& status);
+    const hds::wallet::WalletStatus& getStatus() const;
+
+    void updateTransactions(hds::wallet::ChangeAction action, const std::vector<hds::wallet::TxDescription>& items);
+    std::vector<hds::wallet::TxDescription> getTransactions() const;
+
+    void setAddresses(bool own, const std::vector<hds::wallet::WalletAddress>& addresses);
+    const std::vector<hds::wallet::WalletAddress>& getAddresses(bool own) const;
+
+private:
+    QByteArray serialize() const;
+    bool deserialize(const QByteArray& data);
+
+    hds::wallet::WalletStatus m_status;
+    std::map<hds::wallet::TxID, hds::wallet::TxDescription> m_transactions;
+    std::vector<hds::wallet::WalletAddress> m_ownAddresses;
+    std::vector<hds::wallet::WalletAddress> m_contacts;
+};
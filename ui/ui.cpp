@@ -51,7 +51,6 @@
 #include "viewmodel/notifications/push_notification_manager.h"
 #include "viewmodel/notifications/exchange_rates_manager.h"
 #include "wallet/core/wallet_db.h"
-#include "utility/log_rotation.h"
 #include "core/ecc_native.h"
 #include "utility/cli/options.h"
 #include <QtCore/QtPlugin>
@@ -59,6 +58,9 @@
 #include "utility/string_helpers.h"
 #include "utility/helpers.h"
 #include "model/translator.h"
+#include "model/startup_tracer.h"
+#include "model/log_maintenance.h"
+#include "model/ui_log.h"
 
 #if defined(HDS_USE_STATIC)
 
@@ -97,8 +99,15 @@ static const char* AppName = APP_NAME;
 static const char* AppName = "Hds Wallet Masternet";
 #endif
 
+namespace
+{
+    const char* kTraceStartup = "trace_startup";
+}
+
 int main (int argc, char* argv[])
 {
+    auto mainStart = StartupTracer::now();
+
 #if defined Q_OS_WIN
     QApplication::setAttribute(Qt::AA_EnableHighDpiScaling);
 #endif
@@ -127,6 +136,9 @@ int main (int argc, char* argv[])
 #pragma GCC diagnostic pop
 #endif
 
+        options.add_options()
+            (kTraceStartup, po::value<string>(), "write startup trace events in Chrome trace format to the given file");
+
         po::variables_map vm;
 
         try
@@ -157,6 +169,12 @@ int main (int argc, char* argv[])
             return 0;
         }
 
+        if (vm.count(kTraceStartup))
+        {
+            StartupTracer::getInstance().enable(vm[kTraceStartup].as<string>());
+            StartupTracer::getInstance().addSpan("parse options", mainStart, StartupTracer::now() - mainStart);
+        }
+
         if (vm.count(cli::APPDATA_PATH))
         {
             const auto newPath = QString::fromStdString(vm[cli::APPDATA_PATH].as<string>());
@@ -164,22 +182,26 @@ int main (int argc, char* argv[])
         }
 
         int logLevel = getLogLevel(cli::LOG_LEVEL, vm, LOG_LEVEL_DEBUG);
-        int fileLogLevel = getLogLevel(cli::FILE_LOG_LEVEL, vm, LOG_LEVEL_DEBUG);
+        // the command line overrides the level chosen in the settings
+        int fileLogLevel = getLogLevel(cli::FILE_LOG_LEVEL, vm, WalletSettings::readFileLogLevel(appDataDir));
 
         hds::Crash::InstallHandler(appDataDir.filePath(AppName).toStdString().c_str());
 
 #define LOG_FILES_PREFIX "hds_ui_"
 
         const auto logFilesPath = appDataDir.filePath(WalletSettings::LogsFolder).toStdString();
-        auto logger = hds::Logger::create(logLevel, logLevel, fileLogLevel, LOG_FILES_PREFIX, logFilesPath);
+        // the logger drops everything above its first level, so it is the most verbose of both
+        auto logger = hds::Logger::create(std::max(logLevel, fileLogLevel), logLevel, fileLogLevel, LOG_FILES_PREFIX, logFilesPath);
+        UILog::Scope uiLog(logLevel, fileLogLevel);
 
         unsigned logCleanupPeriod = vm[cli::LOG_CLEANUP_DAYS].as<uint32_t>() * 24 * 3600;
 
-        clean_old_logfiles(logFilesPath, LOG_FILES_PREFIX, logCleanupPeriod);
-
         try
         {
-            Rules::get().UpdateChecksum();
+            {
+                STARTUP_TRACE_SPAN("Rules::UpdateChecksum");
+                Rules::get().UpdateChecksum();
+            }
             LOG_INFO() << "Hds Wallet UI " << PROJECT_VERSION << " (" << BRANCH_NAME << ")";
             LOG_INFO() << "Hds Core " << HDS_VERSION << " (" << HDS_BRANCH_NAME << ")";
             LOG_INFO() << "Rules signature: " << Rules::get().get_SignatureStr();
@@ -187,11 +209,24 @@ int main (int argc, char* argv[])
             // AppModel Model MUST BE created before the UI engine and destroyed after.
             // AppModel serves the UI and UI should be able to access AppModel at any time
             // even while being destroyed. Do not move engine above AppModel
+            auto appModelStart = StartupTracer::now();
             WalletSettings settings(appDataDir);
+
+            // old logs are compressed and removed in background, the local node logs to the same files
+            LogMaintenance::Limits logLimits;
+            logLimits.maxAgeSeconds = logCleanupPeriod;
+            logLimits.maxTotalSize = settings.getLogsSizeLimit();
+            LogMaintenance logMaintenance(QString::fromStdString(logFilesPath), { LOG_FILES_PREFIX }, logLimits);
+            logMaintenance.start(QThread::LowestPriority);
+
             AppModel appModel(settings);
+            StartupTracer::getInstance().addSpan("create AppModel", appModelStart, StartupTracer::now() - appModelStart);
+
             QQmlApplicationEngine engine;
             Translator translator(settings, engine);
             
+            auto registrationStart = StartupTracer::now();
+
             if (settings.getNodeAddress().isEmpty())
             {
                 if (vm.count(cli::NODE_ADDR))
@@ -246,6 +281,7 @@ int main (int argc, char* argv[])
             qmlRegisterType<WalletDBPathItem>("Hds.Wallet", 1, 0, "WalletDBPathItem");
             qmlRegisterType<SwapOfferItem>("Hds.Wallet", 1, 0, "SwapOfferItem");
             qmlRegisterType<SwapOffersList>("Hds.Wallet", 1, 0, "SwapOffersList");
+            qmlRegisterType<SwapOrderBook>("Hds.Wallet", 1, 0, "SwapOrderBook");
             qmlRegisterType<SwapTxObjectList>("Hds.Wallet", 1, 0, "SwapTxObjectList");
             qmlRegisterType<TxObjectList>("Hds.Wallet", 1, 0, "TxObjectList");
             
@@ -255,7 +291,12 @@ int main (int argc, char* argv[])
             
             qmlRegisterType<SortFilterProxyModel>("Hds.Wallet", 1, 0, "SortFilterProxyModel");
 
-            engine.load(QUrl("qrc:/root.qml"));
+            StartupTracer::getInstance().addSpan("register QML types", registrationStart, StartupTracer::now() - registrationStart);
+
+            {
+                STARTUP_TRACE_SPAN("load root.qml");
+                engine.load(QUrl("qrc:/root.qml"));
+            }
 
             if (engine.rootObjects().count() < 1)
             {
@@ -275,8 +316,13 @@ int main (int argc, char* argv[])
             //window->setMinimumSize(QSize(768, 540));
             window->setFlag(Qt::WindowFullscreenButtonHint);
             window->show();
+            StartupTracer::getInstance().addInstant("window shown");
+
+            auto result = app.exec();
 
-            return app.exec();
+            // the wallet has not been opened
+            StartupTracer::getInstance().finish();
+            return result;
         }
         catch (const po::error& e)
         {
@@ -0,0 +1,131 @@
+// Copyright 2019 The Hds Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+
+#include <QVariant>
+#include <iostream>
+#include <memory>
+#include <vector>
+#include "viewmodel/helpers/list_model.h"
+
+// Reconciles a list the way WalletViewModel does after the snapshot rows and checks
+// that the kept rows are only changed in place and the others are removed or appended in batches
+namespace
+{
+    int g_failures = 0;
+
+#define CHECK(expr) \
+    do { \
+        if (!(expr)) \
+        { \
+            std::cerr << __FILE__ << ":" << __LINE__ << " check failed: " #expr << std::endl; \
+            ++g_failures; \
+        } \
+    } while (false)
+
+    struct Item
+    {
+        int key;
+        int version;
+
+        bool operator==(const Item& other) const
+        {
+            return key == other.key;
+        }
+    };
+
+    using ItemPtr = std::shared_ptr<Item>;
+
+    class ItemList : public ListModel<ItemPtr>
+    {
+    public:
+        QVariant data(const QModelIndex&, int) const override
+        {
+            return {};
+        }
+    };
+
+    struct Signals
+    {
+        int removed = 0;
+        int inserted = 0;
+        int changed = 0;
+    };
+
+    std::vector<ItemPtr> makeItems(int first, int last, int version)
+    {
+        std::vector<ItemPtr> items;
+        for (int key = first; key < last; ++key)
+        {
+            items.push_back(std::make_shared<Item>(Item{ key, version }));
+        }
+        return items;
+    }
+
+    void testReconcile()
+    {
+        ItemList model;
+        model.insert(makeItems(0, 1000, 0));
+
+        Signals counts;
+        QObject::connect(&model, &QAbstractItemModel::rowsRemoved, [&counts]() { ++counts.removed; });
+        QObject::connect(&model, &QAbstractItemModel::rowsInserted, [&counts]() { ++counts.inserted; });
+        QObject::connect(&model, &QAbstractItemModel::dataChanged, [&counts]() { ++counts.changed; });
+
+        // rows 100..109 and 500..504 are gone, 1000..1019 are new
+        auto items = makeItems(0, 100, 1);
+        auto tail = makeItems(110, 500, 1);
+        items.insert(items.end(), tail.begin(), tail.end());
+        tail = makeItems(505, 1020, 1);
+        items.insert(items.end(), tail.begin(), tail.end());
+
+        model.reconcile(items, [](const ItemPtr& item) { return item->key; });
+
+        CHECK(counts.removed == 2);
+        CHECK(counts.inserted == 1);
+        CHECK(counts.changed == 1);
+        CHECK(model.rowCount() == static_cast<int>(items.size()));
+        for (int row = 0; row < model.rowCount(); ++row)
+        {
+            CHECK(model.get(row)->key == items[row]->key);
+            CHECK(model.get(row)->version == 1);
+        }
+    }
+
+    void testReconcileEmpty()
+    {
+        ItemList model;
+        model.insert(makeItems(0, 10, 0));
+
+        model.reconcile({}, [](const ItemPtr& item) { return item->key; });
+        CHECK(model.rowCount() == 0);
+
+        model.reconcile(makeItems(0, 5, 1), [](const ItemPtr& item) { return item->key; });
+        CHECK(model.rowCount() == 5);
+    }
+}
+
+int main()
+{
+    testReconcile();
+    testReconcileEmpty();
+
+    if (g_failures)
+    {
+        std::cerr << g_failures << " checks failed" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,128 @@
+// Copyright 2019 The Hds Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <QCoreApplication>
+#include <QEvent>
+#include <iostream>
+#include <vector>
+#include "viewmodel/helpers/object_pool.h"
+
+// Refreshes a list the way AddressBookViewModel::onAddresses does and checks
+// that the number of live items stays bounded by the largest list plus the idle limit
+namespace
+{
+    int g_failures = 0;
+
+#define CHECK(expr) \
+    do { \
+        if (!(expr)) \
+        { \
+            std::cerr << __FILE__ << ":" << __LINE__ << " check failed: " #expr << std::endl; \
+            ++g_failures; \
+        } \
+    } while (false)
+
+    const size_t kMaxIdleItems = 16;
+
+    class Item : public QObject
+    {
+    public:
+        explicit Item(int value)
+            : m_value(value)
+        {
+            ++s_live;
+        }
+
+        ~Item() override
+        {
+            --s_live;
+        }
+
+        void reset(int value)
+        {
+            m_value = value;
+        }
+
+        int getValue() const
+        {
+            return m_value;
+        }
+
+        static size_t s_live;
+
+    private:
+        int m_value;
+    };
+
+    size_t Item::s_live = 0;
+
+    void refresh(ObjectPool<Item>& pool, std::vector<Item*>& items, size_t count)
+    {
+        pool.releaseAll(items);
+        for (size_t i = 0; i < count; ++i)
+        {
+            items.push_back(pool.acquire(static_cast<int>(i)));
+        }
+        pool.trim(kMaxIdleItems);
+
+        // the trimmed items are deleted by the event loop
+        QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+    }
+
+    void testChurn()
+    {
+        QObject owner;
+        ObjectPool<Item> pool(&owner);
+        std::vector<Item*> items;
+
+        const size_t sizes[] = { 1000, 10, 500, 0, 1000, 3, 1000 };
+        for (int round = 0; round < 100; ++round)
+        {
+            for (auto size : sizes)
+            {
+                refresh(pool, items, size);
+                CHECK(items.size() == size);
+                CHECK(pool.idle() <= kMaxIdleItems);
+                CHECK(pool.allocated() == size + pool.idle());
+                CHECK(Item::s_live == pool.allocated());
+                if (g_failures)
+                {
+                    return;
+                }
+            }
+        }
+
+        // the same list again reuses the items
+        auto allocated = pool.allocated();
+        refresh(pool, items, items.size());
+        CHECK(pool.allocated() == allocated);
+        CHECK(items.back()->getValue() == static_cast<int>(items.size()) - 1);
+    }
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    testChurn();
+    CHECK(Item::s_live == 0);
+
+    if (g_failures)
+    {
+        std::cerr << g_failures << " checks failed" << std::endl;
+        return 1;
+    }
+    return 0;
+}
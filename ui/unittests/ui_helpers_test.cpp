@@ -0,0 +1,149 @@
+// Copyright 2019 The Hds Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <vector>
+#include "viewmodel/ui_helpers.h"
+
+// Checks hdsui::Filter and hdsui::StreamingQuantile against the exact values
+// computed with nth_element and accumulate
+namespace
+{
+    int g_failures = 0;
+
+#define CHECK(expr) \
+    do { \
+        if (!(expr)) \
+        { \
+            std::cerr << __FILE__ << ":" << __LINE__ << " check failed: " #expr << std::endl; \
+            ++g_failures; \
+        } \
+    } while (false)
+
+    bool isClose(double actual, double expected, double tolerance)
+    {
+        return std::fabs(actual - expected) <= tolerance * std::max(1.0, std::fabs(expected));
+    }
+
+    double exactQuantile(std::vector<double> values, double p)
+    {
+        auto nth = values.begin() + static_cast<size_t>(p * (values.size() - 1));
+        std::nth_element(values.begin(), nth, values.end());
+        return *nth;
+    }
+
+    void testEmptyFilter()
+    {
+        hdsui::Filter filter(10);
+        CHECK(filter.getAverage() == 0.0);
+        CHECK(filter.getMedian() == 0.0);
+
+        // non-finite samples are ignored
+        filter.addSample(std::numeric_limits<double>::quiet_NaN());
+        filter.addSample(std::numeric_limits<double>::infinity());
+        CHECK(filter.getAverage() == 0.0);
+        CHECK(filter.getMedian() == 0.0);
+
+        filter.addSample(5.0);
+        CHECK(filter.getAverage() == 5.0);
+        CHECK(filter.getMedian() == 5.0);
+    }
+
+    void testFilterWindow(size_t size)
+    {
+        std::mt19937 generator(static_cast<unsigned>(size));
+        std::lognormal_distribution<double> distribution(3.0, 1.0);
+
+        hdsui::Filter filter(size);
+        std::deque<double> window;
+        for (int i = 0; i < 100000; ++i)
+        {
+            auto value = distribution(generator);
+            filter.addSample(value);
+            window.push_back(value);
+            if (window.size() > size)
+            {
+                window.pop_front();
+            }
+
+            std::vector<double> values(window.begin(), window.end());
+            auto average = std::accumulate(values.begin(), values.end(), 0.0) / values.size();
+            auto median = values.begin() + values.size() / 2;
+            std::nth_element(values.begin(), median, values.end());
+
+            CHECK(isClose(filter.getAverage(), average, 1e-9));
+            CHECK(filter.getMedian() == *median);
+            if (g_failures)
+            {
+                return;
+            }
+        }
+    }
+
+    void testStreamingQuantile()
+    {
+        std::mt19937 generator(42);
+        std::lognormal_distribution<double> distribution(3.0, 1.0);
+
+        hdsui::StreamingQuantile p50(0.5);
+        hdsui::StreamingQuantile p95(0.95);
+        CHECK(p50.getValue() == 0.0);
+
+        std::vector<double> values;
+        for (int i = 0; i < 100000; ++i)
+        {
+            auto value = distribution(generator);
+            values.push_back(value);
+            p50.addSample(value);
+            p95.addSample(value);
+        }
+
+        CHECK(p50.getCount() == values.size());
+        CHECK(isClose(p50.getValue(), exactQuantile(values, 0.5), 0.01));
+        CHECK(isClose(p95.getValue(), exactQuantile(values, 0.95), 0.01));
+    }
+
+    void testStreamingQuantileFewSamples()
+    {
+        hdsui::StreamingQuantile p50(0.5);
+        for (double value : { 3.0, 1.0, 2.0 })
+        {
+            p50.addSample(value);
+        }
+        CHECK(p50.getValue() == 2.0);
+    }
+}  // namespace
+
+int main()
+{
+    testEmptyFilter();
+    testFilterWindow(10);
+    testFilterWindow(30);
+    testStreamingQuantile();
+    testStreamingQuantileFewSamples();
+
+    if (g_failures)
+    {
+        std::cerr << g_failures << " checks failed" << std::endl;
+        return 1;
+    }
+    return 0;
+}
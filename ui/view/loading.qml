@@ -164,6 +164,16 @@ Item
                         value: viewModel.progress
                     }
 
+                    SFText {
+                        Layout.topMargin: 6
+                        Layout.alignment: Qt.AlignHCenter | Qt.AlignTop
+                        text: viewModel.syncSummary
+                        visible: text.length > 0
+                        font.pixelSize: 12
+                        opacity: 0.5
+                        color: Style.content_main
+                    }
+
                     SFText {
                         Layout.alignment: Qt.AlignHCenter
                         Layout.topMargin: 30
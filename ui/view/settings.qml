@@ -372,6 +372,18 @@ deploy the key at the node you trust completely."*/
                     }
                 }
             }
+
+            CustomSwitch {
+                id: swapClientsOwnThreads
+                Layout.columnSpan: 2
+                Layout.fillWidth: true
+                //: settings tab, swap section, run the swap coin connections off the wallet thread
+                //% "Connect to the swap coins in separate threads (applied after restart)"
+                text: qsTrId("settings-swap-clients-own-threads")
+                font.pixelSize: 14
+                checked: viewModel.swapClientsOwnThreads
+                onClicked: viewModel.swapClientsOwnThreads = swapClientsOwnThreads.checked
+            }
         }
     }
 
@@ -462,6 +474,71 @@ deploy the key at the node you trust completely."*/
                             Layout.preferredHeight: 15
                         }
 
+                        RowLayout {
+                            Layout.preferredHeight: 16
+
+                            ColumnLayout {
+                                SFText {
+                                    Layout.fillWidth: true
+                                    //: settings tab, general section, log level label
+                                    //% "Log files level (fully applied after restart)"
+                                    text: qsTrId("settings-general-log-level")
+                                    color: Style.content_secondary
+                                    font.pixelSize: 14
+                                }
+                            }
+
+                            Item {
+                            }
+                            ColumnLayout {
+                                CustomComboBox {
+                                    id: fileLogLevelControl
+                                    fontPixelSize: 14
+                                    Layout.preferredWidth: generalBlock.width * 0.33
+
+                                    currentIndex: viewModel.fileLogLevel
+                                    model: [
+                                        //% "Verbose"
+                                        qsTrId("settings-general-log-level-verbose"),
+                                        //% "Debug"
+                                        qsTrId("settings-general-log-level-debug"),
+                                        //% "Info"
+                                        qsTrId("settings-general-log-level-info"),
+                                        //% "Warning"
+                                        qsTrId("settings-general-log-level-warning"),
+                                        //% "Error"
+                                        qsTrId("settings-general-log-level-error"),
+                                    ]
+                                    onActivated: {
+                                        viewModel.fileLogLevel = fileLogLevelControl.currentIndex;
+                                    }
+                                }
+                            }
+                        }
+
+                        SFText {
+                            Layout.fillWidth: true
+                            visible: viewModel.isFileLogLevelRestartRequired
+                            //: settings tab, general section, shown when the chosen log level is more detailed than the one the wallet was started with
+                            //% "Restart the wallet to write the messages of this level from the node and the wallet core"
+                            text: qsTrId("settings-general-log-level-restart")
+                            color: Style.content_secondary
+                            font.pixelSize: 12
+                            wrapMode: Text.Wrap
+                        }
+
+                        SFText {
+                            Layout.fillWidth: true
+                            visible: text.length > 0
+                            text: viewModel.uiLogDropped
+                            color: Style.content_secondary
+                            font.pixelSize: 12
+                        }
+
+                        Item {
+                            Layout.preferredHeight: 15
+                        }
+
                         RowLayout {
                             Layout.preferredHeight: 16
                             
@@ -627,7 +704,7 @@ deploy the key at the node you trust completely."*/
                                 textFormat: Text.RichText
                                 font.pixelSize: 14
                                 color: allowHdsCOMLinks.palette.text
-                                wrapMode: Text.WordWrap
+                                wrapMode: Text.Wrap
                                 Layout.preferredWidth: generalBlock.width - 95
                                 Layout.preferredHeight: 32
                                 linkEnabled: true
@@ -786,6 +863,41 @@ deploy the key at the node you trust completely."*/
                         confirmRefreshDialog.open();
                     }
                 }
+
+                CustomButton {
+                    Layout.preferredWidth: 250
+                    Layout.preferredHeight: 38
+                    Layout.alignment: Qt.AlignLeft
+                    Layout.topMargin: 10
+                    //: settings tab, replace the integrated node data with a local snapshot
+                    //% "Import node snapshot"
+                    text: qsTrId("settings-import-node-snapshot")
+                    icon.source: "qrc:/assets/icon-repeat-white.svg"
+                    enabled: viewModel.localNodeRun && viewModel.isLocalNodeRunning && !viewModel.isNodeSnapshotImporting
+                    onClicked: viewModel.importNodeSnapshot()
+                }
+
+                SFText {
+                    Layout.preferredWidth: 250
+                    visible: viewModel.localNodeRun
+                    //: settings tab, node snapshot import, the snapshot is not validated
+                    //% "The chain in a snapshot is not validated, import only snapshots from a source you trust."
+                    text: qsTrId("settings-import-node-snapshot-trust")
+                    color: Style.content_secondary
+                    font.pixelSize: 12
+                    font.italic: true
+                    wrapMode: Text.WordWrap
+                }
+
+                SFText {
+                    visible: viewModel.isNodeSnapshotImporting
+                    //: settings tab, node snapshot import progress
+                    //% "Importing node snapshot: %1%"
+                    text: qsTrId("settings-import-node-snapshot-progress").arg(viewModel.nodeSnapshotImportProgress)
+                    color: Style.content_secondary
+                    font.pixelSize: 12
+                    font.italic: true
+                }
             }
 
             Item {
@@ -801,7 +913,7 @@ deploy the key at the node you trust completely."*/
                     Layout.fillWidth: true
                     radius: 10
                     color: Style.grayBg
-                    Layout.preferredHeight: viewModel.localNodeRun ? 460 : (nodeAddressError.visible ? 330 : 285)
+                    Layout.preferredHeight: viewModel.localNodeRun ? 560 : (nodeAddressError.visible ? 330 : 285)
 
                     ColumnLayout {
                         anchors.fill: parent
@@ -885,6 +997,60 @@ deploy the key at the node you trust completely."*/
                             }
                         }
 
+                        RowLayout {
+                            visible: viewModel.localNodeRun
+
+                            SFText {
+                                Layout.fillWidth: true;
+                                Layout.preferredWidth: 3
+                                //: settings tab, node section, CPU cores limit label
+                                //% "CPU cores"
+                                text: qsTrId("settings-local-node-cpu-cores")
+                                color: Style.content_secondary
+                                font.pixelSize: 14
+                            }
+
+                            CustomComboBox {
+                                id: nodeCpuCoresControl
+                                Layout.fillWidth: true
+                                Layout.preferredWidth: 7
+                                fontPixelSize: 14
+                                currentIndex: viewModel.nodeCpuCores
+                                model: {
+                                    //: settings tab, node section, no CPU cores limit
+                                    //% "All"
+                                    var cores = [qsTrId("settings-local-node-cpu-cores-all")];
+                                    for (var i = 1; i <= viewModel.coreAmount(); ++i) {
+                                        cores.push(i.toString());
+                                    }
+                                    return cores;
+                                }
+                                onActivated: {
+                                    viewModel.nodeCpuCores = nodeCpuCoresControl.currentIndex;
+                                }
+                            }
+                        }
+
+                        CustomSwitch {
+                            id: nodeLowPriority
+                            Layout.fillWidth: true
+                            visible: viewModel.localNodeRun
+                            //: settings tab, node section, lower CPU and disk priority of the integrated node
+                            //% "Low CPU and disk priority"
+                            text: qsTrId("settings-local-node-low-priority")
+                            font.pixelSize: 14
+                            checked: viewModel.nodeLowPriority
+                            onClicked: viewModel.nodeLowPriority = nodeLowPriority.checked
+                        }
+
+                        SFText {
+                            visible: viewModel.localNodeRun && text.length > 0
+                            text: viewModel.nodeResourceUsage
+                            color: Style.content_secondary
+                            font.pixelSize: 12
+                            font.italic: true
+                        }
+
                         GridLayout {
                             Layout.fillWidth: true
                             visible: !viewModel.localNodeRun
@@ -897,7 +1063,7 @@ deploy the key at the node you trust completely."*/
                                 text: qsTrId("settings-remote-node-address")
                                 color: Style.content_secondary
                                 font.pixelSize: 14
-                                wrapMode: Text.WordWrap
+                                wrapMode: Text.Wrap
                             }
 
                             ColumnLayout {
@@ -936,6 +1102,14 @@ deploy the key at the node you trust completely."*/
                                         text:           qsTrId("general-invalid-address")
                                         visible:        (!viewModel.isValidNodeAddress || !nodeAddress.acceptableInput)
                                     }
+
+                                    SFText {
+                                        color:          Style.content_secondary
+                                        font.pixelSize: 12
+                                        font.italic:    true
+                                        text:           viewModel.nodeLatency
+                                        visible:        viewModel.isValidNodeAddress && nodeAddress.acceptableInput && text.length > 0
+                                    }
                                 }
                             }
 
@@ -990,6 +1164,28 @@ deploy the key at the node you trust completely."*/
                             }
                         }
 
+                        CustomSwitch {
+                            id: nodeFailover
+                            Layout.fillWidth: true
+                            visible: !viewModel.localNodeRun
+                            //: settings tab, node section, switch to a default peer when the remote node fails
+                            //% "Switch to a default node when this one fails"
+                            text: qsTrId("settings-remote-node-failover")
+                            font.pixelSize: 14
+                            checked: viewModel.nodeFailover
+                            onClicked: viewModel.nodeFailover = nodeFailover.checked
+                        }
+
+                        SFText {
+                            visible: !viewModel.localNodeRun && viewModel.fallbackNode.length > 0
+                            //: settings tab, node section, the default node used while the remote node fails
+                            //% "Connected to the default node %1 instead"
+                            text: qsTrId("settings-remote-node-fallback").arg(viewModel.fallbackNode)
+                            color: Style.content_secondary
+                            font.pixelSize: 12
+                            font.italic: true
+                        }
+
                         SFText {
                             Layout.topMargin: 15
                             //: settings tab, node section, peers label
@@ -1157,7 +1353,7 @@ deploy the key at the node you trust completely."*/
                             textFormat: Text.RichText
                             color: Style.content_main
                             font.pixelSize: 14
-                            wrapMode: Text.WordWrap
+                            wrapMode: Text.Wrap
                             linkEnabled: true
                             onLinkActivated: {
                                 Utils.openExternalWithConfirmation(link);
@@ -1175,8 +1371,33 @@ deploy the key at the node you trust completely."*/
                             icon.source: "qrc:/assets/icon-save.svg"
                             palette.buttonText : "white"
                             palette.button: Style.background_button
+                            enabled: !viewModel.isReportInProgress
                             onClicked: viewModel.reportProblem()
                         }
+
+                        Row {
+                            Layout.topMargin: 10
+                            spacing: 10
+                            visible: viewModel.isReportInProgress
+                            SFText {
+                                //: settings tab, report problem section, logs archive progress
+                                //% "Saving wallet logs: %1%"
+                                text: qsTrId("settings-report-problem-progress").arg(viewModel.reportProgress)
+                                color: Style.content_secondary
+                                font.pixelSize: 14
+                            }
+                            SFText {
+                                text: qsTrId("general-cancel")
+                                color: Style.active
+                                font.pixelSize: 14
+                                MouseArea {
+                                    anchors.fill: parent
+                                    acceptedButtons: Qt.LeftButton
+                                    cursorShape: Qt.PointingHandCursor
+                                    onClicked: viewModel.cancelReport()
+                                }
+                            }
+                        }
                     }
                 }
             }
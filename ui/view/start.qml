@@ -156,6 +156,7 @@ Item
             id: start
             Rectangle
             {
+                property bool isStartPage: true
                 color: Style.background_main
 
                 Image {
@@ -1956,7 +1957,7 @@ Item
                                 //% "Start using your wallet"
                                 qsTrId("general-start-using");
                             icon.source: viewModel.isRecoveryMode ? "qrc:/assets/icon-restore-blue.svg" : "qrc:/assets/icon-next-blue.svg"
-                            enabled: nodePreferencesGroup.checkState != Qt.Unchecked
+                            enabled: nodePreferencesGroup.checkState != Qt.Unchecked && !viewModel.isWalletDBLoading
                             onClicked:{
                                 if (localNodeButton.checked) {
                                     if (portInput.text.trim().length === 0) {
@@ -2011,6 +2012,28 @@ Item
                             }
                         }
                     }
+                    Row {
+                        Layout.alignment: Qt.AlignHCenter
+                        Layout.topMargin: 20
+                        spacing: 10
+                        visible: viewModel.isWalletDBLoading
+                        SFText {
+                            font.pixelSize: 14
+                            color: Style.content_secondary
+                            text: viewModel.walletDBLoadingStage
+                        }
+                        SFText {
+                            font.pixelSize: 14
+                            color: Style.active
+                            text: qsTrId("general-cancel")
+                            MouseArea {
+                                anchors.fill: parent
+                                acceptedButtons: Qt.LeftButton
+                                cursorShape: Qt.PointingHandCursor
+                                onClicked: viewModel.cancelWalletDBLoading()
+                            }
+                        }
+                    }
                     Item {
                         Layout.fillHeight: true
                         Layout.minimumHeight: 67
@@ -2162,6 +2185,7 @@ Item
                                     id: btnCurrentWallet
                                     //% "Show my wallet"
                                     text: qsTrId("open-show-wallet-button")
+                                    enabled: !viewModel.isWalletDBLoading
                                     icon.source: "qrc:/assets/icon-wallet-small.svg"
                                     onClicked: {
                                         if(openPassword.text.length == 0)
@@ -2190,6 +2214,29 @@ Item
                                 }
                             }
 
+                            Row {
+                                Layout.alignment: Qt.AlignHCenter
+                                Layout.topMargin: 20
+                                spacing: 10
+                                visible: viewModel.isWalletDBLoading
+                                SFText {
+                                    font.pixelSize: 14
+                                    color: Style.content_secondary
+                                    text: viewModel.walletDBLoadingStage
+                                }
+                                SFText {
+                                    font.pixelSize: 14
+                                    color: Style.active
+                                    text: qsTrId("general-cancel")
+                                    MouseArea {
+                                        anchors.fill: parent
+                                        acceptedButtons: Qt.LeftButton
+                                        cursorShape: Qt.PointingHandCursor
+                                        onClicked: viewModel.cancelWalletDBLoading()
+                                    }
+                                }
+                            }
+
                             Item {
                                 Layout.alignment: Qt.AlignHCenter
                                 Layout.preferredHeight: 36
@@ -2316,6 +2363,16 @@ Item
                 startWizzardView.push(start);
             }
         }
+
+        Connections {
+            target: viewModel
+            // wallet DBs are searched in background, they can be found when the start page is already shown
+            onWalletDBpathsChanged: {
+                if (startWizzardView.depth == 1 && startWizzardView.currentItem.isStartPage && viewModel.isFindExistingWalletDB()) {
+                    startWizzardView.replace(migrate);
+                }
+            }
+        }
     }
 }
 
@@ -18,6 +18,8 @@
 #include <QClipboard>
 #include "model/app_model.h"
 #include "model/qr.h"
+#include "model/startup_tracer.h"
+#include "model/ui_log.h"
 
 using namespace std;
 using namespace hds;
@@ -33,6 +35,9 @@ namespace
             return lf > rt;
         return lf < rt;
     }
+
+    // idle items kept by the pools between refreshes
+    const size_t kMaxIdleItems = 16;
 }
 
 AddressItem::AddressItem(const hds::wallet::WalletAddress& address)
@@ -41,6 +46,11 @@ AddressItem::AddressItem(const hds::wallet::WalletAddress& address)
 
 }
 
+void AddressItem::reset(const hds::wallet::WalletAddress& address)
+{
+    m_walletAddress = address;
+}
+
 QString AddressItem::getAddress() const
 {
     return hdsui::toString(m_walletAddress.m_walletID);
@@ -103,6 +113,11 @@ ContactItem::ContactItem(const hds::wallet::WalletAddress& address)
 
 }
 
+void ContactItem::reset(const hds::wallet::WalletAddress& address)
+{
+    m_walletAddress = address;
+}
+
 QString ContactItem::getAddress() const
 {
     return hdsui::toString(m_walletAddress.m_walletID);
@@ -129,7 +144,10 @@ QString ContactItem::getIdentity() const
 
 AddressBookViewModel::AddressBookViewModel()
     : m_model{*AppModel::getInstance().getWallet()}
+    , m_contactsPool(this)
+    , m_addressesPool(this)
 {
+    STARTUP_TRACE_SPAN("AddressBookViewModel::AddressBookViewModel");
     connect(&m_model,
             SIGNAL(addressesChanged(bool, const std::vector<hds::wallet::WalletAddress>&)),
             SLOT(onAddresses(bool, const std::vector<hds::wallet::WalletAddress>&)));
@@ -140,6 +158,14 @@ AddressBookViewModel::AddressBookViewModel()
             SIGNAL(addressesChanged(hds::wallet::ChangeAction, const std::vector<hds::wallet::WalletAddress>&)),
             SLOT(onAddressesChanged(hds::wallet::ChangeAction, const std::vector<hds::wallet::WalletAddress>&)));
 
+    // show the last known addresses until the wallet reports them
+    const auto& snapshot = m_model.getSnapshot();
+    if (!snapshot.getAddresses(true).empty() || !snapshot.getAddresses(false).empty())
+    {
+        onAddresses(true, snapshot.getAddresses(true));
+        onAddresses(false, snapshot.getAddresses(false));
+    }
+
     getAddressesFromModel();
     m_model.getAsync()->getTransactions();
     startTimer(3 * 1000);
@@ -297,34 +323,42 @@ void AddressBookViewModel::onAddresses(bool own, const std::vector<hds::wallet::
 {
     if (own)
     {
-        m_activeAddresses.clear();
-        m_expiredAddresses.clear();
+        m_addressesPool.releaseAll(m_activeAddresses);
+        m_addressesPool.releaseAll(m_expiredAddresses);
 
         for (const auto& addr : addresses)
         {
             if (addr.isExpired())
             {
-                m_expiredAddresses.push_back(new AddressItem(addr));
+                m_expiredAddresses.push_back(m_addressesPool.acquire(addr));
             }
             else
             {
-                m_activeAddresses.push_back(new AddressItem(addr));
+                m_activeAddresses.push_back(m_addressesPool.acquire(addr));
             }
         }
 
+        m_addressesPool.trim(kMaxIdleItems);
+
         sortActiveAddresses();
         sortExpiredAddresses();
+
+        UI_LOG_DEBUG() << "Address book: " << m_addressesPool.allocated() << " address items allocated, " << m_addressesPool.idle() << " idle";
     }
     else
     {
-        m_contacts.clear();
+        m_contactsPool.releaseAll(m_contacts);
 
         for (const auto& addr : addresses)
         {
-            m_contacts.push_back(new ContactItem(addr));
+            m_contacts.push_back(m_contactsPool.acquire(addr));
         }
 
+        m_contactsPool.trim(kMaxIdleItems);
+
         sortContacts();
+
+        UI_LOG_DEBUG() << "Address book: " << m_contactsPool.allocated() << " contact items allocated, " << m_contactsPool.idle() << " idle";
     }
 }
 
@@ -21,6 +21,7 @@
 #include <QQmlListProperty>
 #include "wallet/core/wallet_db.h"
 #include "model/wallet_model.h"
+#include "viewmodel/helpers/object_pool.h"
 
 class AddressItem : public QObject
 {
@@ -37,6 +38,7 @@ public:
 
     AddressItem() = default;
     AddressItem(const hds::wallet::WalletAddress&);
+    void reset(const hds::wallet::WalletAddress&);
 
     QString getAddress() const;
     QString getName() const;
@@ -65,6 +67,7 @@ class ContactItem : public QObject
 public:
     ContactItem() = default;
     ContactItem(const hds::wallet::WalletAddress&);
+    void reset(const hds::wallet::WalletAddress&);
 
     QString getAddress() const;
     QString getName() const;
@@ -159,6 +162,8 @@ private:
 
 private:
     WalletModel& m_model;
+    ObjectPool<ContactItem> m_contactsPool;
+    ObjectPool<AddressItem> m_addressesPool;
     QList<ContactItem*> m_contacts;
     QList<AddressItem*> m_activeAddresses;
     QList<AddressItem*> m_expiredAddresses;
@@ -20,11 +20,15 @@
 
 using namespace hds::wallet;
 
-SwapOfferItem::SwapOfferItem(const SwapOffer& offer,
-                             const QDateTime& timeExpiration)
+SwapOfferItem::SwapOfferItem(const SwapOffer& offer)
     : m_offer{offer}
     , m_isHdsSide{offer.isHdsSide()}
-    , m_timeExpiration{timeExpiration} {}
+{
+    // Offers without publisherID don't pass validation
+    auto peerResponseTime = offer.peerResponseHeight();
+    auto minHeight = offer.minHeight();
+    m_expiresHeight = (peerResponseTime && minHeight) ? minHeight + peerResponseTime : 0;
+}
 
 bool SwapOfferItem::operator==(const SwapOfferItem& other) const
 {
@@ -38,11 +42,26 @@ auto SwapOfferItem::timeCreated() const -> QDateTime
     return datetime;
 }
 
-auto SwapOfferItem::timeExpiration() const -> QDateTime
+auto SwapOfferItem::timeExpiration(hds::Height currentHeight, hds::Timestamp currentHeightTime) const -> QDateTime
 {
+    if (!currentHeight || !m_expiresHeight)
+    {
+        return QDateTime();
+    }
+
+    if (m_timeExpirationHeight != currentHeight)
+    {
+        m_timeExpiration = hdsui::CalculateExpiresTime(currentHeightTime, currentHeight, m_expiresHeight);
+        m_timeExpirationHeight = currentHeight;
+    }
     return m_timeExpiration;
 }
 
+auto SwapOfferItem::expiresHeight() const -> hds::Height
+{
+    return m_expiresHeight;
+}
+
 auto SwapOfferItem::rawAmountSend() const -> hds::Amount
 {
     return isSendHds() ? m_offer.amountHds() : m_offer.amountSwapCoin();
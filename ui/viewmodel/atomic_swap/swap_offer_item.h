@@ -27,11 +27,12 @@ class SwapOfferItem : public QObject
 
 public:
     SwapOfferItem() = default;
-    SwapOfferItem(const SwapOffer& offer, const QDateTime& timeExpiration);
+    SwapOfferItem(const SwapOffer& offer);
     bool operator==(const SwapOfferItem& other) const;
 
     auto timeCreated() const -> QDateTime;
-    auto timeExpiration() const -> QDateTime;
+    auto timeExpiration(hds::Height currentHeight, hds::Timestamp currentHeightTime) const -> QDateTime;
+    auto expiresHeight() const -> hds::Height;
     auto amountSend() const -> QString;
     auto amountReceive() const -> QString;
     auto rate() const -> QString;
@@ -44,13 +45,16 @@ public:
     auto getTxParameters() const -> TxParameters;
     auto getTxID() const -> TxID;
     auto getSwapCoinName() const -> QString;
+    auto getSwapCoinType() const -> hdsui::Currencies;
 
 signals:
 
 private:
-    auto getSwapCoinType() const -> hdsui::Currencies;
-
     hds::wallet::SwapOffer m_offer;          /// TxParameters subclass
     bool m_isHdsSide;          /// pay hds to receive other coin
-    QDateTime m_timeExpiration;
+    hds::Height m_expiresHeight = 0;      /// 0 if offer has no expiration data
+
+    // expiration time is calculated on demand and cached for the last height
+    mutable hds::Height m_timeExpirationHeight = 0;
+    mutable QDateTime m_timeExpiration;
 };
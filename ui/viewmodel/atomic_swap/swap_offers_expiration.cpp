@@ -0,0 +1,112 @@
+// Copyright 2019 The Hds Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "swap_offers_expiration.h"
+
+#include <cassert>
+
+SwapOffersExpirationWheel::SwapOffersExpirationWheel(size_t slotsCount)
+    : m_slots(slotsCount)
+{
+    assert(slotsCount > 0);
+}
+
+void SwapOffersExpirationWheel::clear()
+{
+    for (auto& slot : m_slots)
+    {
+        slot.clear();
+    }
+    m_scheduled.clear();
+}
+
+bool SwapOffersExpirationWheel::schedule(const OfferPtr& offer)
+{
+    auto expiresHeight = offer->expiresHeight();
+    if (!expiresHeight)
+    {
+        // nothing to track
+        return true;
+    }
+
+    if (m_currentHeight && expiresHeight <= m_currentHeight)
+    {
+        return false;
+    }
+
+    m_scheduled[offer->getTxID()] = expiresHeight;
+    m_slots[expiresHeight % m_slots.size()].push_back({ expiresHeight, offer });
+    return true;
+}
+
+void SwapOffersExpirationWheel::cancel(const TxID& txID)
+{
+    // the timer itself is removed when its slot is visited
+    m_scheduled.erase(txID);
+}
+
+std::vector<SwapOffersExpirationWheel::OfferPtr> SwapOffersExpirationWheel::advance(hds::Height currentHeight)
+{
+    std::vector<OfferPtr> expired;
+    if (currentHeight <= m_currentHeight)
+    {
+        return expired;
+    }
+
+    if (!m_currentHeight || currentHeight - m_currentHeight >= m_slots.size())
+    {
+        // the first height or a long jump, every slot may contain expired offers
+        for (auto& slot : m_slots)
+        {
+            processSlot(slot, currentHeight, expired);
+        }
+    }
+    else
+    {
+        for (auto height = m_currentHeight + 1; height <= currentHeight; ++height)
+        {
+            processSlot(m_slots[height % m_slots.size()], currentHeight, expired);
+        }
+    }
+
+    m_currentHeight = currentHeight;
+    return expired;
+}
+
+void SwapOffersExpirationWheel::processSlot(std::vector<Timer>& slot, hds::Height currentHeight, std::vector<OfferPtr>& expired)
+{
+    size_t i = 0;
+    while (i < slot.size())
+    {
+        auto& timer = slot[i];
+        auto it = m_scheduled.find(timer.offer->getTxID());
+        bool isCancelled = it == m_scheduled.end() || it->second != timer.expiresHeight;
+
+        if (!isCancelled && timer.expiresHeight > currentHeight)
+        {
+            // one of the next rounds
+            ++i;
+            continue;
+        }
+
+        if (!isCancelled)
+        {
+            expired.push_back(timer.offer);
+            m_scheduled.erase(it);
+        }
+
+        std::swap(timer, slot.back());
+        slot.pop_back();
+    }
+}
@@ -0,0 +1,54 @@
+// Copyright 2019 The Hds Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <vector>
+#include "swap_offer_item.h"
+
+/// Hashed timing wheel of swap offers keyed by expiration height.
+/// Every new block visits only the slots of the passed heights,
+/// cancelled offers are dropped lazily when their slot is visited.
+class SwapOffersExpirationWheel
+{
+public:
+    using OfferPtr = std::shared_ptr<SwapOfferItem>;
+
+    explicit SwapOffersExpirationWheel(size_t slotsCount = 1024);
+
+    /// Remove all offers, current height is kept
+    void clear();
+
+    /// Return false if the offer is already expired
+    bool schedule(const OfferPtr& offer);
+    void cancel(const TxID& txID);
+
+    /// Return offers expired up to the given height
+    std::vector<OfferPtr> advance(hds::Height currentHeight);
+
+private:
+    struct Timer
+    {
+        hds::Height expiresHeight;
+        OfferPtr offer;
+    };
+
+    void processSlot(std::vector<Timer>& slot, hds::Height currentHeight, std::vector<OfferPtr>& expired);
+
+    std::vector<std::vector<Timer>> m_slots;
+    std::map<TxID, hds::Height> m_scheduled;
+    hds::Height m_currentHeight = 0;
+};
@@ -0,0 +1,252 @@
+// Copyright 2019 The Hds Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "swap_offers_fit_index.h"
+
+#include <algorithm>
+
+namespace
+{
+    hds::Amount getHdsAmount(const SwapOfferItem& offer)
+    {
+        return offer.isSendHds() ? offer.rawAmountSend() : offer.rawAmountReceive();
+    }
+
+    hds::Amount getSwapCoinAmount(const SwapOfferItem& offer)
+    {
+        return offer.isSendHds() ? offer.rawAmountReceive() : offer.rawAmountSend();
+    }
+}  // namespace
+
+bool SwapOffersFitIndex::Changes::empty() const
+{
+    return added.empty() && removed.empty();
+}
+
+hds::Amount SwapOffersFitIndex::CoinState::getAvailable() const
+{
+    return isConnected ? available : 0;
+}
+
+SwapOffersFitIndex::SwapOffersFitIndex()
+{
+    m_coins.emplace(hdsui::Currencies::Bitcoin, CoinState());
+    m_coins.emplace(hdsui::Currencies::Litecoin, CoinState());
+    m_coins.emplace(hdsui::Currencies::Qtum, CoinState());
+}
+
+std::vector<SwapOffersFitIndex::OfferPtr> SwapOffersFitIndex::reset(const std::vector<OfferPtr>& offers)
+{
+    for (auto& coin : m_coins)
+    {
+        coin.second.sendHds.clear();
+        coin.second.receiveHds.clear();
+    }
+    m_entries.clear();
+    m_fitOffers.clear();
+
+    return insert(offers);
+}
+
+std::vector<SwapOffersFitIndex::OfferPtr> SwapOffersFitIndex::insert(const std::vector<OfferPtr>& offers)
+{
+    std::vector<OfferPtr> fitOffers;
+    fitOffers.reserve(offers.size());
+
+    for (const auto& offer : offers)
+    {
+        if (insertOffer(offer))
+        {
+            fitOffers.push_back(offer);
+        }
+    }
+    return fitOffers;
+}
+
+std::vector<SwapOffersFitIndex::OfferPtr> SwapOffersFitIndex::getFitOffers() const
+{
+    std::vector<OfferPtr> fitOffers;
+    fitOffers.reserve(m_fitOffers.size());
+
+    for (const auto& p : m_fitOffers)
+    {
+        fitOffers.push_back(p.second);
+    }
+    return fitOffers;
+}
+
+std::vector<SwapOffersFitIndex::OfferPtr> SwapOffersFitIndex::remove(const std::vector<OfferPtr>& offers)
+{
+    std::vector<OfferPtr> fitOffers;
+
+    for (const auto& offer : offers)
+    {
+        const auto txID = offer->getTxID();
+
+        auto entryIt = m_entries.find(txID);
+        if (entryIt != m_entries.end())
+        {
+            const auto& entry = entryIt->second;
+            auto& coin = m_coins[entry.coin];
+            auto& bucket = entry.isSendHds ? coin.sendHds : coin.receiveHds;
+            auto range = bucket.equal_range(entry.key);
+            auto it = std::find_if(range.first, range.second, [&txID](const auto& p)
+            {
+                return p.second->getTxID() == txID;
+            });
+            if (it != range.second)
+            {
+                bucket.erase(it);
+            }
+            m_entries.erase(entryIt);
+        }
+
+        auto fitIt = m_fitOffers.find(txID);
+        if (fitIt != m_fitOffers.end())
+        {
+            fitOffers.push_back(fitIt->second);
+            m_fitOffers.erase(fitIt);
+        }
+    }
+    return fitOffers;
+}
+
+SwapOffersFitIndex::Changes SwapOffersFitIndex::setHdsAvailable(hds::Amount available)
+{
+    Changes changes;
+    if (available == m_hdsAvailable)
+    {
+        return changes;
+    }
+
+    auto lower = std::min(available, m_hdsAvailable);
+    auto upper = std::max(available, m_hdsAvailable);
+    m_hdsAvailable = available;
+
+    for (const auto& p : m_coins)
+    {
+        const auto& coin = p.second;
+
+        // only offers with hds amount between the old and the new balance could change their state
+        updateRange(coin.sendHds.upper_bound(lower), coin.sendHds.upper_bound(upper), changes);
+
+        // the hds amount is not the key here, check all offers which fit the swap coin balance
+        updateRange(coin.receiveHds.begin(), coin.receiveHds.upper_bound(coin.getAvailable()), changes);
+    }
+    return changes;
+}
+
+SwapOffersFitIndex::Changes SwapOffersFitIndex::setSwapCoinBalance(hdsui::Currencies coinType, hds::Amount available, bool isConnected)
+{
+    Changes changes;
+    auto it = m_coins.find(coinType);
+    if (it == m_coins.end())
+    {
+        return changes;
+    }
+
+    auto& coin = it->second;
+    auto oldAvailable = coin.getAvailable();
+    bool wasConnected = coin.isConnected;
+
+    coin.available = available;
+    coin.isConnected = isConnected;
+
+    if (wasConnected != isConnected)
+    {
+        updateRange(coin.sendHds.begin(), coin.sendHds.upper_bound(m_hdsAvailable), changes);
+    }
+
+    auto newAvailable = coin.getAvailable();
+    if (newAvailable != oldAvailable)
+    {
+        auto lower = std::min(newAvailable, oldAvailable);
+        auto upper = std::max(newAvailable, oldAvailable);
+        updateRange(coin.receiveHds.upper_bound(lower), coin.receiveHds.upper_bound(upper), changes);
+    }
+    return changes;
+}
+
+bool SwapOffersFitIndex::isFit(const SwapOfferItem& offer) const
+{
+    if (offer.isOwnOffer())
+        return true;
+
+    auto it = m_coins.find(offer.getSwapCoinType());
+    if (it == m_coins.end())
+        return false;
+
+    if (getHdsAmount(offer) > m_hdsAvailable)
+        return false;
+
+    const auto& coin = it->second;
+    return offer.isSendHds() ? coin.isConnected : getSwapCoinAmount(offer) <= coin.getAvailable();
+}
+
+bool SwapOffersFitIndex::insertOffer(const OfferPtr& offer)
+{
+    const auto txID = offer->getTxID();
+    if (m_entries.find(txID) != m_entries.end() || m_fitOffers.find(txID) != m_fitOffers.end())
+    {
+        return false;
+    }
+
+    if (!offer->isOwnOffer())
+    {
+        auto it = m_coins.find(offer->getSwapCoinType());
+        if (it == m_coins.end())
+        {
+            return false;
+        }
+
+        Entry entry;
+        entry.coin = it->first;
+        entry.isSendHds = offer->isSendHds();
+        entry.key = entry.isSendHds ? getHdsAmount(*offer) : getSwapCoinAmount(*offer);
+
+        auto& bucket = entry.isSendHds ? it->second.sendHds : it->second.receiveHds;
+        bucket.emplace(entry.key, offer);
+        m_entries.emplace(txID, entry);
+    }
+
+    if (!isFit(*offer))
+    {
+        return false;
+    }
+
+    m_fitOffers.emplace(txID, offer);
+    return true;
+}
+
+void SwapOffersFitIndex::updateRange(Bucket::const_iterator begin, Bucket::const_iterator end, Changes& changes)
+{
+    for (auto it = begin; it != end; ++it)
+    {
+        const auto& offer = it->second;
+        const auto txID = offer->getTxID();
+        bool isFitNow = isFit(*offer);
+        auto fitIt = m_fitOffers.find(txID);
+
+        if (isFitNow && fitIt == m_fitOffers.end())
+        {
+            m_fitOffers.emplace(txID, offer);
+            changes.added.push_back(offer);
+        }
+        else if (!isFitNow && fitIt != m_fitOffers.end())
+        {
+            m_fitOffers.erase(fitIt);
+            changes.removed.push_back(offer);
+        }
+    }
+}
@@ -0,0 +1,79 @@
+// Copyright 2019 The Hds Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <vector>
+#include "swap_offer_item.h"
+
+/// Index of swap offers which fit the current balances.
+/// Offers are kept per swap coin and direction, ordered by the amount required from us,
+/// so a balance change re-checks only the offers between the old and the new balance.
+class SwapOffersFitIndex
+{
+public:
+    using OfferPtr = std::shared_ptr<SwapOfferItem>;
+
+    struct Changes
+    {
+        std::vector<OfferPtr> added;
+        std::vector<OfferPtr> removed;
+
+        bool empty() const;
+    };
+
+    SwapOffersFitIndex();
+
+    /// Return offers which fit the balance
+    std::vector<OfferPtr> reset(const std::vector<OfferPtr>& offers);
+    std::vector<OfferPtr> insert(const std::vector<OfferPtr>& offers);
+    std::vector<OfferPtr> getFitOffers() const;
+
+    /// Return offers which were fit the balance
+    std::vector<OfferPtr> remove(const std::vector<OfferPtr>& offers);
+
+    Changes setHdsAvailable(hds::Amount available);
+    Changes setSwapCoinBalance(hdsui::Currencies coin, hds::Amount available, bool isConnected);
+
+private:
+    using Bucket = std::multimap<hds::Amount, OfferPtr>;
+
+    struct CoinState
+    {
+        hds::Amount available = 0;
+        bool isConnected = false;
+        Bucket sendHds;      /// keyed by hds amount
+        Bucket receiveHds;   /// keyed by swap coin amount
+
+        hds::Amount getAvailable() const;
+    };
+
+    struct Entry
+    {
+        hdsui::Currencies coin;
+        bool isSendHds;
+        hds::Amount key;
+    };
+
+    bool isFit(const SwapOfferItem& offer) const;
+    bool insertOffer(const OfferPtr& offer);
+    void updateRange(Bucket::const_iterator begin, Bucket::const_iterator end, Changes& changes);
+
+    hds::Amount m_hdsAvailable = 0;
+    std::map<hdsui::Currencies, CoinState> m_coins;
+    std::map<TxID, Entry> m_entries;
+    std::map<TxID, OfferPtr> m_fitOffers;
+};
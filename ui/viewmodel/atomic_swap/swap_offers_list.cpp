@@ -75,9 +75,9 @@ QVariant SwapOffersList::data(const QModelIndex &index, int role) const
             return value->rate();
 
         case Roles::Expiration:
-            return value->timeExpiration().toString(Qt::SystemLocaleShortDate);
+            return value->timeExpiration(m_currentHeight, m_currentHeightTime).toString(Qt::SystemLocaleShortDate);
         case Roles::ExpirationSort:
-            return value->timeExpiration();
+            return value->timeExpiration(m_currentHeight, m_currentHeightTime);
 
         case Roles::SwapCoin:
             return value->getSwapCoinName();
@@ -104,3 +104,21 @@ QVariant SwapOffersList::data(const QModelIndex &index, int role) const
             return QVariant();
     }
 }
+
+void SwapOffersList::setCurrentHeight(hds::Height height, hds::Timestamp heightTime)
+{
+    if (m_currentHeight == height && m_currentHeightTime == heightTime)
+    {
+        return;
+    }
+
+    m_currentHeight = height;
+    m_currentHeightTime = heightTime;
+
+    if (!m_list.empty())
+    {
+        // views request expiration only for the visible rows
+        emit dataChanged(index(0), index(m_list.size() - 1),
+            { static_cast<int>(Roles::Expiration), static_cast<int>(Roles::ExpirationSort) });
+    }
+}
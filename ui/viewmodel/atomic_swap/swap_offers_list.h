@@ -47,4 +47,11 @@ public:
 
     QVariant data(const QModelIndex &index, int role) const override;
     QHash<int, QByteArray> roleNames() const override;
+
+    /// Expiration time of the offers depends on the current height
+    void setCurrentHeight(hds::Height height, hds::Timestamp heightTime);
+
+private:
+    hds::Height m_currentHeight = 0;
+    hds::Timestamp m_currentHeightTime = 0;
 };
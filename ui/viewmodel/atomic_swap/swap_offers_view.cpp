@@ -15,6 +15,8 @@
 #include <qdebug.h>
 #include "model/app_model.h"
 #include "model/settings.h"
+#include "model/startup_tracer.h"
+#include "model/ui_log.h"
 #include "swap_offers_view.h"
 #include "viewmodel/ui_helpers.h"
 
@@ -57,8 +59,12 @@ SwapOffersViewModel::SwapOffersViewModel()
     :   m_walletModel{*AppModel::getInstance().getWallet()},
         m_btcClient(AppModel::getInstance().getBitcoinClient()),
         m_ltcClient(AppModel::getInstance().getLitecoinClient()),
-        m_qtumClient(AppModel::getInstance().getQtumClient())
+        m_qtumClient(AppModel::getInstance().getQtumClient()),
+        m_btcOrderBook(hdsui::Currencies::Bitcoin),
+        m_ltcOrderBook(hdsui::Currencies::Litecoin),
+        m_qtumOrderBook(hdsui::Currencies::Qtum)
 {
+    STARTUP_TRACE_SPAN("SwapOffersViewModel::SwapOffersViewModel");
     connect(&m_walletModel, SIGNAL(availableChanged()), this, SIGNAL(hdsAvailableChanged()));
     connect(&m_walletModel,
             SIGNAL(transactionsChanged(hds::wallet::ChangeAction, const std::vector<hds::wallet::TxDescription>&)),
@@ -67,6 +73,7 @@ SwapOffersViewModel::SwapOffersViewModel()
     connect(&m_walletModel,
             SIGNAL(swapOffersChanged(hds::wallet::ChangeAction, const std::vector<hds::wallet::SwapOffer>&)),
             SLOT(onSwapOffersDataModelChanged(hds::wallet::ChangeAction, const std::vector<hds::wallet::SwapOffer>&)));
+    connect(&m_walletModel, SIGNAL(stateIDChanged()), SLOT(onCurrentHeightChanged()));
 
     connect(m_btcClient.get(),  SIGNAL(balanceChanged()), this, SIGNAL(btcAvailableChanged()));
     connect(m_ltcClient.get(), SIGNAL(balanceChanged()), this, SIGNAL(ltcAvailableChanged()));
@@ -75,7 +82,12 @@ SwapOffersViewModel::SwapOffersViewModel()
     connect(m_ltcClient.get(), SIGNAL(statusChanged()), this, SIGNAL(ltcOKChanged()));
     connect(m_qtumClient.get(), SIGNAL(statusChanged()), this, SIGNAL(qtumOKChanged()));
 
+    m_btcClient->addActiveView();
+    m_ltcClient->addActiveView();
+    m_qtumClient->addActiveView();
+
     monitorAllOffersFitBalance();
+    onCurrentHeightChanged();
 
     m_walletModel.getAsync()->getSwapOffers();
     m_walletModel.getAsync()->getTransactions();
@@ -89,6 +101,13 @@ SwapOffersViewModel::SwapOffersViewModel()
     m_blocksPerHour.emplace(AtomicSwapCoin::Qtum, m_qtumClient->GetSettings().GetBlocksPerHour());
 }
 
+SwapOffersViewModel::~SwapOffersViewModel()
+{
+    m_btcClient->removeActiveView();
+    m_ltcClient->removeActiveView();
+    m_qtumClient->removeActiveView();
+}
+
 QAbstractItemModel* SwapOffersViewModel::getAllOffers()
 {
     return &m_offersList;
@@ -99,6 +118,21 @@ QAbstractItemModel* SwapOffersViewModel::getAllOffersFitBalance()
     return &m_offersListFitBalance;
 }
 
+SwapOrderBook* SwapOffersViewModel::getBtcOrderBook()
+{
+    return &m_btcOrderBook;
+}
+
+SwapOrderBook* SwapOffersViewModel::getLtcOrderBook()
+{
+    return &m_ltcOrderBook;
+}
+
+SwapOrderBook* SwapOffersViewModel::getQtumOrderBook()
+{
+    return &m_qtumOrderBook;
+}
+
 QString SwapOffersViewModel::hdsAvailable() const
 {
     return hdsui::AmountToUIString(m_walletModel.getAvailable());
@@ -159,7 +193,7 @@ void SwapOffersViewModel::cancelOffer(const QVariant& variantTxID)
     if (!variantTxID.isNull() && variantTxID.isValid())
     {
         auto txId = variantTxID.value<hds::wallet::TxID>();
-        LOG_INFO() << txId << " Cancel offer";
+        UI_LOG_INFO() << txId << " Cancel offer";
         m_walletModel.getAsync()->cancelTx(txId);
     }
 }
@@ -307,23 +341,26 @@ void SwapOffersViewModel::onSwapOffersDataModelChanged(hds::wallet::ChangeAction
     vector<shared_ptr<SwapOfferItem>> modifiedOffers;
     modifiedOffers.reserve(offers.size());
 
-    for (const auto& offer : offers)
+    if (action == ChangeAction::Reset)
     {
+        m_offersExpiration.clear();
+    }
 
-        // Offers without publisherID don't pass validation
-        auto peerResponseTime = offer.peerResponseHeight();
-        auto minHeight = offer.minHeight();
-        auto currentHeight = m_walletModel.getCurrentHeight();
-        auto currentHeightTimestamp = m_walletModel.getCurrentHeightTimestamp();
+    for (const auto& offer : offers)
+    {
+        auto item = make_shared<SwapOfferItem>(offer);
 
-        QDateTime timeExpiration;
-        if (currentHeight && peerResponseTime && minHeight)
+        if (action == ChangeAction::Removed)
         {
-            auto expiresHeight = minHeight + peerResponseTime;
-            timeExpiration = hdsui::CalculateExpiresTime(currentHeightTimestamp, currentHeight, expiresHeight);
+            m_offersExpiration.cancel(item->getTxID());
+        }
+        else if (!m_offersExpiration.schedule(item))
+        {
+            // already expired, don't show it
+            continue;
         }
 
-        modifiedOffers.push_back(make_shared<SwapOfferItem>(offer, timeExpiration));
+        modifiedOffers.push_back(item);
     }
 
     switch (action)
@@ -332,6 +369,7 @@ void SwapOffersViewModel::onSwapOffersDataModelChanged(hds::wallet::ChangeAction
             {
                 m_offersList.reset(modifiedOffers);
                 resetAllOffersFitBalance();
+                resetOrderBooks(modifiedOffers);
                 break;
             }
 
@@ -339,6 +377,7 @@ void SwapOffersViewModel::onSwapOffersDataModelChanged(hds::wallet::ChangeAction
             {
                 m_offersList.insert(modifiedOffers);
                 insertAllOffersFitBalance(modifiedOffers);
+                insertOrderBooks(modifiedOffers);
                 break;
             }
 
@@ -351,6 +390,7 @@ void SwapOffersViewModel::onSwapOffersDataModelChanged(hds::wallet::ChangeAction
                 }
                 m_offersList.remove(modifiedOffers);
                 removeAllOffersFitBalance(modifiedOffers);
+                removeOrderBooks(modifiedOffers);
                 break;
             }
         
@@ -365,16 +405,71 @@ void SwapOffersViewModel::onSwapOffersDataModelChanged(hds::wallet::ChangeAction
 void SwapOffersViewModel::resetAllOffersFitBalance()
 {
     auto offersCount = m_offersList.rowCount();
-    std::vector<std::shared_ptr<SwapOfferItem>> offersListFitBalance;
-    offersListFitBalance.reserve(offersCount);
+    std::vector<std::shared_ptr<SwapOfferItem>> offers;
+    offers.reserve(offersCount);
 
     for(int i = 0; i < offersCount; ++i)
     {
-        const auto&it = m_offersList.get(i);
-        if (isOfferFitBalance(*it))
-            offersListFitBalance.push_back(it);
+        offers.push_back(m_offersList.get(i));
     }
-    m_offersListFitBalance.reset(offersListFitBalance);
+    m_offersListFitBalance.reset(m_offersFitIndex.reset(offers));
+    emit allOffersFitBalanceChanged();
+}
+
+void SwapOffersViewModel::onCurrentHeightChanged()
+{
+    auto currentHeight = m_walletModel.getCurrentHeight();
+    auto currentHeightTime = m_walletModel.getCurrentHeightTimestamp();
+    m_offersList.setCurrentHeight(currentHeight, currentHeightTime);
+    m_offersListFitBalance.setCurrentHeight(currentHeight, currentHeightTime);
+
+    auto expiredOffers = m_offersExpiration.advance(currentHeight);
+    if (expiredOffers.empty())
+    {
+        return;
+    }
+
+    for (const auto& offer : expiredOffers)
+    {
+        emit offerRemovedFromTable(QVariant::fromValue(offer->getTxID()));
+    }
+    m_offersList.remove(expiredOffers);
+    removeAllOffersFitBalance(expiredOffers);
+    removeOrderBooks(expiredOffers);
+    emit allOffersChanged();
+}
+
+void SwapOffersViewModel::onHdsAvailableChanged()
+{
+    applyFitBalanceChanges(m_offersFitIndex.setHdsAvailable(m_walletModel.getAvailable()));
+}
+
+void SwapOffersViewModel::onBtcBalanceChanged()
+{
+    applyFitBalanceChanges(m_offersFitIndex.setSwapCoinBalance(
+        hdsui::Currencies::Bitcoin, m_btcClient->getAvailable(), btcOK()));
+}
+
+void SwapOffersViewModel::onLtcBalanceChanged()
+{
+    applyFitBalanceChanges(m_offersFitIndex.setSwapCoinBalance(
+        hdsui::Currencies::Litecoin, m_ltcClient->getAvailable(), ltcOK()));
+}
+
+void SwapOffersViewModel::onQtumBalanceChanged()
+{
+    applyFitBalanceChanges(m_offersFitIndex.setSwapCoinBalance(
+        hdsui::Currencies::Qtum, m_qtumClient->getAvailable(), qtumOK()));
+}
+
+void SwapOffersViewModel::applyFitBalanceChanges(const SwapOffersFitIndex::Changes& changes)
+{
+    if (changes.empty())
+    {
+        return;
+    }
+    m_offersListFitBalance.remove(changes.removed);
+    m_offersListFitBalance.insert(changes.added);
     emit allOffersFitBalanceChanged();
 }
 
@@ -411,83 +506,58 @@ bool SwapOffersViewModel::hasQtumTx() const
 
 void SwapOffersViewModel::monitorAllOffersFitBalance()
 {
-    connect(this, SIGNAL(hdsAvailableChanged()), SLOT(resetAllOffersFitBalance()));
-    connect(this, SIGNAL(btcAvailableChanged()), SLOT(resetAllOffersFitBalance()));
-    connect(this, SIGNAL(ltcAvailableChanged()), SLOT(resetAllOffersFitBalance()));
-    connect(this, SIGNAL(qtumAvailableChanged()), SLOT(resetAllOffersFitBalance()));
-    connect(this, SIGNAL(btcOKChanged()), SLOT(resetAllOffersFitBalance()));
-    connect(this, SIGNAL(ltcOKChanged()), SLOT(resetAllOffersFitBalance()));
-    connect(this, SIGNAL(qtumOKChanged()), SLOT(resetAllOffersFitBalance()));
-}
-
-bool SwapOffersViewModel::isOfferFitBalance(const SwapOfferItem& offer)
-{
-    if (offer.isOwnOffer())
-        return true;
+    m_offersFitIndex.setHdsAvailable(m_walletModel.getAvailable());
+    m_offersFitIndex.setSwapCoinBalance(hdsui::Currencies::Bitcoin, m_btcClient->getAvailable(), btcOK());
+    m_offersFitIndex.setSwapCoinBalance(hdsui::Currencies::Litecoin, m_ltcClient->getAvailable(), ltcOK());
+    m_offersFitIndex.setSwapCoinBalance(hdsui::Currencies::Qtum, m_qtumClient->getAvailable(), qtumOK());
 
-    bool isSendHds = offer.isSendHds();
-
-    auto hdsOfferAmount =
-        isSendHds ? offer.rawAmountSend() : offer.rawAmountReceive();
-    if (hdsOfferAmount > m_walletModel.getAvailable())
-        return false;
-    
-    auto swapCoinOfferAmount =
-        isSendHds ? offer.rawAmountReceive() : offer.rawAmountSend();
-    auto swapCoinName = offer.getSwapCoinName();
-
-    
-    if (swapCoinName == toString(hdsui::Currencies::Bitcoin))
-    {
-        auto myBtcAmount = btcOK() ? m_btcClient->getAvailable() : 0;
-        return isSendHds ? btcOK() : swapCoinOfferAmount <= myBtcAmount;
-    } 
-    else if (swapCoinName == toString(hdsui::Currencies::Litecoin))
-    {
-        auto myLtcAmount = ltcOK() ? m_ltcClient->getAvailable() : 0;
-        return isSendHds ? ltcOK() : swapCoinOfferAmount <= myLtcAmount;
-    }
-    else if (swapCoinName == toString(hdsui::Currencies::Qtum))
-    {
-        auto myQtumAmount = qtumOK() ? m_qtumClient->getAvailable() : 0;
-        return isSendHds ? qtumOK() : swapCoinOfferAmount <= myQtumAmount;
-    }
-    
-    return false;
+    connect(this, SIGNAL(hdsAvailableChanged()), SLOT(onHdsAvailableChanged()));
+    connect(this, SIGNAL(btcAvailableChanged()), SLOT(onBtcBalanceChanged()));
+    connect(this, SIGNAL(ltcAvailableChanged()), SLOT(onLtcBalanceChanged()));
+    connect(this, SIGNAL(qtumAvailableChanged()), SLOT(onQtumBalanceChanged()));
+    connect(this, SIGNAL(btcOKChanged()), SLOT(onBtcBalanceChanged()));
+    connect(this, SIGNAL(ltcOKChanged()), SLOT(onLtcBalanceChanged()));
+    connect(this, SIGNAL(qtumOKChanged()), SLOT(onQtumBalanceChanged()));
 }
 
 void SwapOffersViewModel::insertAllOffersFitBalance(
     const std::vector<std::shared_ptr<SwapOfferItem>>& offers)
 {
-    std::vector<std::shared_ptr<SwapOfferItem>> fitBalanceOffers;
-    fitBalanceOffers.reserve(offers.size());
-
-    std::copy_if(offers.begin(), offers.end(),
-                 std::back_inserter(fitBalanceOffers),
-                 [this] (const std::shared_ptr<SwapOfferItem>& it)
-                 {
-                     return isOfferFitBalance(*it);
-                 });
-    m_offersListFitBalance.insert(fitBalanceOffers);
+    m_offersListFitBalance.insert(m_offersFitIndex.insert(offers));
     emit allOffersFitBalanceChanged();
 }
 
 void SwapOffersViewModel::removeAllOffersFitBalance(
     const std::vector<std::shared_ptr<SwapOfferItem>>& offers)
 {
-    std::vector<std::shared_ptr<SwapOfferItem>> fitBalanceOffers;
-    fitBalanceOffers.reserve(offers.size());
-
-    std::copy_if(offers.begin(), offers.end(),
-                 std::back_inserter(fitBalanceOffers),
-                 [this] (const std::shared_ptr<SwapOfferItem>& it)
-                 {
-                     return isOfferFitBalance(*it);
-                 });
-    m_offersListFitBalance.remove(fitBalanceOffers);
+    m_offersListFitBalance.remove(m_offersFitIndex.remove(offers));
     emit allOffersFitBalanceChanged();    
 }
 
+void SwapOffersViewModel::resetOrderBooks(
+    const std::vector<std::shared_ptr<SwapOfferItem>>& offers)
+{
+    m_btcOrderBook.reset(offers);
+    m_ltcOrderBook.reset(offers);
+    m_qtumOrderBook.reset(offers);
+}
+
+void SwapOffersViewModel::insertOrderBooks(
+    const std::vector<std::shared_ptr<SwapOfferItem>>& offers)
+{
+    m_btcOrderBook.insert(offers);
+    m_ltcOrderBook.insert(offers);
+    m_qtumOrderBook.insert(offers);
+}
+
+void SwapOffersViewModel::removeOrderBooks(
+    const std::vector<std::shared_ptr<SwapOfferItem>>& offers)
+{
+    m_btcOrderBook.remove(offers);
+    m_ltcOrderBook.remove(offers);
+    m_qtumOrderBook.remove(offers);
+}
+
 bool SwapOffersViewModel::hasActiveTx(const std::string& swapCoin) const
 {
     for (int i = 0; i < m_transactionsList.rowCount(); ++i)
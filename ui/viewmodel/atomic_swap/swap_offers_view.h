@@ -20,6 +20,9 @@
 #include "model/wallet_model.h"
 #include "model/swap_coin_client_model.h"
 #include "swap_offers_list.h"
+#include "swap_offers_fit_index.h"
+#include "swap_offers_expiration.h"
+#include "swap_order_book.h"
 #include "swap_tx_object_list.h"
 
 using namespace hds::wallet;
@@ -30,6 +33,9 @@ class SwapOffersViewModel : public QObject
     Q_PROPERTY(QAbstractItemModel*  transactions        READ getTransactions        NOTIFY allTransactionsChanged)
     Q_PROPERTY(QAbstractItemModel*  allOffers           READ getAllOffers           NOTIFY allOffersChanged)
     Q_PROPERTY(QAbstractItemModel*  allOffersFitBalance READ getAllOffersFitBalance NOTIFY allOffersFitBalanceChanged)
+    Q_PROPERTY(SwapOrderBook*       btcOrderBook        READ getBtcOrderBook        CONSTANT)
+    Q_PROPERTY(SwapOrderBook*       ltcOrderBook        READ getLtcOrderBook        CONSTANT)
+    Q_PROPERTY(SwapOrderBook*       qtumOrderBook       READ getQtumOrderBook       CONSTANT)
     Q_PROPERTY(QString              hdsAvailable       READ hdsAvailable          NOTIFY hdsAvailableChanged)
     Q_PROPERTY(QString              btcAvailable        READ btcAvailable           NOTIFY btcAvailableChanged)
     Q_PROPERTY(QString              ltcAvailable        READ ltcAvailable           NOTIFY ltcAvailableChanged)
@@ -48,10 +54,14 @@ class SwapOffersViewModel : public QObject
 
 public:
     SwapOffersViewModel();
+    ~SwapOffersViewModel() override;
 
     QAbstractItemModel* getTransactions();
     QAbstractItemModel* getAllOffers();
     QAbstractItemModel* getAllOffersFitBalance();
+    SwapOrderBook* getBtcOrderBook();
+    SwapOrderBook* getLtcOrderBook();
+    SwapOrderBook* getQtumOrderBook();
     QString hdsAvailable() const;
     QString btcAvailable() const;
     QString ltcAvailable() const;
@@ -81,6 +91,11 @@ public slots:
         hds::wallet::ChangeAction action,
         const std::vector<hds::wallet::SwapOffer>& offers);
     void resetAllOffersFitBalance();
+    void onCurrentHeightChanged();
+    void onHdsAvailableChanged();
+    void onBtcBalanceChanged();
+    void onLtcBalanceChanged();
+    void onQtumBalanceChanged();
 
 signals:
     void allTransactionsChanged();
@@ -98,11 +113,14 @@ signals:
 
 private:
     void monitorAllOffersFitBalance();
-    bool isOfferFitBalance(const SwapOfferItem& offer);
+    void applyFitBalanceChanges(const SwapOffersFitIndex::Changes& changes);
     void insertAllOffersFitBalance(
         const std::vector<std::shared_ptr<SwapOfferItem>>& offers);
     void removeAllOffersFitBalance(
         const std::vector<std::shared_ptr<SwapOfferItem>>& offers);
+    void resetOrderBooks(const std::vector<std::shared_ptr<SwapOfferItem>>& offers);
+    void insertOrderBooks(const std::vector<std::shared_ptr<SwapOfferItem>>& offers);
+    void removeOrderBooks(const std::vector<std::shared_ptr<SwapOfferItem>>& offers);
     bool hasActiveTx(const std::string& swapCoin) const;
     uint32_t getTxMinConfirmations(AtomicSwapCoin swapCoinType);
     double getBlocksPerHour(AtomicSwapCoin swapCoinType);
@@ -112,6 +130,11 @@ private:
     SwapTxObjectList m_transactionsList;
     SwapOffersList m_offersList;
     SwapOffersList m_offersListFitBalance;
+    SwapOffersFitIndex m_offersFitIndex;
+    SwapOffersExpirationWheel m_offersExpiration;
+    SwapOrderBook m_btcOrderBook;
+    SwapOrderBook m_ltcOrderBook;
+    SwapOrderBook m_qtumOrderBook;
     SwapCoinClientModel::Ptr m_btcClient;
     SwapCoinClientModel::Ptr m_ltcClient;
     SwapCoinClientModel::Ptr m_qtumClient;
@@ -0,0 +1,346 @@
+// Copyright 2019 The Hds Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "swap_order_book.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    // price is kept with the same precision as rate is shown
+    const long double kPricePrecision = 100000000;
+
+    hds::Amount calculatePrice(hds::Amount swapCoinAmount, hds::Amount hdsAmount)
+    {
+        return static_cast<hds::Amount>(std::llround(
+            static_cast<long double>(swapCoinAmount) / hdsAmount * kPricePrecision));
+    }
+}  // namespace
+
+SwapOrderBookSide::SwapOrderBookSide(bool isBid, QObject* parent)
+    : QAbstractListModel(parent)
+    , m_isBid(isBid)
+{
+}
+
+int SwapOrderBookSide::rowCount(const QModelIndex& parent) const
+{
+    if (parent.isValid())
+    {
+        return 0;
+    }
+    return static_cast<int>(m_levels.size());
+}
+
+QHash<int, QByteArray> SwapOrderBookSide::roleNames() const
+{
+    static const auto roles = QHash<int, QByteArray>
+    {
+        { static_cast<int>(Roles::Price), "price" },
+        { static_cast<int>(Roles::PriceSort), "priceSort" },
+        { static_cast<int>(Roles::Volume), "volume" },
+        { static_cast<int>(Roles::VolumeSort), "volumeSort" },
+        { static_cast<int>(Roles::SwapCoinVolume), "swapCoinVolume" },
+        { static_cast<int>(Roles::SwapCoinVolumeSort), "swapCoinVolumeSort" },
+        { static_cast<int>(Roles::CumulativeVolume), "cumulativeVolume" },
+        { static_cast<int>(Roles::CumulativeVolumeSort), "cumulativeVolumeSort" },
+        { static_cast<int>(Roles::OffersCount), "offersCount" }
+    };
+    return roles;
+}
+
+QVariant SwapOrderBookSide::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || index.row() < 0 || index.row() >= rowCount())
+    {
+       return QVariant();
+    }
+
+    const auto& level = m_levels[index.row()];
+    switch (static_cast<Roles>(role))
+    {
+        case Roles::Price:
+            return hdsui::AmountToUIString(level.price);
+        case Roles::PriceSort:
+            return static_cast<qulonglong>(level.price);
+
+        case Roles::Volume:
+            return hdsui::AmountToUIString(level.volume);
+        case Roles::VolumeSort:
+            return static_cast<qulonglong>(level.volume);
+
+        case Roles::SwapCoinVolume:
+            return hdsui::AmountToUIString(level.swapCoinVolume);
+        case Roles::SwapCoinVolumeSort:
+            return static_cast<qulonglong>(level.swapCoinVolume);
+
+        case Roles::CumulativeVolume:
+            return hdsui::AmountToUIString(level.cumulativeVolume);
+        case Roles::CumulativeVolumeSort:
+            return static_cast<qulonglong>(level.cumulativeVolume);
+
+        case Roles::OffersCount:
+            return level.offersCount;
+
+        default:
+            return QVariant();
+    }
+}
+
+void SwapOrderBookSide::add(hds::Amount price, hds::Amount volume, hds::Amount swapCoinVolume)
+{
+    auto it = findLevel(price);
+    int row = static_cast<int>(std::distance(m_levels.begin(), it));
+
+    if (it != m_levels.end() && it->price == price)
+    {
+        it->volume += volume;
+        it->swapCoinVolume += swapCoinVolume;
+        ++it->offersCount;
+        emit dataChanged(index(row), index(row));
+    }
+    else
+    {
+        Level level;
+        level.price = price;
+        level.volume = volume;
+        level.swapCoinVolume = swapCoinVolume;
+        level.offersCount = 1;
+
+        beginInsertRows(QModelIndex(), row, row);
+        m_levels.insert(it, level);
+        endInsertRows();
+    }
+
+    updateCumulative(row);
+}
+
+void SwapOrderBookSide::remove(hds::Amount price, hds::Amount volume, hds::Amount swapCoinVolume)
+{
+    auto it = findLevel(price);
+    if (it == m_levels.end() || it->price != price)
+    {
+        return;
+    }
+
+    int row = static_cast<int>(std::distance(m_levels.begin(), it));
+    if (--it->offersCount <= 0)
+    {
+        beginRemoveRows(QModelIndex(), row, row);
+        m_levels.erase(it);
+        endRemoveRows();
+    }
+    else
+    {
+        it->volume -= volume;
+        it->swapCoinVolume -= swapCoinVolume;
+        emit dataChanged(index(row), index(row));
+    }
+
+    updateCumulative(row);
+}
+
+void SwapOrderBookSide::clear()
+{
+    beginResetModel();
+    m_levels.clear();
+    endResetModel();
+}
+
+const SwapOrderBookSide::Level* SwapOrderBookSide::getBest() const
+{
+    return m_levels.empty() ? nullptr : &m_levels.front();
+}
+
+hds::Amount SwapOrderBookSide::getDepth() const
+{
+    return m_levels.empty() ? 0 : m_levels.back().cumulativeVolume;
+}
+
+bool SwapOrderBookSide::isBetter(hds::Amount lhs, hds::Amount rhs) const
+{
+    return m_isBid ? lhs > rhs : lhs < rhs;
+}
+
+std::vector<SwapOrderBookSide::Level>::iterator SwapOrderBookSide::findLevel(hds::Amount price)
+{
+    return std::lower_bound(m_levels.begin(), m_levels.end(), price,
+        [this](const Level& level, hds::Amount p)
+        {
+            return isBetter(level.price, p);
+        });
+}
+
+void SwapOrderBookSide::updateCumulative(int fromRow)
+{
+    int count = rowCount();
+    if (fromRow >= count)
+    {
+        return;
+    }
+
+    hds::Amount cumulative = fromRow > 0 ? m_levels[fromRow - 1].cumulativeVolume : 0;
+    for (int row = fromRow; row < count; ++row)
+    {
+        cumulative += m_levels[row].volume;
+        m_levels[row].cumulativeVolume = cumulative;
+    }
+
+    emit dataChanged(index(fromRow), index(count - 1),
+        { static_cast<int>(Roles::CumulativeVolume), static_cast<int>(Roles::CumulativeVolumeSort) });
+}
+
+SwapOrderBook::SwapOrderBook(hdsui::Currencies swapCoin, QObject* parent)
+    : QObject(parent)
+    , m_swapCoin(swapCoin)
+    , m_bids(true)
+    , m_asks(false)
+{
+}
+
+QString SwapOrderBook::getSwapCoin() const
+{
+    return toString(m_swapCoin);
+}
+
+QAbstractItemModel* SwapOrderBook::getBids()
+{
+    return &m_bids;
+}
+
+QAbstractItemModel* SwapOrderBook::getAsks()
+{
+    return &m_asks;
+}
+
+QString SwapOrderBook::getBestBid() const
+{
+    auto best = m_bids.getBest();
+    return best ? hdsui::AmountToUIString(best->price) : QString();
+}
+
+QString SwapOrderBook::getBestAsk() const
+{
+    auto best = m_asks.getBest();
+    return best ? hdsui::AmountToUIString(best->price) : QString();
+}
+
+QString SwapOrderBook::getSpread() const
+{
+    auto bestBid = m_bids.getBest();
+    auto bestAsk = m_asks.getBest();
+    if (!bestBid || !bestAsk || bestAsk->price < bestBid->price)
+    {
+        return QString();
+    }
+    return hdsui::AmountToUIString(bestAsk->price - bestBid->price);
+}
+
+QString SwapOrderBook::getBidDepth() const
+{
+    return hdsui::AmountToUIString(m_bids.getDepth());
+}
+
+QString SwapOrderBook::getAskDepth() const
+{
+    return hdsui::AmountToUIString(m_asks.getDepth());
+}
+
+int SwapOrderBook::getOffersCount() const
+{
+    return static_cast<int>(m_entries.size());
+}
+
+void SwapOrderBook::reset(const std::vector<OfferPtr>& offers)
+{
+    m_entries.clear();
+    m_bids.clear();
+    m_asks.clear();
+
+    for (const auto& offer : offers)
+    {
+        insertOffer(*offer);
+    }
+    emit orderBookChanged();
+}
+
+void SwapOrderBook::insert(const std::vector<OfferPtr>& offers)
+{
+    bool isChanged = false;
+    for (const auto& offer : offers)
+    {
+        isChanged |= insertOffer(*offer);
+    }
+
+    if (isChanged)
+    {
+        emit orderBookChanged();
+    }
+}
+
+void SwapOrderBook::remove(const std::vector<OfferPtr>& offers)
+{
+    bool isChanged = false;
+    for (const auto& offer : offers)
+    {
+        auto it = m_entries.find(offer->getTxID());
+        if (it == m_entries.end())
+        {
+            continue;
+        }
+
+        const auto& entry = it->second;
+        auto& side = entry.isAsk ? m_asks : m_bids;
+        side.remove(entry.price, entry.volume, entry.swapCoinVolume);
+        m_entries.erase(it);
+        isChanged = true;
+    }
+
+    if (isChanged)
+    {
+        emit orderBookChanged();
+    }
+}
+
+bool SwapOrderBook::insertOffer(const SwapOfferItem& offer)
+{
+    if (offer.getSwapCoinType() != m_swapCoin)
+    {
+        return false;
+    }
+
+    auto hdsAmount = offer.isSendHds() ? offer.rawAmountSend() : offer.rawAmountReceive();
+    auto swapCoinAmount = offer.isSendHds() ? offer.rawAmountReceive() : offer.rawAmountSend();
+    if (!hdsAmount)
+    {
+        return false;
+    }
+
+    Entry entry;
+    // isSendHds() is our side, for own offers we are the publisher
+    entry.isAsk = offer.isOwnOffer() ? offer.isSendHds() : !offer.isSendHds();
+    entry.price = calculatePrice(swapCoinAmount, hdsAmount);
+    entry.volume = hdsAmount;
+    entry.swapCoinVolume = swapCoinAmount;
+
+    if (!m_entries.emplace(offer.getTxID(), entry).second)
+    {
+        return false;
+    }
+
+    auto& side = entry.isAsk ? m_asks : m_bids;
+    side.add(entry.price, entry.volume, entry.swapCoinVolume);
+    return true;
+}
@@ -0,0 +1,126 @@
+// Copyright 2019 The Hds Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <vector>
+#include <QAbstractListModel>
+#include "swap_offer_item.h"
+
+/// Price levels of one side of the order book, the best price goes first.
+/// Price is the swap coin amount for one hds, in 1e-8 units.
+class SwapOrderBookSide : public QAbstractListModel
+{
+    Q_OBJECT
+public:
+    enum class Roles
+    {
+        Price = Qt::UserRole + 1,
+        PriceSort,
+        Volume,
+        VolumeSort,
+        SwapCoinVolume,
+        SwapCoinVolumeSort,
+        CumulativeVolume,
+        CumulativeVolumeSort,
+        OffersCount
+    };
+
+    struct Level
+    {
+        hds::Amount price = 0;
+        hds::Amount volume = 0;          /// hds
+        hds::Amount swapCoinVolume = 0;
+        hds::Amount cumulativeVolume = 0;
+        int offersCount = 0;
+    };
+
+    explicit SwapOrderBookSide(bool isBid, QObject* parent = nullptr);
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    void add(hds::Amount price, hds::Amount volume, hds::Amount swapCoinVolume);
+    void remove(hds::Amount price, hds::Amount volume, hds::Amount swapCoinVolume);
+    void clear();
+
+    const Level* getBest() const;
+    hds::Amount getDepth() const;
+
+private:
+    bool isBetter(hds::Amount lhs, hds::Amount rhs) const;
+    std::vector<Level>::iterator findLevel(hds::Amount price);
+    void updateCumulative(int fromRow);
+
+    bool m_isBid;
+    std::vector<Level> m_levels;
+};
+
+/// Order book of one trading pair, aggregates offers into price levels.
+/// Asks are offers whose publisher sells hds, bids are offers whose publisher buys hds.
+class SwapOrderBook : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(QString              swapCoin        READ getSwapCoin        CONSTANT)
+    Q_PROPERTY(QAbstractItemModel*  bids            READ getBids            CONSTANT)
+    Q_PROPERTY(QAbstractItemModel*  asks            READ getAsks            CONSTANT)
+    Q_PROPERTY(QString              bestBid         READ getBestBid         NOTIFY orderBookChanged)
+    Q_PROPERTY(QString              bestAsk         READ getBestAsk         NOTIFY orderBookChanged)
+    Q_PROPERTY(QString              spread          READ getSpread          NOTIFY orderBookChanged)
+    Q_PROPERTY(QString              bidDepth        READ getBidDepth        NOTIFY orderBookChanged)
+    Q_PROPERTY(QString              askDepth        READ getAskDepth        NOTIFY orderBookChanged)
+    Q_PROPERTY(int                  offersCount     READ getOffersCount     NOTIFY orderBookChanged)
+
+public:
+    using OfferPtr = std::shared_ptr<SwapOfferItem>;
+
+    explicit SwapOrderBook(hdsui::Currencies swapCoin = hdsui::Currencies::Unknown, QObject* parent = nullptr);
+
+    QString getSwapCoin() const;
+    QAbstractItemModel* getBids();
+    QAbstractItemModel* getAsks();
+    QString getBestBid() const;
+    QString getBestAsk() const;
+    QString getSpread() const;
+    QString getBidDepth() const;
+    QString getAskDepth() const;
+    int getOffersCount() const;
+
+    /// Offers of the other pairs are ignored
+    void reset(const std::vector<OfferPtr>& offers);
+    void insert(const std::vector<OfferPtr>& offers);
+    void remove(const std::vector<OfferPtr>& offers);
+
+signals:
+    void orderBookChanged();
+
+private:
+    struct Entry
+    {
+        bool isAsk;
+        hds::Amount price;
+        hds::Amount volume;
+        hds::Amount swapCoinVolume;
+    };
+
+    bool insertOffer(const SwapOfferItem& offer);
+
+    hdsui::Currencies m_swapCoin;
+    SwapOrderBookSide m_bids;
+    SwapOrderBookSide m_asks;
+    std::map<TxID, Entry> m_entries;
+};
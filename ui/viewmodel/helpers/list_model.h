@@ -14,6 +14,10 @@
 
 #pragma once
 
+#include <algorithm>
+#include <map>
+#include <type_traits>
+#include <vector>
 #include <QAbstractListModel>
 Q_DECLARE_METATYPE(QModelIndex)
 template <typename T>
@@ -121,6 +125,62 @@ public:
         }
     }
 
+    // Replaces the content by keys, keyOf(item) must be ordered. Rows present in both
+    // lists are replaced in place with dataChanged, only the rows which are gone are
+    // removed and the new ones are appended. O((n + m) log m)
+    template <typename KeyOf>
+    void reconcile(const std::vector<T>& items, KeyOf keyOf)
+    {
+        using Key = std::decay_t<decltype(keyOf(items.front()))>;
+        std::map<Key, size_t> itemIndexes;
+        for (size_t i = 0; i < items.size(); ++i)
+        {
+            itemIndexes.emplace(keyOf(items[i]), i);
+        }
+
+        // from the end, so the rows before the removed ones keep their indexes
+        std::vector<bool> isPresent(items.size(), false);
+        for (int row = m_list.size() - 1; row >= 0;)
+        {
+            auto it = itemIndexes.find(keyOf(m_list[row]));
+            if (it != itemIndexes.end())
+            {
+                isPresent[it->second] = true;
+                --row;
+                continue;
+            }
+
+            int first = row;
+            while (first > 0 && itemIndexes.find(keyOf(m_list[first - 1])) == itemIndexes.end())
+            {
+                --first;
+            }
+            beginRemoveRows(QModelIndex(), first, row);
+            m_list.erase(m_list.begin() + first, m_list.begin() + row + 1);
+            endRemoveRows();
+            row = first - 1;
+        }
+
+        if (!m_list.isEmpty())
+        {
+            for (int row = 0; row < m_list.size(); ++row)
+            {
+                m_list[row] = items[itemIndexes[keyOf(m_list[row])]];
+            }
+            emit dataChanged(index(0), index(m_list.size() - 1));
+        }
+
+        std::vector<T> added;
+        for (size_t i = 0; i < items.size(); ++i)
+        {
+            if (!isPresent[i])
+            {
+                added.push_back(items[i]);
+            }
+        }
+        insert(added);
+    }
+
     auto begin()
     {
         return m_list.begin();
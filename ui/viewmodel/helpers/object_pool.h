@@ -0,0 +1,94 @@
+// Copyright 2018 The Hds Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#pragma once
+
+#include <QObject>
+#include <vector>
+
+// Pool of QObject based list items owned by a view model.
+// Items are parented to the owner, so they never outlive it, and released
+// items are kept for reuse by the next refresh instead of being reallocated.
+// T must provide a reset(...) method taking the same arguments as its constructor.
+template <typename T>
+class ObjectPool
+{
+public:
+    explicit ObjectPool(QObject* owner)
+        : m_owner(owner)
+    {
+    }
+
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    template <typename... Args>
+    T* acquire(Args&&... args)
+    {
+        if (m_free.empty())
+        {
+            auto item = new T(std::forward<Args>(args)...);
+            item->setParent(m_owner);
+            ++m_allocated;
+            return item;
+        }
+
+        auto item = m_free.back();
+        m_free.pop_back();
+        item->reset(std::forward<Args>(args)...);
+        return item;
+    }
+
+    void release(T* item)
+    {
+        m_free.push_back(item);
+    }
+
+    template <typename Container>
+    void releaseAll(Container& items)
+    {
+        for (auto item : items)
+        {
+            release(item);
+        }
+        items.clear();
+    }
+
+    // Frees idle items above the given limit, keeps the pool bounded
+    // when the number of live items goes down
+    void trim(size_t maxIdle)
+    {
+        while (m_free.size() > maxIdle)
+        {
+            // QML may still hold the item until it handles the change notification
+            m_free.back()->deleteLater();
+            m_free.pop_back();
+            --m_allocated;
+        }
+    }
+
+    size_t allocated() const
+    {
+        return m_allocated;
+    }
+
+    size_t idle() const
+    {
+        return m_free.size();
+    }
+
+private:
+    QObject* m_owner;
+    std::vector<T*> m_free;
+    size_t m_allocated = 0;
+};
@@ -15,6 +15,7 @@
 #include "token_bootstrap_manager.h"
 
 #include "model/app_model.h"
+#include "model/ui_log.h"
 
 #include <iterator>
 
@@ -69,7 +70,7 @@ void TokenBootstrapManager::checkTokenForDuplicate(const QString& token)
     auto parameters = hds::wallet::ParseParameters(token.toStdString());
     if (!parameters)
     {
-        LOG_ERROR() << "Can't parse token params";
+        UI_LOG_ERROR() << "Can't parse token params";
         return;
     }
 
@@ -85,7 +86,7 @@ void TokenBootstrapManager::checkTokenForDuplicate(const QString& token)
     auto txId = parametrsValue.GetTxID();
     if (!txId)
     {
-        LOG_ERROR() << "Empty tx id in txParams";
+        UI_LOG_ERROR() << "Empty tx id in txParams";
         return;
     }
     auto txIdValue = txId.value();
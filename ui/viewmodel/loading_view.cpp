@@ -16,6 +16,7 @@
 
 #include <cmath>
 #include "model/app_model.h"
+#include "model/startup_tracer.h"
 #include "viewmodel/ui_helpers.h"
 
 #include <qdebug.h>
@@ -37,6 +38,24 @@ const char* kPercentagePlaceholderNatural = " %.0lf%%";
 const int kMaxTimeDiffForUpdate = 20;
 const int kBpsRecessionCountThreshold = 60;
 
+QString getPhaseName(SyncTelemetry::Phase phase)
+{
+    switch (phase)
+    {
+    case SyncTelemetry::Phase::RebuildUTXO:
+        //% "UTXO rebuild"
+        return qtTrId("loading-view-phase-rebuild-utxo");
+    case SyncTelemetry::Phase::BlockDownload:
+        //% "Block download"
+        return qtTrId("loading-view-phase-block-download");
+    case SyncTelemetry::Phase::WalletScan:
+        //% "Wallet scan"
+        return qtTrId("loading-view-phase-wallet-scan");
+    default:
+        return QString();
+    }
+}
+
 }  // namespace
 
 Q_DECLARE_METATYPE(uint64_t);
@@ -59,7 +78,9 @@ LoadingViewModel::LoadingViewModel()
     , m_lastUpdateTimestamp{0}
     , m_estimate{0}
     , m_bpsRecessionCount{0}
+    , m_telemetry(std::make_unique<SyncTelemetry>(QString::fromStdString(AppModel::getInstance().getSettings().getAppDataPath())))
 {
+    STARTUP_TRACE_SPAN("LoadingViewModel::LoadingViewModel");
     connect(&m_walletModel, SIGNAL(syncProgressUpdated(int, int)), SLOT(onSyncProgressUpdated(int, int)));
     connect(&m_walletModel, SIGNAL(nodeConnectionChanged(bool)), SLOT(onNodeConnectionChanged(bool)));
     connect(&m_walletModel, SIGNAL(walletError(hds::wallet::ErrorType)), SLOT(onGetWalletError(hds::wallet::ErrorType)));
@@ -78,12 +99,16 @@ LoadingViewModel::~LoadingViewModel()
 void LoadingViewModel::onNodeInitProgressUpdated(quint64 done, quint64 total)
 {
     m_nodeInitProgress = done / static_cast<double>(total);
+    m_telemetry->addSample(SyncTelemetry::Phase::RebuildUTXO, done, total);
 }
 
 void LoadingViewModel::onSyncProgressUpdated(int done, int total)
 {
+    // the wallet scans in both modes, the progress shown is the node's one with a local node
+    m_telemetry->addSample(SyncTelemetry::Phase::WalletScan, done, total);
     if (!m_hasLocalNode)
     {
+        m_syncPhase = SyncTelemetry::Phase::WalletScan;
         onSync(done, total);
     }
 }
@@ -92,6 +117,8 @@ void LoadingViewModel::onNodeSyncProgressUpdated(int done, int total)
 {
     if (m_hasLocalNode)
     {
+        m_telemetry->addSample(SyncTelemetry::Phase::BlockDownload, done, total);
+        m_syncPhase = SyncTelemetry::Phase::BlockDownload;
         onSync(done, total);
     }
 }
@@ -212,6 +239,28 @@ void LoadingViewModel::updateProgress()
 
     setProgressMessage(progressMessage);
     setProgress(progress);
+    updateSyncSummary();
+}
+
+void LoadingViewModel::updateSyncSummary()
+{
+    auto summary = m_telemetry->getSummary(m_syncPhase);
+    if (summary.rateP50 <= 0.)
+    {
+        return;
+    }
+
+    //% "%1 rate: %2/s (p95 %3/s), stalls: %4"
+    auto syncSummary = qtTrId("loading-view-sync-summary")
+        .arg(getPhaseName(summary.phase))
+        .arg(summary.rateP50, 0, 'f', 1)
+        .arg(summary.rateP95, 0, 'f', 1)
+        .arg(summary.stalls);
+    if (m_syncSummary != syncSummary)
+    {
+        m_syncSummary = syncSummary;
+        emit syncSummaryChanged();
+    }
 }
 
 const char* LoadingViewModel::getPercentagePlaceholder(double progress) const
@@ -327,6 +376,11 @@ bool LoadingViewModel::getIsCreating() const
     return m_isCreating;
 }
 
+const QString& LoadingViewModel::getSyncSummary() const
+{
+    return m_syncSummary;
+}
+
 void LoadingViewModel::onNodeConnectionChanged(bool isNodeConnected)
 {
 }
@@ -18,6 +18,7 @@
 #include <QObject>
 
 #include "model/wallet_model.h"
+#include "model/sync_telemetry.h"
 
 namespace hdsui
 {
@@ -30,6 +31,7 @@ class LoadingViewModel : public QObject
     Q_PROPERTY(double progress READ getProgress WRITE setProgress NOTIFY progressChanged)
     Q_PROPERTY(QString progressMessage READ getProgressMessage WRITE setProgressMessage NOTIFY progressMessageChanged)
     Q_PROPERTY(bool isCreating READ getIsCreating WRITE setIsCreating NOTIFY isCreatingChanged)
+    Q_PROPERTY(QString syncSummary READ getSyncSummary NOTIFY syncSummaryChanged)
 
 public:
 
@@ -42,6 +44,7 @@ public:
     void setProgressMessage(const QString& value);
     void setIsCreating(bool value);
     bool getIsCreating() const;
+    const QString& getSyncSummary() const;
 
     Q_INVOKABLE void resetWallet();
     Q_INVOKABLE void recalculateProgress();
@@ -60,10 +63,12 @@ signals:
     void walletError(const QString& title, const QString& message);
     void isCreatingChanged();
     void walletResetCompleted();
+    void syncSummaryChanged();
 
 private:
     void onSync(int done, int total);
     void updateProgress();
+    void updateSyncSummary();
     const char* getPercentagePlaceholder(double progress) const;
     int getEstimate(double bps);
     double getWholeTimeBps() const;
@@ -91,4 +96,9 @@ private:
     hds::Timestamp m_previousUpdateTimestamp;
     int m_estimate;
     int m_bpsRecessionCount;
+
+    std::unique_ptr<SyncTelemetry> m_telemetry;
+    // the phase of the progress shown, its rates are in the summary
+    SyncTelemetry::Phase m_syncPhase = SyncTelemetry::Phase::None;
+    QString m_syncSummary;
 };
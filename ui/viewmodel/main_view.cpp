@@ -14,6 +14,7 @@
 
 #include "main_view.h"
 #include "model/app_model.h"
+#include "model/startup_tracer.h"
 
 namespace
 {
@@ -35,6 +36,7 @@ MainViewModel::MainViewModel()
     : m_settings{AppModel::getInstance().getSettings()}
     , m_timer(this)
 {
+    STARTUP_TRACE_SPAN("MainViewModel::MainViewModel");
     m_timer.setSingleShot(true);
     
     auto walletPtr = AppModel::getInstance().getWallet().get();
@@ -19,7 +19,7 @@
 #include "viewmodel/qml_globals.h"
 
 // test
-#include "utility/logger.h"
+#include "model/ui_log.h"
 
 using namespace hds::wallet;
 
@@ -61,6 +61,7 @@ void ExchangeRatesManager::setRateUnit()
         }
         if (m_rateUnit != newCurrency)
         {
+            m_rates.clear();
             m_walletModel.getAsync()->getExchangeRates();
         }
     }
@@ -75,15 +76,18 @@ void ExchangeRatesManager::onExchangeRatesUpdate(const std::vector<hds::wallet::
 
     for (const auto& rate : rates)
     {
-        {
-            PrintableAmount amount(rate.m_rate, true /*show decimal point*/);
-            LOG_DEBUG() << "Exchange rate: 1 " << hds::wallet::ExchangeRate::to_string(rate.m_currency) << " = "
-                        << amount << " " << hds::wallet::ExchangeRate::to_string(rate.m_unit);
-        }
-
         if (rate.m_unit != m_rateUnit) continue;
+
+        // rates are received repeatedly, only the changed ones are logged
+        auto it = m_rates.find(rate.m_currency);
+        if (it != m_rates.end() && it->second == rate.m_rate) continue;
+
+        PrintableAmount amount(rate.m_rate, true /*show decimal point*/);
+        UI_LOG_DEBUG() << "Exchange rate: 1 " << hds::wallet::ExchangeRate::to_string(rate.m_currency) << " = "
+                    << amount << " " << hds::wallet::ExchangeRate::to_string(rate.m_unit);
+
         m_rates[rate.m_currency] = rate.m_rate;
-        if (!isActiveRateChanged) isActiveRateChanged = true;
+        isActiveRateChanged = true;
     }
     if (isActiveRateChanged) emit activeRateChanged();
 }
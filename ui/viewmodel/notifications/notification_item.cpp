@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "notification_item.h"
+#include "model/ui_log.h"
 #include "utility/helpers.h"
 #include "wallet/core/common.h"
 #include "viewmodel/ui_helpers.h"
@@ -145,7 +146,7 @@ QString NotificationItem::title() const
             }
             else
             {
-                LOG_ERROR() << "Software update notification deserialization error";
+                UI_LOG_ERROR() << "Software update notification deserialization error";
                 return QString();
             }
         }
@@ -160,7 +161,7 @@ QString NotificationItem::title() const
             }
             else
             {
-                LOG_ERROR() << "Software update notification deserialization error";
+                UI_LOG_ERROR() << "Software update notification deserialization error";
                 return QString();
             }
         }
@@ -231,7 +232,7 @@ QString NotificationItem::message() const
             }
             else
             {
-                LOG_ERROR() << "Software update notification deserialization error";
+                UI_LOG_ERROR() << "Software update notification deserialization error";
                 return QString();
             }
         }
@@ -249,7 +250,7 @@ QString NotificationItem::message() const
             }
             else
             {
-                LOG_ERROR() << "Software update notification deserialization error";
+                UI_LOG_ERROR() << "Software update notification deserialization error";
                 return QString();
             }
         }
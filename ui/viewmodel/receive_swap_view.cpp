@@ -15,6 +15,7 @@
 #include "receive_swap_view.h"
 #include "ui_helpers.h"
 #include "model/app_model.h"
+#include "model/ui_log.h"
 #include "wallet/transactions/swaps/utils.h"
 #include "wallet/transactions/swaps/bridges/bitcoin/bitcoin_side.h"
 #include "wallet/transactions/swaps/bridges/litecoin/litecoin_side.h"
@@ -82,6 +83,21 @@ ReceiveSwapViewModel::ReceiveSwapViewModel()
 
     generateNewAddress();
     updateTransactionToken();
+
+    auto& appModel = AppModel::getInstance();
+    _swapClients = { appModel.getBitcoinClient(), appModel.getLitecoinClient(), appModel.getQtumClient() };
+    for (const auto& client : _swapClients)
+    {
+        client->addActiveView();
+    }
+}
+
+ReceiveSwapViewModel::~ReceiveSwapViewModel()
+{
+    for (const auto& client : _swapClients)
+    {
+        client->removeActiveView();
+    }
 }
 
 void ReceiveSwapViewModel::onGeneratedNewAddress(const hds::wallet::WalletAddress& addr)
@@ -114,7 +130,7 @@ void ReceiveSwapViewModel::storeSwapParams()
     }
     catch(...)
     {
-        LOG_ERROR() << "failed to serialize swap params";
+        UI_LOG_ERROR() << "failed to serialize swap params";
     }
 }
 
@@ -159,7 +175,7 @@ void ReceiveSwapViewModel::onSwapParamsLoaded(const hds::ByteBuffer& params)
         }
         catch(...)
         {
-            LOG_ERROR() << "failed to deserialize swap params";
+            UI_LOG_ERROR() << "failed to deserialize swap params";
         }
     }
 
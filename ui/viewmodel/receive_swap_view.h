@@ -15,6 +15,7 @@
 
 #include <QObject>
 #include "model/wallet_model.h"
+#include "model/swap_coin_client_model.h"
 #include "viewmodel/notifications/exchange_rates_manager.h"
 #include "currencies.h"
 
@@ -44,6 +45,7 @@ class ReceiveSwapViewModel: public QObject
 
 public:
     ReceiveSwapViewModel();
+    ~ReceiveSwapViewModel() override;
 
 signals:
     void amountReceiveChanged();
@@ -139,4 +141,6 @@ private:
     ExchangeRatesManager _exchangeRatesManager;
     hds::wallet::TxParameters _txParameters;
     bool _isHdsSide;
+    // balances are polled fast while the view is open, see SwapCoinClientModel::addActiveView
+    std::vector<SwapCoinClientModel::Ptr> _swapClients;
 };
@@ -13,6 +13,7 @@
 // limitations under the License.
 #include "send_swap_view.h"
 #include "model/app_model.h"
+#include "model/ui_log.h"
 #include "qml_globals.h"
 #include "wallet/transactions/swaps/common.h"
 #include "wallet/transactions/swaps/swap_transaction.h"
@@ -36,6 +37,21 @@ SendSwapViewModel::SendSwapViewModel()
     connect(&_walletModel, &WalletModel::availableChanged, this, &SendSwapViewModel::recalcAvailable);
     connect(&_exchangeRatesManager, SIGNAL(rateUnitChanged()), SIGNAL(secondCurrencyLabelChanged()));
     connect(&_exchangeRatesManager, SIGNAL(activeRateChanged()), SIGNAL(secondCurrencyRateChanged()));
+
+    auto& appModel = AppModel::getInstance();
+    _swapClients = { appModel.getBitcoinClient(), appModel.getLitecoinClient(), appModel.getQtumClient() };
+    for (const auto& client : _swapClients)
+    {
+        client->addActiveView();
+    }
+}
+
+SendSwapViewModel::~SendSwapViewModel()
+{
+    for (const auto& client : _swapClients)
+    {
+        client->removeActiveView();
+    }
 }
 
 QString SendSwapViewModel::getToken() const
@@ -443,7 +459,7 @@ void SendSwapViewModel::sendMoney()
         auto responseHeight = txParameters.GetParameter<hds::Height>(TxParameterID::PeerResponseTime);
         auto minimalHeight = txParameters.GetParameter<hds::Height>(TxParameterID::MinHeight);
 
-        LOG_INFO() << *txID << " Accept offer.\n\t"
+        UI_LOG_INFO() << *txID << " Accept offer.\n\t"
                     << "isHdsSide: " << (_isHdsSide ? "true" : "false") << "\n\t"
                     << "swapCoin: " << std::to_string(*swapCoin) << "\n\t"
                     << "amount: " << *amount << "\n\t"
@@ -16,6 +16,7 @@
 #include <QObject>
 #include <QDateTime>
 #include "model/wallet_model.h"
+#include "model/swap_coin_client_model.h"
 #include "notifications/exchange_rates_manager.h"
 #include "currencies.h"
 
@@ -52,6 +53,7 @@ class SendSwapViewModel: public QObject
 
 public:
     SendSwapViewModel();
+    ~SendSwapViewModel() override;
 
     QString getToken() const;
     void setToken(const QString& value);
@@ -149,6 +151,8 @@ private:
     ExchangeRatesManager _exchangeRatesManager;
     hds::wallet::TxParameters _txParameters;
     bool _isHdsSide;
+    // balances are polled fast while the view is open, see SwapCoinClientModel::addActiveView
+    std::vector<SwapCoinClientModel::Ptr> _swapClients;
 
     QString _tokenGeneratebByNewAppVersionMessage = "";
 };
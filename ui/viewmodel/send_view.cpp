@@ -13,6 +13,7 @@
 // limitations under the License.
 #include "send_view.h"
 #include "model/app_model.h"
+#include "model/ui_log.h"
 #include "wallet/core/common.h"
 #include "wallet/core/simple_transaction.h"
 
@@ -69,7 +70,6 @@ void SendViewModel::setComment(const QString& value)
 
 QString SendViewModel::getSendAmount() const
 {
-    LOG_DEBUG() << "ret Send amount grothes: " << _sendAmountGrothes << " 2ui: " << hdsui::AmountToUIString(_sendAmountGrothes).toStdString();
     return hdsui::AmountToUIString(_sendAmountGrothes);
 }
 
@@ -79,7 +79,7 @@ void SendViewModel::setSendAmount(QString value)
     if (amount != _sendAmountGrothes)
     {
         _sendAmountGrothes = amount;
-        LOG_DEBUG() << "Send amount: " << _sendAmountGrothes << " Coins: " << (long double)_sendAmountGrothes / hds::Rules::Coin;
+        UI_LOG_DEBUG() << "Send amount: " << _sendAmountGrothes << " Coins: " << (long double)_sendAmountGrothes / hds::Rules::Coin;
         _walletModel.getAsync()->calcChange(calcTotalAmount());
         emit sendAmountChanged();
         emit canSendChanged();
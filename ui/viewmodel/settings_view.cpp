@@ -17,15 +17,19 @@
 #include <QtQuick>
 #include <QApplication>
 #include <QClipboard>
+#include <QFileDialog>
+#include <QStandardPaths>
 #include "model/app_model.h"
 #include "model/helpers.h"
 #include "model/swap_coin_client_model.h"
+#include "model/startup_tracer.h"
 #include <thread>
 #include "wallet/core/secstring.h"
 #include "qml_globals.h"
 #include <algorithm>
 #include <boost/algorithm/string/trim.hpp>
 #include "utility/string_helpers.h"
+#include "model/ui_log.h"
 #include "mnemonic/mnemonic.h"
 #include "viewmodel/ui_helpers.h"
 
@@ -41,6 +45,10 @@ using namespace std;
 
 namespace
 {
+    // the order of the log level selector in settings.qml
+    const int kFileLogLevels[] = { LOG_LEVEL_VERBOSE, LOG_LEVEL_DEBUG, LOG_LEVEL_INFO, LOG_LEVEL_WARNING, LOG_LEVEL_ERROR };
+    const int kUILogPollInterval = 5000;
+
     QString AddressToQstring(const io::Address& address) 
     {
         if (!address.empty())
@@ -788,9 +796,12 @@ SettingsViewModel::SettingsViewModel()
     , m_supportedLanguages(WalletSettings::getSupportedLanguages())
     , m_supportedAmountUnits(WalletSettings::getSupportedRateUnits())
 {
+    STARTUP_TRACE_SPAN("SettingsViewModel::SettingsViewModel");
     undoChanges();
 
     m_lockTimeout = m_settings.getLockTimeout();
+    auto fileLogLevel = std::find(std::begin(kFileLogLevels), std::end(kFileLogLevels), m_settings.getFileLogLevel());
+    m_fileLogLevel = fileLogLevel != std::end(kFileLogLevels) ? static_cast<int>(fileLogLevel - std::begin(kFileLogLevels)) : 1;
     m_isPasswordReqiredToSpendMoney = m_settings.isPasswordReqiredToSpendMoney();
     m_isAllowedHdsCOMLinks = m_settings.isAllowedHdsCOMLinks();
     m_currentLanguageIndex = m_supportedLanguages.indexOf(m_settings.getLanguageName());
@@ -798,10 +809,17 @@ SettingsViewModel::SettingsViewModel()
 
     connect(&AppModel::getInstance().getNode(), SIGNAL(startedNode()), SLOT(onNodeStarted()));
     connect(&AppModel::getInstance().getNode(), SIGNAL(stoppedNode()), SLOT(onNodeStopped()));
-    connect(AppModel::getInstance().getWallet().get(), SIGNAL(addressChecked(const QString&, bool)), SLOT(onAddressChecked(const QString&, bool)));
+    connect(&m_addressChecker, SIGNAL(addressChecked(const QString&, bool)), SLOT(onAddressChecked(const QString&, bool)));
+    connect(&m_addressChecker, SIGNAL(probeFinished(const QString&, quint16, int)), SLOT(onNodeProbeFinished(const QString&, quint16, int)));
     connect(&m_settings, SIGNAL(hdsMWLinksChanged()), SIGNAL(hdsMWLinksPermissionChanged()));
+    connect(&AppModel::getInstance().getNode().getResourceGovernor(), SIGNAL(usageChanged()), SIGNAL(nodeResourceUsageChanged()));
+    connect(&AppModel::getInstance().getNode(), SIGNAL(initProgressUpdated(quint64, quint64)), SLOT(onNodeInitProgressUpdated(quint64, quint64)));
+    connect(&AppModel::getInstance().getNode(), SIGNAL(snapshotImported(bool, const QString&)), SLOT(onNodeSnapshotImported()));
+    connect(&AppModel::getInstance(), SIGNAL(nodeSwitched(const QString&)), SIGNAL(nodeFailoverChanged()));
 
-    m_timerId = startTimer(CHECK_INTERVAL);
+    m_uiLogDropped = UILog::getInstance().getDroppedCount();
+    connect(&m_uiLogTimer, SIGNAL(timeout()), SLOT(onUILogTimer()));
+    m_uiLogTimer.start(kUILogPollInterval);
 }
 
 SettingsViewModel::~SettingsViewModel()
@@ -821,21 +839,55 @@ void SettingsViewModel::onNodeStopped()
 
 void SettingsViewModel::onAddressChecked(const QString& addr, bool isValid)
 {
-    if (m_nodeAddress == addr && m_isValidNodeAddress != isValid)
+    if (m_nodeAddress != addr)
+    {
+        return;
+    }
+
+    m_isNeedToCheckAddress = false;
+    if (m_isValidNodeAddress != isValid)
     {
         m_isValidNodeAddress = isValid;
         emit validNodeAddressChanged();
+    }
 
-        if (m_isNeedToApplyChanges)
-        {
-            if (m_isValidNodeAddress)
-                applyChanges();
+    if (m_isNeedToApplyChanges)
+    {
+        if (m_isValidNodeAddress)
+            applyChanges();
 
-            m_isNeedToApplyChanges = false;
-        }
+        m_isNeedToApplyChanges = false;
     }
 }
 
+void SettingsViewModel::onNodeProbeFinished(const QString& addr, quint16 port, int latency)
+{
+    if (m_nodeAddress == addr && m_remoteNodePort.toUShort() == port)
+    {
+        m_nodeLatency = latency;
+        emit nodeLatencyChanged();
+    }
+}
+
+void SettingsViewModel::checkNodeAddress()
+{
+    if (m_nodeLatency != kNodeLatencyUnknown)
+    {
+        m_nodeLatency = kNodeLatencyUnknown;
+        emit nodeLatencyChanged();
+    }
+
+    if (m_localNodeRun)
+    {
+        m_addressChecker.cancel();
+        m_isNeedToCheckAddress = false;
+        return;
+    }
+
+    m_isNeedToCheckAddress = true;
+    m_addressChecker.check(m_nodeAddress, m_remoteNodePort.toUShort());
+}
+
 bool SettingsViewModel::isLocalNodeRunning() const
 {
     return AppModel::getInstance().getNode().isNodeRunning();
@@ -846,6 +898,166 @@ bool SettingsViewModel::isValidNodeAddress() const
     return m_isValidNodeAddress;
 }
 
+QString SettingsViewModel::getNodeLatency() const
+{
+    if (m_nodeLatency == kNodeLatencyUnknown)
+    {
+        return {};
+    }
+
+    if (m_nodeLatency < 0)
+    {
+        //: settings tab, node section, the remote node does not accept connections
+        //% "Node is not reachable"
+        return qtTrId("settings-node-not-reachable");
+    }
+
+    //: settings tab, node section, round trip to the remote node
+    //% "Response time: %1 ms"
+    return qtTrId("settings-node-latency").arg(m_nodeLatency);
+}
+
+int SettingsViewModel::getNodeCpuCores() const
+{
+    return m_settings.getLocalNodeCpuCores();
+}
+
+void SettingsViewModel::setNodeCpuCores(int value)
+{
+    if (value != m_settings.getLocalNodeCpuCores())
+    {
+        m_settings.setLocalNodeCpuCores(value);
+        AppModel::getInstance().getNode().getResourceGovernor().setLimits(value, m_settings.isLocalNodeLowPriority());
+        emit nodeResourceLimitsChanged();
+    }
+}
+
+bool SettingsViewModel::getNodeLowPriority() const
+{
+    return m_settings.isLocalNodeLowPriority();
+}
+
+void SettingsViewModel::setNodeLowPriority(bool value)
+{
+    if (value != m_settings.isLocalNodeLowPriority())
+    {
+        m_settings.setLocalNodeLowPriority(value);
+        AppModel::getInstance().getNode().getResourceGovernor().setLimits(m_settings.getLocalNodeCpuCores(), value);
+        emit nodeResourceLimitsChanged();
+    }
+}
+
+bool SettingsViewModel::isNodeFailoverEnabled() const
+{
+    return m_settings.isNodeFailoverEnabled();
+}
+
+void SettingsViewModel::setNodeFailoverEnabled(bool value)
+{
+    if (value != m_settings.isNodeFailoverEnabled())
+    {
+        // NodeFailover reads it on the next check
+        m_settings.setNodeFailoverEnabled(value);
+        emit nodeFailoverChanged();
+    }
+}
+
+bool SettingsViewModel::isSwapClientsOwnThreads() const
+{
+    return m_settings.isSwapClientsOwnThreads();
+}
+
+void SettingsViewModel::setSwapClientsOwnThreads(bool value)
+{
+    if (value != m_settings.isSwapClientsOwnThreads())
+    {
+        // the clients are created with the wallet
+        m_settings.setSwapClientsOwnThreads(value);
+        emit swapClientsOwnThreadsChanged();
+    }
+}
+
+QString SettingsViewModel::getFallbackNode() const
+{
+    return AppModel::getInstance().getFallbackNode();
+}
+
+QString SettingsViewModel::getNodeResourceUsage() const
+{
+    if (!NodeResourceGovernor::isSupported() || !isLocalNodeRunning())
+    {
+        return {};
+    }
+
+    const auto& governor = AppModel::getInstance().getNode().getResourceGovernor();
+    //: settings tab, node section, CPU in percent of one core and disk use of the integrated node
+    //% "CPU: %1%, disk: %2 MB/s"
+    return qtTrId("settings-node-resource-usage")
+        .arg(governor.getCpuUsage(), 0, 'f', 0)
+        .arg(governor.getIOBytesPerSecond() / (1024. * 1024.), 0, 'f', 1);
+}
+
+bool SettingsViewModel::isNodeSnapshotImporting() const
+{
+    return AppModel::getInstance().getNode().isImportingSnapshot();
+}
+
+int SettingsViewModel::getNodeSnapshotImportProgress() const
+{
+    return m_nodeSnapshotImportProgress;
+}
+
+void SettingsViewModel::importNodeSnapshot()
+{
+    auto snapshotPath = QFileDialog::getOpenFileName(
+        nullptr,
+        //: settings tab, node section, open file dialog title
+        //% "Select the node snapshot"
+        qtTrId("settings-select-node-snapshot"),
+        QStandardPaths::writableLocation(QStandardPaths::DownloadLocation),
+        //% "Node database (*.db)"
+        qtTrId("settings-node-snapshot-filter"));
+    if (snapshotPath.isEmpty())
+    {
+        return;
+    }
+
+    auto checkpointPath = snapshotPath + ".checkpoint";
+    if (!QFile::exists(checkpointPath))
+    {
+        checkpointPath = QFileDialog::getOpenFileName(
+            nullptr,
+            //: settings tab, node section, open file dialog title
+            //% "Select the snapshot checkpoint"
+            qtTrId("settings-select-node-snapshot-checkpoint"),
+            QFileInfo(snapshotPath).path(),
+            //% "Snapshot checkpoint (*.checkpoint)"
+            qtTrId("settings-node-snapshot-checkpoint-filter"));
+        if (checkpointPath.isEmpty())
+        {
+            return;
+        }
+    }
+
+    m_nodeSnapshotImportProgress = 0;
+    AppModel::getInstance().importNodeSnapshot(snapshotPath, checkpointPath);
+    emit nodeSnapshotImportChanged();
+}
+
+void SettingsViewModel::onNodeInitProgressUpdated(quint64 done, quint64 total)
+{
+    if (isNodeSnapshotImporting() && total > 0)
+    {
+        m_nodeSnapshotImportProgress = static_cast<int>(done * 100 / total);
+        emit nodeSnapshotImportChanged();
+    }
+}
+
+void SettingsViewModel::onNodeSnapshotImported()
+{
+    emit nodeSnapshotImportChanged();
+}
+
 QString SettingsViewModel::getNodeAddress() const
 {
     return m_nodeAddress;
@@ -856,12 +1068,7 @@ void SettingsViewModel::setNodeAddress(const QString& value)
     if (value != m_nodeAddress)
     {
         m_nodeAddress = value;
-
-        if (!m_isNeedToCheckAddress)
-        {
-            m_isNeedToCheckAddress = true;
-            m_timerId = startTimer(CHECK_INTERVAL);
-        }
+        checkNodeAddress();
 
         emit nodeAddressChanged();
         emit propertiesChanged();
@@ -883,12 +1090,7 @@ void SettingsViewModel::setLocalNodeRun(bool value)
     if (value != m_localNodeRun)
     {
         m_localNodeRun = value;
-
-        if (!m_localNodeRun && !m_isNeedToCheckAddress)
-        {
-            m_isNeedToCheckAddress = true;
-            m_timerId = startTimer(CHECK_INTERVAL);
-        }
+        checkNodeAddress();
 
         emit localNodeRunChanged();
         emit propertiesChanged();
@@ -920,6 +1122,8 @@ void SettingsViewModel::setRemoteNodePort(const QString& value)
     if (value != m_remoteNodePort)
     {
         m_remoteNodePort = value;
+        checkNodeAddress();
+
         emit remoteNodePortChanged();
         emit propertiesChanged();
     }
@@ -940,6 +1144,49 @@ void SettingsViewModel::setLockTimeout(int value)
     }
 }
 
+int SettingsViewModel::getFileLogLevel() const
+{
+    return m_fileLogLevel;
+}
+
+void SettingsViewModel::setFileLogLevel(int value)
+{
+    if (value != m_fileLogLevel && value >= 0 && value < static_cast<int>(std::size(kFileLogLevels)))
+    {
+        m_fileLogLevel = value;
+        m_settings.setFileLogLevel(kFileLogLevels[m_fileLogLevel]);
+        UILog::getInstance().setFileLevel(kFileLogLevels[m_fileLogLevel]);
+        emit fileLogLevelChanged();
+    }
+}
+
+bool SettingsViewModel::isFileLogLevelRestartRequired() const
+{
+    return kFileLogLevels[m_fileLogLevel] > UILog::getInstance().getLoggerFileLevel();
+}
+
+QString SettingsViewModel::getUILogDropped() const
+{
+    auto dropped = UILog::getInstance().getDroppedCount();
+    if (dropped == 0)
+    {
+        return {};
+    }
+    //: settings tab, general section, the UI log could not keep up with the messages
+    //% "%1 interface log messages dropped"
+    return qtTrId("settings-general-log-dropped").arg(dropped);
+}
+
+void SettingsViewModel::onUILogTimer()
+{
+    auto dropped = UILog::getInstance().getDroppedCount();
+    if (dropped != m_uiLogDropped)
+    {
+        m_uiLogDropped = dropped;
+        emit uiLogDroppedChanged();
+    }
+}
+
 bool SettingsViewModel::isPasswordReqiredToSpendMoney() const
 {
     return m_isPasswordReqiredToSpendMoney;
@@ -1118,24 +1365,68 @@ void SettingsViewModel::undoChanges()
 
 void SettingsViewModel::reportProblem()
 {
-    m_settings.reportProblem();
+    if (m_reportArchiver)
+    {
+        return;
+    }
+
+    m_reportArchiver = m_settings.reportProblem();
+    if (!m_reportArchiver)
+    {
+        return;
+    }
+
+    m_reportProgress = 0;
+    connect(m_reportArchiver.get(), SIGNAL(progressChanged(int)), this, SLOT(onReportProgressChanged(int)));
+    connect(m_reportArchiver.get(), SIGNAL(finished()), this, SLOT(onReportFinished()));
+    m_reportArchiver->start(QThread::LowPriority);
+    emit reportProgressChanged();
 }
 
-void SettingsViewModel::changeWalletPassword(const QString& pass)
+void SettingsViewModel::cancelReport()
 {
-    AppModel::getInstance().changeWalletPassword(pass.toStdString());
+    if (m_reportArchiver)
+    {
+        m_reportArchiver->requestInterruption();
+    }
 }
 
-void SettingsViewModel::timerEvent(QTimerEvent *event)
+void SettingsViewModel::onReportProgressChanged(int progress)
 {
-    if (m_isNeedToCheckAddress && !m_localNodeRun)
-    {
-        m_isNeedToCheckAddress = false;
+    m_reportProgress = progress;
+    emit reportProgressChanged();
+}
 
-        AppModel::getInstance().getWallet()->getAsync()->checkAddress(m_nodeAddress.toStdString());
+void SettingsViewModel::onReportFinished()
+{
+    if (!m_reportArchiver)
+    {
+        return;
+    }
 
-        killTimer(m_timerId);
+    if (!m_reportArchiver->isSucceeded() && !m_reportArchiver->isInterruptionRequested())
+    {
+        //% "Failed to save wallet logs"
+        AppModel::getInstance().getMessages().addMessage(qtTrId("settings-report-problem-error"));
     }
+
+    m_reportArchiver.reset();
+    emit reportProgressChanged();
+}
+
+bool SettingsViewModel::isReportInProgress() const
+{
+    return m_reportArchiver != nullptr;
+}
+
+int SettingsViewModel::getReportProgress() const
+{
+    return m_reportProgress;
+}
+
+void SettingsViewModel::changeWalletPassword(const QString& pass)
+{
+    AppModel::getInstance().changeWalletPassword(pass.toStdString());
 }
 
 const QList<QObject*>& SettingsViewModel::getSwapCoinSettings()
@@ -17,8 +17,10 @@
 #include <QObject>
 #include <QSettings>
 #include <QQmlListProperty>
+#include <QTimer>
 
 #include "model/settings.h"
+#include "model/node_address_checker.h"
 #include "wallet/transactions/swaps/bridges/bitcoin/client.h"
 #include "wallet/transactions/swaps/bridges/bitcoin/settings.h"
 #include "viewmodel/notifications/notifications_settings.h"
@@ -227,6 +229,11 @@ class SettingsViewModel : public QObject
     Q_PROPERTY(bool     isChanged       READ isChanged          NOTIFY propertiesChanged)
     Q_PROPERTY(QStringList  localNodePeers  READ getLocalNodePeers  NOTIFY localNodePeersChanged)
     Q_PROPERTY(int      lockTimeout         READ getLockTimeout     WRITE setLockTimeout NOTIFY lockTimeoutChanged)
+    Q_PROPERTY(int      fileLogLevel        READ getFileLogLevel    WRITE setFileLogLevel NOTIFY fileLogLevelChanged)
+    Q_PROPERTY(bool     isFileLogLevelRestartRequired   READ isFileLogLevelRestartRequired NOTIFY fileLogLevelChanged)
+    Q_PROPERTY(QString  uiLogDropped        READ getUILogDropped    NOTIFY uiLogDroppedChanged)
+    Q_PROPERTY(bool     isReportInProgress  READ isReportInProgress NOTIFY reportProgressChanged)
+    Q_PROPERTY(int      reportProgress      READ getReportProgress  NOTIFY reportProgressChanged)
     Q_PROPERTY(QString  walletLocation      READ getWalletLocation  CONSTANT)
     Q_PROPERTY(bool     isLocalNodeRunning  READ isLocalNodeRunning NOTIFY localNodeRunningChanged)
     Q_PROPERTY(bool     isPasswordReqiredToSpendMoney   READ isPasswordReqiredToSpendMoney WRITE setPasswordReqiredToSpendMoney NOTIFY passwordReqiredToSpendMoneyChanged)
@@ -235,7 +242,16 @@ class SettingsViewModel : public QObject
     Q_PROPERTY(int      currentLanguageIndex    READ getCurrentLanguageIndex    NOTIFY currentLanguageIndexChanged)
     Q_PROPERTY(QString  currentLanguage         READ getCurrentLanguage         WRITE setCurrentLanguage)
     Q_PROPERTY(bool     isValidNodeAddress      READ isValidNodeAddress         NOTIFY validNodeAddressChanged)
+    Q_PROPERTY(QString  nodeLatency             READ getNodeLatency             NOTIFY nodeLatencyChanged)
+    Q_PROPERTY(bool     nodeFailover        READ isNodeFailoverEnabled  WRITE setNodeFailoverEnabled NOTIFY nodeFailoverChanged)
+    Q_PROPERTY(QString  fallbackNode        READ getFallbackNode        NOTIFY nodeFailoverChanged)
+    Q_PROPERTY(int      nodeCpuCores        READ getNodeCpuCores    WRITE setNodeCpuCores   NOTIFY nodeResourceLimitsChanged)
+    Q_PROPERTY(bool     nodeLowPriority     READ getNodeLowPriority WRITE setNodeLowPriority NOTIFY nodeResourceLimitsChanged)
+    Q_PROPERTY(QString  nodeResourceUsage   READ getNodeResourceUsage   NOTIFY nodeResourceUsageChanged)
+    Q_PROPERTY(bool     isNodeSnapshotImporting     READ isNodeSnapshotImporting    NOTIFY nodeSnapshotImportChanged)
+    Q_PROPERTY(int      nodeSnapshotImportProgress  READ getNodeSnapshotImportProgress NOTIFY nodeSnapshotImportChanged)
     Q_PROPERTY(QString  secondCurrency  READ getSecondCurrency  WRITE setSecondCurrency NOTIFY secondCurrencyChanged)
+    Q_PROPERTY(bool     swapClientsOwnThreads   READ isSwapClientsOwnThreads    WRITE setSwapClientsOwnThreads NOTIFY swapClientsOwnThreadsChanged)
 
     Q_PROPERTY(QList<QObject*> swapCoinSettingsList READ getSwapCoinSettings    CONSTANT)
     Q_PROPERTY(QObject* notificationsSettings   READ getNotificationsSettings   CONSTANT)
@@ -256,6 +272,12 @@ public:
     void setRemoteNodePort(const QString& value);
     int getLockTimeout() const;
     void setLockTimeout(int value);
+    int getFileLogLevel() const;
+    void setFileLogLevel(int value);
+    bool isFileLogLevelRestartRequired() const;
+    QString getUILogDropped() const;
+    bool isReportInProgress() const;
+    int getReportProgress() const;
     bool isPasswordReqiredToSpendMoney() const;
     void setPasswordReqiredToSpendMoney(bool value);
     bool isAllowedHdsCOMLinks();
@@ -275,6 +297,19 @@ public:
     QString getWalletLocation() const;
     bool isLocalNodeRunning() const;
     bool isValidNodeAddress() const;
+    QString getNodeLatency() const;
+    int getNodeCpuCores() const;
+    void setNodeCpuCores(int value);
+    bool getNodeLowPriority() const;
+    void setNodeLowPriority(bool value);
+    bool isNodeFailoverEnabled() const;
+    void setNodeFailoverEnabled(bool value);
+    bool isSwapClientsOwnThreads() const;
+    void setSwapClientsOwnThreads(bool value);
+    QString getFallbackNode() const;
+    QString getNodeResourceUsage() const;
+    bool isNodeSnapshotImporting() const;
+    int getNodeSnapshotImportProgress() const;
 
     bool isChanged() const;
 
@@ -289,15 +324,23 @@ public:
     Q_INVOKABLE void openFolder(const QString& path);
     Q_INVOKABLE bool checkWalletPassword(const QString& password) const;
     Q_INVOKABLE QString getOwnerKey(const QString& password) const;
+    Q_INVOKABLE void cancelReport();
+    Q_INVOKABLE void importNodeSnapshot();
 
 public slots:
     void applyChanges();
     void undoChanges();
 	void reportProblem();
+    void onReportProgressChanged(int progress);
+    void onReportFinished();
     void changeWalletPassword(const QString& pass);
     void onNodeStarted();
     void onNodeStopped();
     void onAddressChecked(const QString& addr, bool isValid);
+    void onNodeProbeFinished(const QString& addr, quint16 port, int latency);
+    void onNodeInitProgressUpdated(quint64 done, quint64 total);
+    void onNodeSnapshotImported();
+    void onUILogTimer();
 
 signals:
     void nodeAddressChanged();
@@ -307,27 +350,41 @@ signals:
     void localNodePeersChanged();
     void propertiesChanged();
     void lockTimeoutChanged();
+    void fileLogLevelChanged();
+    void uiLogDroppedChanged();
+    void reportProgressChanged();
     void localNodeRunningChanged();
     void passwordReqiredToSpendMoneyChanged();
     void validNodeAddressChanged();
+    void nodeLatencyChanged();
+    void nodeResourceLimitsChanged();
+    void nodeFailoverChanged();
+    void swapClientsOwnThreadsChanged();
+    void nodeResourceUsageChanged();
+    void nodeSnapshotImportChanged();
     void currentLanguageIndexChanged();
     void secondCurrencyChanged();
     void hdsMWLinksPermissionChanged();
 
-protected:
-    void timerEvent(QTimerEvent *event) override;
-
 private:
+    void checkNodeAddress();
+
     WalletSettings& m_settings;
     QList<QObject*> m_swapSettings;
     NotificationsSettings m_notificationsSettings;
 
     QString m_nodeAddress;
-    bool m_localNodeRun;
+    bool m_localNodeRun = false;
     QString m_localNodePort;
     QString m_remoteNodePort;
     QStringList m_localNodePeers;
     int m_lockTimeout;
+    int m_fileLogLevel;
+    // polls the dropped UI log messages, see UILog
+    QTimer m_uiLogTimer;
+    uint64_t m_uiLogDropped = 0;
+    std::unique_ptr<ReportArchiver> m_reportArchiver;
+    int m_reportProgress = 0;
     bool m_isPasswordReqiredToSpendMoney;
     bool m_isAllowedHdsCOMLinks;
     bool m_isValidNodeAddress;
@@ -337,7 +394,9 @@ private:
     QStringList m_supportedAmountUnits;
     int m_currentLanguageIndex;
     QString m_secondCurrency;
-    int m_timerId;
+    NodeAddressChecker m_addressChecker;
+    int m_nodeLatency = kNodeLatencyUnknown;
+    int m_nodeSnapshotImportProgress = 0;
 
-    const int CHECK_INTERVAL = 1000;
+    static constexpr int kNodeLatencyUnknown = -2;
 };
@@ -22,6 +22,8 @@
 #include <QVariant>
 #include <QStandardPaths>
 #include <QJSEngine>
+#include <QPointer>
+#include <QElapsedTimer>
 #if defined(QT_PRINTSUPPORT_LIB)
 #include <QtPrintSupport/qtprintsupportglobal.h>
 #include <QPrinter>
@@ -32,7 +34,10 @@
 #endif
 #include "settings_view.h"
 #include "model/app_model.h"
+#include "model/ui_log.h"
 #include "model/keyboard.h"
+#include "model/startup_tracer.h"
+#include "model/wallet_db_loader.h"
 #include "version.h"
 #include "wallet/core/secstring.h"
 #include "wallet/core/default_peers.h"
@@ -64,47 +69,103 @@ namespace
         return boostPath;
     }
 
-    std::vector<boost::filesystem::path> findAllWalletDB(const std::string& appPath)
+    // the biggest folders of the app data which never contain wallet DBs
+    const char* kSkippedFolders[] = { WalletSettings::LogsFolder, "temp" };
+    const size_t kMaxCachedWalletDBs = 10;
+
+    bool isWalletDBFile(const boost::filesystem::path& path)
+    {
+        return path.filename() == WalletSettings::WalletDBFile
+#if defined(HDS_HW_WALLET)
+            || path.filename() == WalletSettings::TrezorWalletDBFile
+#endif
+        ;
+    }
+
+    bool isSkippedFolder(const boost::filesystem::path& path)
+    {
+        for (const auto* folder : kSkippedFolders)
+        {
+            if (path.filename() == folder)
+            {
+                return true;
+            }
+        }
+        return path.filename() == WalletSettings::NodeDBFile;
+    }
+
+    QString toQString(const boost::filesystem::path& path)
+    {
+#ifdef WIN32
+        return QString::fromStdWString(path.wstring());
+#else
+        return QString::fromStdString(path.string());
+#endif
+    }
+
+    // wallet DBs in the app data folder and in its direct subfolders
+    std::vector<boost::filesystem::path> findAllWalletDB(const std::string& appPath, const QThread& thread)
     {
-        std::vector<boost::filesystem::path> walletDBs;
+        namespace fs = boost::filesystem;
+        std::vector<fs::path> walletDBs;
         try
         {
             auto appDataPath = pathFromStdString(appPath);
 
-            if (!boost::filesystem::exists(appDataPath))
+            if (!fs::exists(appDataPath))
             {
                 return {};
             }
 
-            for (boost::filesystem::recursive_directory_iterator endDirIt, it{ appDataPath }; it != endDirIt; ++it)
+            std::vector<fs::path> subfolders;
+            for (fs::directory_iterator it{ appDataPath }, endIt; it != endIt; ++it)
             {
-                if (it.level() > 1)
+                if (isWalletDBFile(it->path()))
                 {
-                    it.pop();
-                    if (it == endDirIt)
-                    {
-                        break;
-                    }
+                    walletDBs.push_back(it->path());
+                }
+                else if (!isSkippedFolder(it->path()) && fs::is_directory(it->status()))
+                {
+                    subfolders.push_back(it->path());
                 }
+            }
 
-                if (it->path().filename() == WalletSettings::WalletDBFile 
-#if defined(HDS_HW_WALLET)
-                    || it->path().filename() == WalletSettings::TrezorWalletDBFile
-#endif
-                )
+            for (const auto& subfolder : subfolders)
+            {
+                if (thread.isInterruptionRequested())
                 {
-                    walletDBs.push_back(it->path());
+                    break;
+                }
+
+                boost::system::error_code ec;
+                for (fs::directory_iterator it{ subfolder, ec }, endIt; !ec && it != endIt; it.increment(ec))
+                {
+                    if (isWalletDBFile(it->path()))
+                    {
+                        walletDBs.push_back(it->path());
+                    }
                 }
             }
         }
         catch (std::exception &e)
         {
-            LOG_ERROR() << e.what();
+            UI_LOG_ERROR() << e.what();
         }
 
         return walletDBs;
     }
 
+    WalletDBInfo getWalletDBInfo(const QString& path)
+    {
+        QFileInfo fileInfo(path);
+        WalletDBInfo info;
+        info.path = fileInfo.absoluteFilePath();
+        info.size = fileInfo.size();
+        info.lastWriteTime = fileInfo.lastModified();
+        info.creationTime = fileInfo.birthTime();
+        return info;
+    }
+
     void DoJSCallback(QJSValue& jsCallback, bool res)
     {
 #if defined(__clang__) || defined(__GNUC__) || defined(__GNUG__)
@@ -119,6 +180,62 @@ namespace
     }
 }
 
+WalletDBSearchThread::WalletDBSearchThread(const std::vector<std::string>& folders, const std::vector<WalletDBInfo>& cached)
+    : m_folders(folders)
+    , m_validated(cached)
+{
+}
+
+void WalletDBSearchThread::run()
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    std::vector<WalletDBInfo> validated;
+    for (const auto& info : m_validated)
+    {
+        if (QFileInfo::exists(info.path))
+        {
+            validated.push_back(getWalletDBInfo(info.path));
+        }
+    }
+    m_validated = std::move(validated);
+    emit cacheValidated();
+
+    for (const auto& folder : m_folders)
+    {
+        if (isInterruptionRequested())
+        {
+            return;
+        }
+
+        for (const auto& walletDBPath : findAllWalletDB(folder, *this))
+        {
+            auto info = getWalletDBInfo(toQString(walletDBPath));
+            auto it = std::find_if(m_found.begin(), m_found.end(), [&info](const WalletDBInfo& found)
+            {
+                return found.path == info.path;
+            });
+            if (it == m_found.end())
+            {
+                m_found.push_back(std::move(info));
+            }
+        }
+    }
+
+    UI_LOG_INFO() << "Wallet DB search: " << m_found.size() << " found in " << timer.elapsed() << " ms";
+}
+
+const std::vector<WalletDBInfo>& WalletDBSearchThread::getValidated() const
+{
+    return m_validated;
+}
+
+const std::vector<WalletDBInfo>& WalletDBSearchThread::getFound() const
+{
+    return m_found;
+}
+
 RecoveryPhraseItem::RecoveryPhraseItem(int index, const QString& phrase)
     : m_index(index)
     , m_phrase(phrase)
@@ -238,10 +355,14 @@ StartViewModel::StartViewModel()
     , m_trezorThread(*this)
 #endif
 {
+    STARTUP_TRACE_SPAN("StartViewModel::StartViewModel");
     if (!walletExists())
     {
         // find all wallet.db in appData and defaultAppData
         findExistingWalletDB();
+
+        // the node is chosen at the end of the wallet creation, rank the peers meanwhile
+        AppModel::getInstance().getPeerRanker().rank(PeerRanker::getDefaultPeers());
     }
 
 #if defined(HDS_HW_WALLET)
@@ -249,10 +370,19 @@ StartViewModel::StartViewModel()
     connect(&m_trezorTimer, SIGNAL(timeout()), this, SLOT(checkTrezor()));
     m_trezorTimer.start(1000);
 #endif
+
+    connect(&AppModel::getInstance(), SIGNAL(walletDBLoadingStarted()), this, SLOT(onWalletDBLoadingStarted()));
+    connect(&AppModel::getInstance(), SIGNAL(walletDBLoadingStageChanged(int)), this, SLOT(onWalletDBLoadingStageChanged(int)));
+    connect(&AppModel::getInstance(), SIGNAL(walletDBLoadingFinished()), this, SLOT(onWalletDBLoadingFinished()));
 }
 
 StartViewModel::~StartViewModel()
 {
+    if (m_walletDBSearchThread)
+    {
+        m_walletDBSearchThread->requestInterruption();
+        m_walletDBSearchThread->wait();
+    }
     qDeleteAll(m_walletDBpaths);
 }
 
@@ -348,7 +478,7 @@ void TrezorThread::run()
 void StartViewModel::onTrezorOwnerKeyImported(const QString& key)
 {
     //m_ownerKeyEncrypted = key.toStdString();
-    LOG_INFO() << "Trezor Key imported";// << m_ownerKeyEncrypted;
+    UI_LOG_INFO() << "Trezor Key imported";// << m_ownerKeyEncrypted;
 
     SecString secretPass = m_password;
     if (m_creating)
@@ -463,6 +593,13 @@ bool StartViewModel::getIsRunLocalNode() const
 
 QString StartViewModel::chooseRandomNode() const
 {
+    // the fastest peer of the last ranking, random one until a peer is reachable
+    auto best = AppModel::getInstance().getPeerRanker().getBest();
+    if (!best.isEmpty())
+    {
+        return best;
+    }
+
     auto peers = getDefaultPeers();
     srand(time(0));
     return QString(peers[rand() % peers.size()].c_str());
@@ -640,7 +777,18 @@ void StartViewModel::createWallet(const QJSValue& callback)
     SecString secretSeed;
     secretSeed.assign(buf.data(), buf.size());
     SecString sectretPass = m_password;
-    DoJSCallback(m_callback, AppModel::getInstance().createWallet(secretSeed, sectretPass));
+
+    m_isCreatingWalletDB = true;
+    m_walletDBLoadingStage = static_cast<int>(WalletDBLoader::Stage::Creating);
+
+    QPointer<StartViewModel> self(this);
+    AppModel::getInstance().createWallet(secretSeed, sectretPass, [self](bool created)
+    {
+        if (self)
+        {
+            DoJSCallback(self->m_callback, created);
+        }
+    });
 }
 
 void StartViewModel::openWallet(const QString& pass, const QJSValue& callback)
@@ -655,7 +803,18 @@ void StartViewModel::openWallet(const QString& pass, const QJSValue& callback)
 #endif
     // TODO make this secure
     SecString secretPass = pass.toStdString();
-    DoJSCallback(m_callback, AppModel::getInstance().openWallet(secretPass));
+
+    m_isCreatingWalletDB = false;
+    m_walletDBLoadingStage = static_cast<int>(WalletDBLoader::Stage::Opening);
+
+    QPointer<StartViewModel> self(this);
+    AppModel::getInstance().openWalletAsync(secretPass, [self](bool opened)
+    {
+        if (self)
+        {
+            DoJSCallback(self->m_callback, opened);
+        }
+    });
 }
 
 bool StartViewModel::checkWalletPassword(const QString& password) const
@@ -674,36 +833,170 @@ void StartViewModel::onNodeSettingsChanged()
     AppModel::getInstance().nodeSettingsChanged();
 }
 
+void StartViewModel::onWalletDBLoadingStarted()
+{
+    m_isWalletDBLoading = true;
+    emit walletDBLoadingChanged();
+}
+
+void StartViewModel::onWalletDBLoadingStageChanged(int stage)
+{
+    m_walletDBLoadingStage = stage;
+    emit walletDBLoadingChanged();
+}
+
+void StartViewModel::onWalletDBLoadingFinished()
+{
+    m_isWalletDBLoading = false;
+    emit walletDBLoadingChanged();
+}
+
+void StartViewModel::cancelWalletDBLoading()
+{
+    AppModel::getInstance().cancelWalletDBLoading();
+}
+
+bool StartViewModel::isWalletDBLoading() const
+{
+    return m_isWalletDBLoading;
+}
+
+QString StartViewModel::getWalletDBLoadingStage() const
+{
+    switch (static_cast<WalletDBLoader::Stage>(m_walletDBLoadingStage))
+    {
+    case WalletDBLoader::Stage::Creating:
+        //% "Creating wallet database"
+        return qtTrId("start-db-loading-creating");
+    case WalletDBLoader::Stage::GeneratingAddress:
+        //% "Generating default address"
+        return qtTrId("start-db-loading-address");
+    case WalletDBLoader::Stage::Opening:
+        //% "Opening wallet database"
+        return qtTrId("start-db-loading-opening");
+    case WalletDBLoader::Stage::Done:
+        break;
+    }
+    return {};
+}
+
+double StartViewModel::getWalletDBLoadingProgress() const
+{
+    // there is no progress within a stage, WalletDB does not report it
+    const int stagesCount = m_isCreatingWalletDB ? 3 : 1;
+    int stage = 0;
+    switch (static_cast<WalletDBLoader::Stage>(m_walletDBLoadingStage))
+    {
+    case WalletDBLoader::Stage::Creating:
+        stage = 0;
+        break;
+    case WalletDBLoader::Stage::GeneratingAddress:
+        stage = 1;
+        break;
+    case WalletDBLoader::Stage::Opening:
+        stage = stagesCount - 1;
+        break;
+    case WalletDBLoader::Stage::Done:
+        stage = stagesCount;
+        break;
+    }
+    return static_cast<double>(stage) / stagesCount;
+}
+
 void StartViewModel::findExistingWalletDB()
 {
-    auto appDataPath = AppModel::getInstance().getSettings().getAppDataPath();
+    auto& settings = AppModel::getInstance().getSettings();
+    auto appDataPath = settings.getAppDataPath();
     auto defaultAppDataPath = QDir(QStandardPaths::writableLocation(QStandardPaths::DataLocation)).path().toStdString();
 
-    auto walletDBs = findAllWalletDB(appDataPath);
-
+    std::vector<std::string> folders = { appDataPath };
     if (appDataPath != defaultAppDataPath)
     {
-        auto additionnalWalletDBs = findAllWalletDB(defaultAppDataPath);
-        walletDBs.reserve(walletDBs.size() + additionnalWalletDBs.size());
-        walletDBs.insert(std::end(walletDBs), std::begin(additionnalWalletDBs), std::end(additionnalWalletDBs));
+        folders.push_back(defaultAppDataPath);
     }
 
-    for (auto& walletDBPath : walletDBs)
+    // show the DBs found last time right away, the search corrects them
+    std::vector<WalletDBInfo> cached;
+    for (const auto& value : settings.getWalletDBCache())
+    {
+        auto entry = value.toMap();
+        WalletDBInfo info;
+        info.path = entry.value("path").toString();
+        info.size = entry.value("size").toLongLong();
+        info.lastWriteTime = entry.value("lastWrite").toDateTime();
+        info.creationTime = entry.value("created").toDateTime();
+        if (!info.path.isEmpty())
+        {
+            cached.push_back(std::move(info));
+        }
+    }
+    setWalletDBpaths(cached);
+
+    m_walletDBSearchThread = std::make_unique<WalletDBSearchThread>(folders, cached);
+    connect(m_walletDBSearchThread.get(), SIGNAL(cacheValidated()), this, SLOT(onWalletDBCacheValidated()));
+    connect(m_walletDBSearchThread.get(), SIGNAL(finished()), this, SLOT(onWalletDBSearchFinished()));
+    m_walletDBSearchThread->start(QThread::LowPriority);
+}
+
+void StartViewModel::onWalletDBCacheValidated()
+{
+    if (m_walletDBSearchThread)
+    {
+        setWalletDBpaths(m_walletDBSearchThread->getValidated());
+    }
+}
+
+void StartViewModel::onWalletDBSearchFinished()
+{
+    if (!m_walletDBSearchThread)
+    {
+        return;
+    }
+
+    const auto& found = m_walletDBSearchThread->getFound();
+    setWalletDBpaths(found);
+
+    QVariantList cache;
+    for (size_t i = 0; i < found.size() && i < kMaxCachedWalletDBs; ++i)
+    {
+        const auto& info = found[i];
+        QVariantMap entry;
+        entry["path"] = info.path;
+        entry["size"] = info.size;
+        entry["lastWrite"] = info.lastWriteTime;
+        entry["created"] = info.creationTime;
+        cache.push_back(entry);
+    }
+    AppModel::getInstance().getSettings().setWalletDBCache(cache);
+
+    m_walletDBSearchThread.reset();
+    emit isSearchingWalletDBChanged();
+}
+
+bool StartViewModel::isSearchingWalletDB() const
+{
+    return m_walletDBSearchThread != nullptr;
+}
+
+void StartViewModel::setWalletDBpaths(const std::vector<WalletDBInfo>& walletDBs)
+{
+    auto defaultAppDataPath = QDir(QStandardPaths::writableLocation(QStandardPaths::DataLocation)).path();
+
+    // the items can still be referenced by QML
+    for (auto* item : m_walletDBpaths)
+    {
+        item->deleteLater();
+    }
+    m_walletDBpaths.clear();
+
+    for (const auto& info : walletDBs)
     {
-#ifdef WIN32
-        QFileInfo fileInfo(QString::fromStdWString(walletDBPath.wstring()));
-#else
-        QFileInfo fileInfo(QString::fromStdString(walletDBPath.string()));
-#endif
-        QString absoluteFilePath = fileInfo.absoluteFilePath();
-        bool isDefaultLocated = absoluteFilePath.contains(
-            QString::fromStdString(defaultAppDataPath));
         m_walletDBpaths.push_back(new WalletDBPathItem(
-                absoluteFilePath,
-                fileInfo.size(),
-                fileInfo.lastModified(),
-                fileInfo.birthTime(),
-                isDefaultLocated));
+                info.path,
+                info.size,
+                info.lastWriteTime,
+                info.creationTime,
+                info.path.contains(defaultAppDataPath)));
     }
 
     std::sort(m_walletDBpaths.begin(), m_walletDBpaths.end(),
@@ -717,6 +1010,8 @@ void StartViewModel::findExistingWalletDB()
     if (!m_walletDBpaths.empty()) {
         m_walletDBpaths.first()->setPreferred();
     }
+
+    emit walletDBpathsChanged();
 }
 
 bool StartViewModel::isFindExistingWalletDB()
@@ -744,7 +1039,7 @@ void StartViewModel::deleteCurrentWalletDB()
     }
     catch (std::exception& e)
     {
-        LOG_ERROR() << e.what();
+        UI_LOG_ERROR() << e.what();
     }
 }
 
@@ -758,7 +1053,7 @@ void StartViewModel::migrateWalletDB(const QString& path)
     }
     catch (std::exception& e)
     {
-        LOG_ERROR() << e.what();
+        UI_LOG_ERROR() << e.what();
     }
 }
 
@@ -15,6 +15,8 @@
 #pragma once
 
 #include <functional>
+#include <memory>
+#include <vector>
 
 #include <QObject>
 #include <QDateTime>
@@ -100,6 +102,39 @@ private:
     bool m_isPreferred = false;
 };
 
+struct WalletDBInfo
+{
+    QString path;
+    qint64 size = 0;
+    QDateTime lastWriteTime;
+    QDateTime creationTime;
+};
+
+// Looks for wallet DBs left in the app data folders out of the GUI thread.
+// The previously found DBs are checked first and reported by cacheValidated()
+// to be shown quickly, then the folders are searched
+class WalletDBSearchThread : public QThread
+{
+    Q_OBJECT
+public:
+    WalletDBSearchThread(const std::vector<std::string>& folders, const std::vector<WalletDBInfo>& cached);
+
+    void run() override;
+
+    // valid after cacheValidated()
+    const std::vector<WalletDBInfo>& getValidated() const;
+    // valid after finished()
+    const std::vector<WalletDBInfo>& getFound() const;
+
+signals:
+    void cacheValidated();
+
+private:
+    std::vector<std::string> m_folders;
+    std::vector<WalletDBInfo> m_validated;
+    std::vector<WalletDBInfo> m_found;
+};
+
 #if defined(HDS_HW_WALLET)
 class StartViewModel;
 class TrezorThread : public QThread
@@ -139,9 +174,13 @@ class StartViewModel : public QObject
     Q_PROPERTY(int localPort READ getLocalPort CONSTANT)
     Q_PROPERTY(QString remoteNodeAddress READ getRemoteNodeAddress CONSTANT)
     Q_PROPERTY(QString localNodePeer READ getLocalNodePeer CONSTANT)
-    Q_PROPERTY(QQmlListProperty<WalletDBPathItem> walletDBpaths READ getWalletDBpaths CONSTANT)
+    Q_PROPERTY(QQmlListProperty<WalletDBPathItem> walletDBpaths READ getWalletDBpaths NOTIFY walletDBpathsChanged)
+    Q_PROPERTY(bool isSearchingWalletDB READ isSearchingWalletDB NOTIFY isSearchingWalletDBChanged)
     Q_PROPERTY(bool isCapsLockOn READ isCapsLockOn NOTIFY capsLockStateMayBeChanged)
     Q_PROPERTY(bool validateDictionary READ getValidateDictionary WRITE setValidateDictionary NOTIFY validateDictionaryChanged)
+    Q_PROPERTY(bool isWalletDBLoading READ isWalletDBLoading NOTIFY walletDBLoadingChanged)
+    Q_PROPERTY(QString walletDBLoadingStage READ getWalletDBLoadingStage NOTIFY walletDBLoadingChanged)
+    Q_PROPERTY(double walletDBLoadingProgress READ getWalletDBLoadingProgress NOTIFY walletDBLoadingChanged)
 
 public:
 
@@ -168,9 +207,13 @@ public:
     QString getRemoteNodeAddress() const;
     QString getLocalNodePeer() const;
     QQmlListProperty<WalletDBPathItem> getWalletDBpaths();
+    bool isSearchingWalletDB() const;
     bool isCapsLockOn() const;
     bool getValidateDictionary() const;
     void setValidateDictionary(bool value);
+    bool isWalletDBLoading() const;
+    QString getWalletDBLoadingStage() const;
+    double getWalletDBLoadingProgress() const;
 
     Q_INVOKABLE void setupLocalNode(int port, const QString& localNodePeer);
     Q_INVOKABLE void setupRemoteNode(const QString& nodeAddress);
@@ -190,6 +233,7 @@ public:
     Q_INVOKABLE QString defaultRemoteNodeAddr() const;
     Q_INVOKABLE void checkCapsLock();
     Q_INVOKABLE void openFolder(const QString& path) const;
+    Q_INVOKABLE void cancelWalletDBLoading();
 
 #if defined(HDS_HW_WALLET)
     Q_INVOKABLE void startOwnerKeyImporting(bool creating);
@@ -205,6 +249,9 @@ signals:
     void isRecoveryModeChanged();
     void capsLockStateMayBeChanged();
     void validateDictionaryChanged();
+    void walletDBLoadingChanged();
+    void walletDBpathsChanged();
+    void isSearchingWalletDBChanged();
 
 #if defined(HDS_HW_WALLET)
     void isTrezorConnectedChanged();
@@ -218,6 +265,11 @@ public slots:
     bool checkWalletPassword(const QString& password) const;
     void setPassword(const QString& pass);
     void onNodeSettingsChanged();
+    void onWalletDBLoadingStarted();
+    void onWalletDBLoadingStageChanged(int stage);
+    void onWalletDBLoadingFinished();
+    void onWalletDBCacheValidated();
+    void onWalletDBSearchFinished();
 
 #if defined(HDS_HW_WALLET)
     void onTrezorOwnerKeyImported(const QString& key);
@@ -227,6 +279,7 @@ public slots:
 private:
 
     void findExistingWalletDB();
+    void setWalletDBpaths(const std::vector<WalletDBInfo>& walletDBs);
 
     QList<QObject*> m_recoveryPhrases;
     QList<QObject*> m_checkPhrases;
@@ -234,10 +287,14 @@ private:
     std::string m_password;
 
     QList<WalletDBPathItem*> m_walletDBpaths;
+    std::unique_ptr<WalletDBSearchThread> m_walletDBSearchThread;
 
     bool m_isRecoveryMode;
     bool m_validateDictionary = true;
     QJSValue m_callback;
+    bool m_isWalletDBLoading = false;
+    bool m_isCreatingWalletDB = false;
+    int m_walletDBLoadingStage = 0;
 
 #if defined(HDS_HW_WALLET)
     std::shared_ptr<hds::wallet::HWWallet> m_hwWallet;
@@ -14,6 +14,7 @@
 
 #include "statusbar_view.h"
 #include "model/app_model.h"
+#include "model/startup_tracer.h"
 #include "version.h"
 
 StatusbarViewModel::StatusbarViewModel()
@@ -30,6 +31,7 @@ StatusbarViewModel::StatusbarViewModel()
     , m_errorMsg{}
 
 {
+    STARTUP_TRACE_SPAN("StatusbarViewModel::StatusbarViewModel");
     connect(&m_model, SIGNAL(nodeConnectionChanged(bool)),
         SLOT(onNodeConnectionChanged(bool)));
 
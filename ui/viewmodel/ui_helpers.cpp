@@ -3,6 +3,8 @@
 #include <QLocale>
 #include <QTextStream>
 #include <numeric>
+#include <cmath>
+#include <algorithm>
 #include "3rdparty/libbitcoin/include/bitcoin/bitcoin/formats/base_10.hpp"
 #include "version.h"
 
@@ -185,35 +187,168 @@ namespace hdsui
 
     Filter::Filter(size_t size)
         : _samples(size, 0.0)
+        , _sorted(size, 0.0)
         , _index{0}
-        , _is_poor{true}
+        , _count{0}
+        , _sum{0.0}
     {
     }
     
     void Filter::addSample(double value)
     {
+        if (!std::isfinite(value))
+        {
+            return;
+        }
+
+        auto end = _sorted.begin() + _count;
+        if (_count == _samples.size())
+        {
+            auto old = _samples[_index];
+            auto pos = lower_bound(_sorted.begin(), end, old);
+            move(pos + 1, end, pos);
+            --end;
+            --_count;
+            _sum -= old;
+        }
+
+        auto pos = upper_bound(_sorted.begin(), end, value);
+        move_backward(pos, end, end + 1);
+        *pos = value;
+        ++_count;
+
         _samples[_index] = value;
         _index = (_index + 1) % _samples.size();
-        if (_is_poor)
+        _sum += value;
+        if (_index == 0)
         {
-            _is_poor = _index + 1 < _samples.size();
+            // once per window, so the rounding errors of the running sum do not pile up
+            _sum = accumulate(_sorted.begin(), _sorted.begin() + _count, 0.0);
         }
     }
 
     double Filter::getAverage() const
     {
-        double sum = accumulate(_samples.begin(), _samples.end(), 0.0);
-        return sum / (_is_poor ? _index : _samples.size());
+        return _count ? _sum / _count : 0.0;
     }
 
     double Filter::getMedian() const
     {
-        vector<double> temp(_samples.begin(), _samples.end());
-        size_t medianPos = (_is_poor ? _index : temp.size()) / 2;
-        nth_element(temp.begin(),
-                    temp.begin() + medianPos,
-                    _is_poor ? temp.begin() + _index : temp.end());
-        return temp[medianPos];
+        return _count ? _sorted[_count / 2] : 0.0;
+    }
+
+    StreamingQuantile::StreamingQuantile(double p)
+        : _p{std::clamp(p, 0.0, 1.0)}
+        , _count{0}
+        , _heights{}
+        , _positions{0, 1, 2, 3, 4}
+        , _desired{0, 2 * _p, 4 * _p, 2 + 2 * _p, 4}
+        , _increments{0, _p / 2, _p, (1 + _p) / 2, 1}
+    {
+    }
+
+    void StreamingQuantile::addSample(double value)
+    {
+        if (!std::isfinite(value))
+        {
+            return;
+        }
+
+        if (_count < _heights.size())
+        {
+            _heights[_count++] = value;
+            if (_count == _heights.size())
+            {
+                sort(_heights.begin(), _heights.end());
+            }
+            return;
+        }
+        ++_count;
+
+        // the cell of the value, the extreme markers follow the min and max
+        size_t k = 0;
+        if (value < _heights[0])
+        {
+            _heights[0] = value;
+        }
+        else if (value >= _heights[4])
+        {
+            _heights[4] = value;
+            k = 3;
+        }
+        else
+        {
+            while (k < 3 && value >= _heights[k + 1])
+            {
+                ++k;
+            }
+        }
+
+        for (size_t i = k + 1; i < _positions.size(); ++i)
+        {
+            _positions[i] += 1;
+        }
+        for (size_t i = 0; i < _desired.size(); ++i)
+        {
+            _desired[i] += _increments[i];
+        }
+
+        // move the middle markers to their desired positions
+        for (size_t i = 1; i < 4; ++i)
+        {
+            auto d = _desired[i] - _positions[i];
+            if ((d >= 1 && _positions[i + 1] - _positions[i] > 1)
+             || (d <= -1 && _positions[i - 1] - _positions[i] < -1))
+            {
+                int step = d > 0 ? 1 : -1;
+                auto height = parabolic(i, step);
+                if (_heights[i - 1] < height && height < _heights[i + 1])
+                {
+                    _heights[i] = height;
+                }
+                else
+                {
+                    _heights[i] = linear(i, step);
+                }
+                _positions[i] += step;
+            }
+        }
+    }
+
+    double StreamingQuantile::getValue() const
+    {
+        if (_count >= _heights.size())
+        {
+            return _heights[2];
+        }
+        if (!_count)
+        {
+            return 0.0;
+        }
+
+        // too few samples for the markers, the exact value
+        auto heights = _heights;
+        sort(heights.begin(), heights.begin() + _count);
+        return heights[static_cast<size_t>(_p * (_count - 1))];
+    }
+
+    size_t StreamingQuantile::getCount() const
+    {
+        return _count;
+    }
+
+    double StreamingQuantile::parabolic(size_t i, double d) const
+    {
+        const auto& n = _positions;
+        const auto& q = _heights;
+        return q[i] + d / (n[i + 1] - n[i - 1])
+            * ((n[i] - n[i - 1] + d) * (q[i + 1] - q[i]) / (n[i + 1] - n[i])
+             + (n[i + 1] - n[i] - d) * (q[i] - q[i - 1]) / (n[i] - n[i - 1]));
+    }
+
+    double StreamingQuantile::linear(size_t i, int d) const
+    {
+        return _heights[i] + d * (_heights[i + d] - _heights[i]) / (_positions[i + d] - _positions[i]);
     }
 
     QDateTime CalculateExpiresTime(hds::Timestamp currentHeightTime, hds::Height currentHeight, hds::Height expiresHeight)
@@ -1,4 +1,5 @@
 #pragma once
+#include <array>
 #include <QObject>
 #include "wallet/core/common.h"
 #ifdef HDS_ATOMIC_SWAP_SUPPORT
@@ -60,6 +61,8 @@ namespace hdsui
     QString toString(const hds::Merkle::Hash&);
     QString toString(const hds::Timestamp& ts);
 
+    // Statistics of the last `size` samples. A sorted copy of the window is kept
+    // in place, so the queries are O(1) and nothing is allocated after construction
     class Filter
     {
     public:
@@ -69,8 +72,31 @@ namespace hdsui
         double getMedian() const;
     private:
         std::vector<double> _samples;
+        std::vector<double> _sorted;
         size_t _index;
-        bool _is_poor;
+        size_t _count;
+        double _sum;
+    };
+
+    // P-square estimation of a quantile of an unbounded stream (Jain, Chlamtac),
+    // five markers are kept instead of the samples
+    class StreamingQuantile
+    {
+    public:
+        explicit StreamingQuantile(double p);
+        void addSample(double value);
+        double getValue() const;
+        size_t getCount() const;
+    private:
+        double parabolic(size_t i, double d) const;
+        double linear(size_t i, int d) const;
+
+        double _p;
+        size_t _count;
+        std::array<double, 5> _heights;
+        std::array<double, 5> _positions;
+        std::array<double, 5> _desired;
+        std::array<double, 5> _increments;
     };
     QDateTime CalculateExpiresTime(hds::Timestamp currentHeightTime, hds::Height currentHeight, hds::Height expiresHeight);
     QString getEstimateTimeStr(int estimate);
@@ -13,6 +13,7 @@
 // limitations under the License.
 #include "tx_object.h"
 #include "viewmodel/ui_helpers.h"
+#include "model/ui_log.h"
 #include "wallet/core/common.h"
 #include "wallet/core/simple_transaction.h"
 #include "wallet/core/strings_resources.h"
@@ -352,7 +353,7 @@ QString TxObject::getReasonString(hds::wallet::TxFailureReason reason) const
     assert(reasons.size() > static_cast<size_t>(reason));
     if (static_cast<size_t>(reason) >= reasons.size())
     {
-        LOG_WARNING()  << "Unknown failure reason code " << reason << ". Defaulting to 0";
+        UI_LOG_WARNING()  << "Unknown failure reason code " << reason << ". Defaulting to 0";
         reason = TxFailureReason::Unknown;
     }
 
@@ -27,6 +27,7 @@
 #include "utility/helpers.h"
 #include "model/app_model.h"
 #include "model/qr.h"
+#include "model/startup_tracer.h"
 #include "viewmodel/ui_helpers.h"
 
 using namespace hds;
@@ -45,6 +46,7 @@ WalletViewModel::WalletViewModel()
     : _model(*AppModel::getInstance().getWallet())
     , _settings(AppModel::getInstance().getSettings())
 {
+    STARTUP_TRACE_SPAN("WalletViewModel::WalletViewModel");
     connect(&_model, SIGNAL(transactionsChanged(hds::wallet::ChangeAction, const std::vector<hds::wallet::TxDescription>&)),
         SLOT(onTransactionsChanged(hds::wallet::ChangeAction, const std::vector<hds::wallet::TxDescription>&)));
 
@@ -61,6 +63,16 @@ WalletViewModel::WalletViewModel()
     connect(&_exchangeRatesManager, SIGNAL(activeRateChanged()), SIGNAL(secondCurrencyRateChanged()));
 
     _model.getAsync()->getTransactions();
+
+    // show the last known transactions until the wallet reports them
+    auto snapshotTransactions = _model.getSnapshot().getTransactions();
+    if (!snapshotTransactions.empty())
+    {
+        _isSnapshotReplay = true;
+        onTransactionsChanged(ChangeAction::Reset, snapshotTransactions);
+        _isSnapshotReplay = false;
+        _isSnapshotShown = true;
+    }
 }
 
 QAbstractItemModel* WalletViewModel::getTransactions()
@@ -98,6 +110,9 @@ PaymentInfoItem* WalletViewModel::getPaymentInfo(const QVariant& variantTxID)
 
 void WalletViewModel::onTransactionsChanged(hds::wallet::ChangeAction action, const std::vector<hds::wallet::TxDescription>& transactions)
 {
+    auto& tracer = StartupTracer::getInstance();
+    auto traceStart = tracer.isEnabled() ? StartupTracer::now() : 0;
+
     vector<shared_ptr<TxObject>> modifiedTransactions;
     modifiedTransactions.reserve(transactions.size());
     ExchangeRate::Currency secondCurrency = _exchangeRatesManager.getRateUnitRaw();
@@ -143,7 +158,16 @@ void WalletViewModel::onTransactionsChanged(hds::wallet::ChangeAction action, co
     {
         case ChangeAction::Reset:
             {
-                _transactionsList.reset(modifiedTransactions);
+                if (_isSnapshotShown)
+                {
+                    // keep the rows which are still there
+                    _isSnapshotShown = false;
+                    _transactionsList.reconcile(modifiedTransactions, [](const auto& tx) { return tx->getTxID(); });
+                }
+                else
+                {
+                    _transactionsList.reset(modifiedTransactions);
+                }
                 break;
             }
 
@@ -171,6 +195,14 @@ void WalletViewModel::onTransactionsChanged(hds::wallet::ChangeAction action, co
     }
 
     emit transactionsChanged();
+
+    if (tracer.isEnabled() && !_isSnapshotReplay)
+    {
+        // the wallet is interactive when the first live transactions are shown,
+        // the snapshot is on the screen before that
+        tracer.addSpan("first transactionsChanged", traceStart, StartupTracer::now() - traceStart);
+        tracer.finish();
+    }
 }
 
 void WalletViewModel::onTxHistoryExportedToCsv(const QString& data)
@@ -191,27 +223,27 @@ void WalletViewModel::onTxHistoryExportedToCsv(const QString& data)
 
 QString WalletViewModel::hdsAvailable() const
 {
-    return hdsui::AmountToUIString(_model.getAvailable());
+    return hdsui::AmountToUIString(_model.getDisplayStatus().available);
 }
 
 QString WalletViewModel::hdsReceiving() const
 {
-    return hdsui::AmountToUIString(_model.getReceivingChange() + _model.getReceivingIncoming());
+    return hdsui::AmountToUIString(_model.getDisplayStatus().receivingChange + _model.getDisplayStatus().receivingIncoming);
 }
 
 QString WalletViewModel::hdsSending() const
 {
-    return hdsui::AmountToUIString(_model.getSending());
+    return hdsui::AmountToUIString(_model.getDisplayStatus().sending);
 }
 
 QString WalletViewModel::hdsReceivingChange() const
 {
-     return hdsui::AmountToUIString(_model.getReceivingChange());
+     return hdsui::AmountToUIString(_model.getDisplayStatus().receivingChange);
 }
 
 QString WalletViewModel::hdsReceivingIncoming() const
 {
-    return hdsui::AmountToUIString(_model.getReceivingIncoming());
+    return hdsui::AmountToUIString(_model.getDisplayStatus().receivingIncoming);
 }
 
 QString WalletViewModel::hdsLocked() const
@@ -221,7 +253,7 @@ QString WalletViewModel::hdsLocked() const
 
 QString WalletViewModel::hdsLockedMaturing() const
 {
-    return hdsui::AmountToUIString(_model.getMaturing());
+    return hdsui::AmountToUIString(_model.getDisplayStatus().maturing);
 }
 
 QString WalletViewModel::getSecondCurrencyLabel() const
@@ -86,5 +86,7 @@ private:
     WalletSettings& _settings;
     ExchangeRatesManager _exchangeRatesManager;
     TxObjectList _transactionsList;
+    bool _isSnapshotShown = false;
+    bool _isSnapshotReplay = false;  // the snapshot is put into the list, not live data
     QQueue<QString> _txHistoryToCsvPaths;
 };